@@ -0,0 +1,125 @@
+#include "Catalog.h"
+#include "DustKernel.h"
+
+namespace SCRIBE
+{
+	namespace CATALOG
+	{
+		Tier GetTierForLevel(int spellLevel)
+		{
+			return static_cast<Tier>(KERNEL::GetTierIndex(spellLevel));
+		}
+
+		ScrollID ScrollCatalog::Add(const ScrollFacts& facts)
+		{
+			const auto id = static_cast<ScrollID>(spells.size());
+
+			books.push_back(facts.book);
+			spells.push_back(facts.spell);
+			scrolls.push_back(facts.scroll);
+			ranks.push_back(facts.rank);
+			levels.push_back(facts.level);
+			tiers.push_back(facts.tier);
+			schools.push_back(facts.school);
+			baseDust.push_back(facts.baseDust);
+			reducedDust.push_back(facts.reducedDust);
+			concentration.push_back(facts.concentration ? 1 : 0);
+			origins.push_back(facts.origin);
+			cobjOffset.push_back(static_cast<std::uint32_t>(cobjs.size()));
+			cobjCount.push_back(0);
+
+			if (facts.book)
+				bookIndex.insert_or_assign(facts.book, id);
+			if (facts.spell)
+				spellIndex.insert_or_assign(facts.spell, id);
+			if (facts.scroll)
+				scrollIndex.insert_or_assign(facts.scroll, id);
+
+			return id;
+		}
+
+		void ScrollCatalog::SetConstructibles(ScrollID id, const std::vector<RE::BGSConstructibleObject*>& list)
+		{
+			cobjOffset[id] = static_cast<std::uint32_t>(cobjs.size());
+			cobjCount[id] = static_cast<std::uint8_t>(list.size());
+			cobjs.insert(cobjs.end(), list.begin(), list.end());
+		}
+
+		void ScrollCatalog::RebindScroll(ScrollID id, RE::ScrollItem* newScroll)
+		{
+			if (auto oldScroll = scrolls[id]; oldScroll != nullptr)
+				scrollIndex.erase(oldScroll);
+
+			scrolls[id] = newScroll;
+			if (origins[id] == Origin::kGenerated)
+				origins[id] = Origin::kPatched;
+			scrollIndex.insert_or_assign(newScroll, id);
+		}
+
+		void ScrollCatalog::AddAlias(ScrollID id, const RE::TESObjectBOOK* book, RE::SpellItem* spell)
+		{
+			if (book)
+				bookIndex.try_emplace(book, id);
+			if (spell && spellIndex.try_emplace(spell, id).second)
+				aliasSpells[id].push_back(spell);
+		}
+
+		void ScrollCatalog::AddLegacyScroll(ScrollID id, RE::ScrollItem* scroll)
+		{
+			if (scroll)
+				scrollIndex.try_emplace(scroll, id);
+		}
+
+		std::span<RE::SpellItem* const> ScrollCatalog::GetAliasSpells(ScrollID id) const
+		{
+			if (auto it = aliasSpells.find(id); it != aliasSpells.end())
+				return it->second;
+			return {};
+		}
+
+		void ScrollCatalog::Reserve(std::size_t count)
+		{
+			books.reserve(count);
+			spells.reserve(count);
+			scrolls.reserve(count);
+			ranks.reserve(count);
+			levels.reserve(count);
+			tiers.reserve(count);
+			schools.reserve(count);
+			baseDust.reserve(count);
+			reducedDust.reserve(count);
+			concentration.reserve(count);
+			origins.reserve(count);
+			cobjOffset.reserve(count);
+			cobjCount.reserve(count);
+			cobjs.reserve(count * 4);
+
+			bookIndex.reserve(count);
+			spellIndex.reserve(count);
+			scrollIndex.reserve(count);
+		}
+
+		ScrollID ScrollCatalog::FindByBook(const RE::TESObjectBOOK* book) const
+		{
+			const auto it = bookIndex.find(book);
+			return it != bookIndex.end() ? it->second : INVALID_SCROLL_ID;
+		}
+
+		ScrollID ScrollCatalog::FindBySpell(const RE::SpellItem* spell) const
+		{
+			const auto it = spellIndex.find(spell);
+			return it != spellIndex.end() ? it->second : INVALID_SCROLL_ID;
+		}
+
+		ScrollID ScrollCatalog::FindByScroll(const RE::ScrollItem* scroll) const
+		{
+			const auto it = scrollIndex.find(scroll);
+			return it != scrollIndex.end() ? it->second : INVALID_SCROLL_ID;
+		}
+
+		std::span<RE::BGSConstructibleObject* const> ScrollCatalog::GetConstructibles(ScrollID id) const
+		{
+			return std::span<RE::BGSConstructibleObject* const>(cobjs).subspan(cobjOffset[id], cobjCount[id]);
+		}
+	}
+}
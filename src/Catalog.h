@@ -0,0 +1,127 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace CATALOG
+	{
+		using ScrollID = std::uint32_t;
+		constexpr ScrollID INVALID_SCROLL_ID = 0xFFFFFFFF;
+
+		enum class Tier : std::uint8_t
+		{
+			kNovice,
+			kApprentice,
+			kAdept,
+			kExpert,
+			kMaster,
+
+			kTotal
+		};
+
+		enum class Origin : std::uint8_t
+		{
+			kGenerated,  // created from a spell tome in GenerateDynamicScrolls
+			kPatched     // generated, then replaced by a vanilla/modded scroll in PatchVanillaScrolls
+		};
+
+		struct ScrollFacts
+		{
+			RE::TESObjectBOOK* book = nullptr;
+			RE::SpellItem* spell = nullptr;
+			RE::ScrollItem* scroll = nullptr;
+			std::int8_t rank = 0;
+			std::int16_t level = 0;
+			Tier tier = Tier::kNovice;
+			RE::ActorValue school = RE::ActorValue::kNone;
+			std::int32_t baseDust = 0;
+			std::int32_t reducedDust = 0;
+			bool concentration = false;
+			Origin origin = Origin::kGenerated;
+		};
+
+		// Structure-of-arrays store for every scroll Scribe knows about.
+		// Filled and patched during kDataLoaded only; afterwards it is immutable and read from any thread without locking.
+		// Fused scrolls are created at runtime and live in the CACHE fusion maps instead.
+		class ScrollCatalog
+		{
+		public:
+			static ScrollCatalog& GetSingleton()
+			{
+				static ScrollCatalog instance;
+				return instance;
+			}
+
+			ScrollID Add(const ScrollFacts& facts);
+			void SetConstructibles(ScrollID id, const std::vector<RE::BGSConstructibleObject*>& cobjs);
+			void RebindScroll(ScrollID id, RE::ScrollItem* newScroll);
+			// Resolves another tome (and its spell, if it differs) to an existing entry instead of a scroll of its own.
+			void AddAlias(ScrollID id, const RE::TESObjectBOOK* book, RE::SpellItem* spell);
+			// Resolves a scroll kept for existing saves to an entry; the entry's own scroll is unchanged.
+			void AddLegacyScroll(ScrollID id, RE::ScrollItem* scroll);
+			void Reserve(std::size_t count);
+
+			ScrollID FindByBook(const RE::TESObjectBOOK* book) const;
+			ScrollID FindBySpell(const RE::SpellItem* spell) const;
+			ScrollID FindByScroll(const RE::ScrollItem* scroll) const;
+
+			RE::TESObjectBOOK* GetBook(ScrollID id) const { return books[id]; }
+			RE::SpellItem* GetSpell(ScrollID id) const { return spells[id]; }
+			RE::ScrollItem* GetScroll(ScrollID id) const { return scrolls[id]; }
+			int GetRank(ScrollID id) const { return ranks[id]; }
+			int GetLevel(ScrollID id) const { return levels[id]; }
+			Tier GetTier(ScrollID id) const { return tiers[id]; }
+			RE::ActorValue GetSchool(ScrollID id) const { return schools[id]; }
+			int GetBaseDust(ScrollID id) const { return baseDust[id]; }
+			int GetReducedDust(ScrollID id) const { return reducedDust[id]; }
+			bool IsConcentration(ScrollID id) const { return concentration[id] != 0; }
+			Origin GetOrigin(ScrollID id) const { return origins[id]; }
+			std::span<RE::BGSConstructibleObject* const> GetConstructibles(ScrollID id) const;
+			// Spells of alias tomes other than the entry's own; knowing any of them unlocks its recipes.
+			std::span<RE::SpellItem* const> GetAliasSpells(ScrollID id) const;
+
+			// Column views for bulk scans.
+			std::span<const std::int8_t> Ranks() const { return ranks; }
+			std::span<const std::int16_t> Levels() const { return levels; }
+			std::span<const Tier> Tiers() const { return tiers; }
+			std::span<const RE::ActorValue> Schools() const { return schools; }
+			std::span<const std::uint8_t> Concentration() const { return concentration; }
+			std::span<const Origin> Origins() const { return origins; }
+			std::span<RE::SpellItem* const> Spells() const { return spells; }
+			std::span<RE::ScrollItem* const> Scrolls() const { return scrolls; }
+
+			std::size_t size() const { return spells.size(); }
+			bool empty() const { return spells.empty(); }
+
+			ScrollCatalog(ScrollCatalog const&) = delete;
+			void operator=(ScrollCatalog const&) = delete;
+
+		private:
+			ScrollCatalog() = default;
+
+			std::vector<RE::TESObjectBOOK*> books;
+			std::vector<RE::SpellItem*> spells;
+			std::vector<RE::ScrollItem*> scrolls;
+			std::vector<std::int8_t> ranks;
+			std::vector<std::int16_t> levels;
+			std::vector<Tier> tiers;
+			std::vector<RE::ActorValue> schools;
+			std::vector<std::int32_t> baseDust;
+			std::vector<std::int32_t> reducedDust;
+			std::vector<std::uint8_t> concentration;
+			std::vector<Origin> origins;
+
+			// COBJs are stored flat; each scroll owns [cobjOffset, cobjOffset + cobjCount).
+			std::vector<std::uint32_t> cobjOffset;
+			std::vector<std::uint8_t> cobjCount;
+			std::vector<RE::BGSConstructibleObject*> cobjs;
+
+			std::unordered_map<ScrollID, std::vector<RE::SpellItem*>> aliasSpells;
+
+			std::unordered_map<const RE::TESObjectBOOK*, ScrollID> bookIndex;
+			std::unordered_map<const RE::SpellItem*, ScrollID> spellIndex;
+			std::unordered_map<const RE::ScrollItem*, ScrollID> scrollIndex;
+		};
+
+		Tier GetTierForLevel(int spellLevel);
+	}
+}
@@ -0,0 +1,94 @@
+#include "CatalogFile.h"
+
+namespace SCRIBE
+{
+	namespace PREBAKE
+	{
+		namespace
+		{
+			template <typename T>
+			void Put(std::ostream& out, T value)
+			{
+				static_assert(std::endian::native == std::endian::little);
+				const auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+				out.write(bytes.data(), bytes.size());
+			}
+
+			template <typename T>
+			bool Get(std::istream& in, T& value)
+			{
+				std::array<char, sizeof(T)> bytes;
+				if (!in.read(bytes.data(), bytes.size()))
+					return false;
+				value = std::bit_cast<T>(bytes);
+				return true;
+			}
+		}
+
+		bool Write(const Catalog& catalog, std::ostream& out)
+		{
+			out.write(MAGIC.data(), MAGIC.size());
+			Put<std::uint16_t>(out, VERSION);
+			Put<std::uint16_t>(out, 0);
+			Put(out, static_cast<std::uint32_t>(catalog.plugins.size()));
+			Put(out, static_cast<std::uint32_t>(catalog.entries.size()));
+
+			for (const auto& plugin : catalog.plugins) {
+				const auto length = static_cast<std::uint16_t>(std::min<std::size_t>(plugin.size(), 0xFFFF));
+				Put(out, length);
+				out.write(plugin.data(), length);
+			}
+
+			for (const auto& entry : catalog.entries) {
+				Put(out, entry.bookPlugin);
+				Put(out, entry.bookLocalID);
+				Put(out, entry.spellPlugin);
+				Put(out, entry.spellLocalID);
+				Put(out, entry.baseDust);
+				Put(out, entry.reducedDust);
+				Put(out, entry.school);
+				Put(out, entry.level);
+				Put(out, entry.rank);
+				Put(out, entry.tier);
+				Put<std::uint8_t>(out, entry.concentration ? 1 : 0);
+			}
+			return static_cast<bool>(out);
+		}
+
+		std::optional<Catalog> Read(std::istream& in)
+		{
+			std::array<char, 4> magic{};
+			std::uint16_t version = 0, reserved = 0;
+			std::uint32_t pluginCount = 0, entryCount = 0;
+			if (!in.read(magic.data(), magic.size()) || magic != MAGIC)
+				return std::nullopt;
+			if (!Get(in, version) || version != VERSION || !Get(in, reserved) || !Get(in, pluginCount) || !Get(in, entryCount))
+				return std::nullopt;
+
+			Catalog catalog;
+			catalog.plugins.reserve(std::min<std::uint32_t>(pluginCount, 0x1000));
+			for (std::uint32_t i = 0; i < pluginCount; i++) {
+				std::uint16_t length = 0;
+				if (!Get(in, length))
+					return std::nullopt;
+				auto& name = catalog.plugins.emplace_back(length, '\0');
+				if (!in.read(name.data(), length))
+					return std::nullopt;
+			}
+
+			catalog.entries.reserve(std::min<std::uint32_t>(entryCount, 0x10000));
+			for (std::uint32_t i = 0; i < entryCount; i++) {
+				auto& entry = catalog.entries.emplace_back();
+				std::uint8_t concentration = 0;
+				if (!Get(in, entry.bookPlugin) || !Get(in, entry.bookLocalID) || !Get(in, entry.spellPlugin) || !Get(in, entry.spellLocalID)
+					|| !Get(in, entry.baseDust) || !Get(in, entry.reducedDust) || !Get(in, entry.school) || !Get(in, entry.level)
+					|| !Get(in, entry.rank) || !Get(in, entry.tier) || !Get(in, concentration))
+					return std::nullopt;
+				if (entry.bookPlugin >= pluginCount || entry.spellPlugin >= pluginCount)
+					return std::nullopt;
+				entry.concentration = concentration != 0;
+			}
+			return catalog;
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace PREBAKE
+	{
+		// Generation catalog written by the prebake tool (tools/Prebake). The plugin only reads it to verify its own
+		// generation against it (VerifyPrebakedCatalog); generation itself does not depend on it.
+		// Little endian, no padding:
+		//   header: char magic[4] = "SSCT", uint16 version, uint16 reserved, uint32 pluginCount, uint32 entryCount
+		//   plugin: uint16 length, char name[length]
+		//   entry:  uint32 bookPlugin, uint32 bookLocalID, uint32 spellPlugin, uint32 spellLocalID,
+		//           int32 baseDust, int32 reducedDust, int32 school (RE::ActorValue), int16 level,
+		//           int8 rank, uint8 tier, uint8 concentration
+		// Plugin fields index the plugin table; local IDs are FormIDs without the load order byte(s).
+		inline constexpr std::array<char, 4> MAGIC{ 'S', 'S', 'C', 'T' };
+		inline constexpr std::uint16_t VERSION = 1;
+		inline constexpr std::string_view FILE_NAME = "ScrollScribeNG.catalog"sv;
+
+		struct Entry
+		{
+			std::uint32_t bookPlugin = 0;
+			std::uint32_t bookLocalID = 0;
+			std::uint32_t spellPlugin = 0;
+			std::uint32_t spellLocalID = 0;
+			std::int32_t baseDust = 0;
+			std::int32_t reducedDust = 0;
+			std::int32_t school = -1;
+			std::int16_t level = 0;
+			std::int8_t rank = 0;
+			std::uint8_t tier = 0;
+			bool concentration = false;
+		};
+
+		struct Catalog
+		{
+			std::vector<std::string> plugins;
+			std::vector<Entry> entries;
+		};
+
+		bool Write(const Catalog& catalog, std::ostream& out);
+		// std::nullopt if the stream is not a catalog of this version or is truncated.
+		std::optional<Catalog> Read(std::istream& in);
+	}
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <shared_mutex>
+
+namespace SCRIBE
+{
+	// Read-mostly value published as an immutable snapshot (RCU style).
+	// Readers grab the current version without locking; writers build a new one and swap it in.
+	template <typename T>
+	class Snapshot
+	{
+	public:
+		Snapshot() :
+			current(std::make_shared<const T>()) {}
+
+		std::shared_ptr<const T> Load() const
+		{
+			return current.load(std::memory_order_acquire);
+		}
+
+		void Publish(T value)
+		{
+			current.store(std::make_shared<const T>(std::move(value)), std::memory_order_release);
+		}
+
+	private:
+		std::atomic<std::shared_ptr<const T>> current;
+	};
+
+	// Hash map split into independently locked shards so concurrent writers rarely contend.
+	template <typename KeyType, typename ValueType, typename Hash = std::hash<KeyType>, std::size_t ShardCount = 16>
+	class ShardedMap
+	{
+	public:
+		std::optional<ValueType> find(const KeyType& key) const
+		{
+			const auto& shard = GetShard(key);
+			std::shared_lock guard(shard.lock);
+			if (auto it = shard.map.find(key); it != shard.map.end())
+				return it->second;
+			return std::nullopt;
+		}
+
+		bool contains(const KeyType& key) const
+		{
+			const auto& shard = GetShard(key);
+			std::shared_lock guard(shard.lock);
+			return shard.map.contains(key);
+		}
+
+		// Returns the value already stored under key, or stores and returns the given one.
+		ValueType insertOrGet(const KeyType& key, ValueType value)
+		{
+			auto& shard = GetShard(key);
+			std::unique_lock guard(shard.lock);
+			return shard.map.try_emplace(key, std::move(value)).first->second;
+		}
+
+		void insertOrAssign(const KeyType& key, ValueType value)
+		{
+			auto& shard = GetShard(key);
+			std::unique_lock guard(shard.lock);
+			shard.map.insert_or_assign(key, std::move(value));
+		}
+
+		void erase(const KeyType& key)
+		{
+			auto& shard = GetShard(key);
+			std::unique_lock guard(shard.lock);
+			shard.map.erase(key);
+		}
+
+		// Visits every entry; each shard is locked only while it is being visited.
+		template <typename Func>
+		void forEach(Func&& func) const
+		{
+			for (const auto& shard : shards) {
+				std::shared_lock guard(shard.lock);
+				for (const auto& [key, value] : shard.map)
+					func(key, value);
+			}
+		}
+
+		std::size_t size() const
+		{
+			std::size_t total = 0;
+			for (const auto& shard : shards) {
+				std::shared_lock guard(shard.lock);
+				total += shard.map.size();
+			}
+			return total;
+		}
+
+		void clear()
+		{
+			for (auto& shard : shards) {
+				std::unique_lock guard(shard.lock);
+				shard.map.clear();
+			}
+		}
+
+	private:
+		struct Shard
+		{
+			mutable std::shared_mutex lock;
+			std::unordered_map<KeyType, ValueType, Hash> map;
+		};
+
+		static std::size_t GetShardIndex(const KeyType& key)
+		{
+			// Pointer hashes are often the address itself; mix so aligned keys still spread over all shards.
+			std::uint64_t h = Hash{}(key);
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdull;
+			h ^= h >> 33;
+			return static_cast<std::size_t>(h % ShardCount);
+		}
+
+		Shard& GetShard(const KeyType& key) { return shards[GetShardIndex(key)]; }
+		const Shard& GetShard(const KeyType& key) const { return shards[GetShardIndex(key)]; }
+
+		std::array<Shard, ShardCount> shards;
+	};
+
+	// Bounded lock-free ring for many producers and a single consumer (sequence-numbered cells).
+	// Producers never block; TryPush fails when the ring is full.
+	template <typename T, std::size_t Capacity>
+	class MPSCRing
+	{
+		static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+	public:
+		MPSCRing()
+		{
+			for (std::size_t i = 0; i < Capacity; i++)
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		bool TryPush(const T& value)
+		{
+			auto pos = tail.load(std::memory_order_relaxed);
+			for (;;) {
+				auto& cell = cells[pos & MASK];
+				const auto sequence = cell.sequence.load(std::memory_order_acquire);
+				const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+				if (diff == 0) {
+					if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						cell.value = value;
+						cell.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				} else if (diff < 0) {
+					return false;
+				} else {
+					pos = tail.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		// Consumer only.
+		const T* Peek() const
+		{
+			const auto& cell = cells[head & MASK];
+			return cell.sequence.load(std::memory_order_acquire) == head + 1 ? &cell.value : nullptr;
+		}
+
+		// Consumer only.
+		bool TryPop(T& value)
+		{
+			auto& cell = cells[head & MASK];
+			if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+				return false;
+			value = cell.value;
+			cell.sequence.store(head + Capacity, std::memory_order_release);
+			++head;
+			return true;
+		}
+
+	private:
+		static constexpr std::size_t MASK = Capacity - 1;
+
+		struct Cell
+		{
+			std::atomic<std::size_t> sequence;
+			T value;
+		};
+
+		std::array<Cell, Capacity> cells;
+		alignas(64) std::atomic<std::size_t> tail{ 0 };
+		alignas(64) std::size_t head = 0;
+	};
+
+	struct PointerPairHash
+	{
+		template <typename A, typename B>
+		std::size_t operator()(const std::pair<A*, B*>& pair) const
+		{
+			const auto left = std::hash<A*>{}(pair.first);
+			return left ^ (std::hash<B*>{}(pair.second) + 0x9e3779b97f4a7c15ull + (left << 6) + (left >> 2));
+		}
+	};
+}
@@ -0,0 +1,146 @@
+#include "ConditionChain.h"
+
+namespace SCRIBE
+{
+	namespace CONDITIONS
+	{
+		namespace
+		{
+			// Rough relative costs: globals are a single load, HasPerk scans the player's perk list,
+			// HasSpell walks the player's and race's spell lists.
+			constexpr float COST_GLOBAL = 1.0f;
+			constexpr float COST_PERK = 2.0f;
+			constexpr float COST_SPELL = 8.0f;
+
+			using Clause = std::vector<std::size_t>;
+
+			std::vector<Clause> GetClauses(const Chain& chain)
+			{
+				std::vector<Clause> clauses(1);
+				for (const auto& item : chain.items) {
+					clauses.back().push_back(item.predicate);
+					if (!item.isOR)
+						clauses.emplace_back();
+				}
+				if (clauses.back().empty())
+					clauses.pop_back();
+				return clauses;
+			}
+
+			double GetClauseCost(const Chain& chain, const Clause& clause)
+			{
+				double cost = 0.0;
+				double reach = 1.0;
+				for (auto index : clause) {
+					cost += reach * chain.predicates[index].cost;
+					reach *= 1.0 - chain.predicates[index].passRate;
+				}
+				return cost;
+			}
+
+			double GetClauseFailRate(const Chain& chain, const Clause& clause)
+			{
+				double fail = 1.0;
+				for (auto index : clause)
+					fail *= 1.0 - chain.predicates[index].passRate;
+				return fail;
+			}
+		}
+
+		Chain MakeRecipeShape(std::size_t spellCount)
+		{
+			spellCount = std::min<std::size_t>(spellCount, MAX_RECIPE_SPELLS);
+
+			Chain chain;
+			chain.predicates = {
+				{ COST_GLOBAL, 0.5f },  // kScribeLevel
+				{ COST_GLOBAL, 0.5f },  // kFilterKnown
+				{ COST_GLOBAL, 0.8f },  // kFilterRank
+				{ COST_PERK, 0.5f },    // kDustPerk
+			};
+			chain.predicates.insert(chain.predicates.end(), spellCount, { COST_SPELL, 0.1f });
+
+			// S || A && S || B && C && D, where S is every HasSpell
+			for (const std::size_t other : { kScribeLevel, kFilterKnown }) {
+				for (std::size_t i = 0; i < spellCount; i++)
+					chain.items.push_back({ kFirstSpell + i, true });
+				chain.items.push_back({ other, false });
+			}
+			chain.items.push_back({ kFilterRank, false });
+			chain.items.push_back({ kDustPerk, false });
+			return chain;
+		}
+
+		Chain Optimize(const Chain& chain)
+		{
+			auto clauses = GetClauses(chain);
+
+			// Inside an OR clause, cheap predicates that are likely true go first.
+			for (auto& clause : clauses) {
+				std::ranges::stable_sort(clause, [&](std::size_t a, std::size_t b) {
+					const auto& lhs = chain.predicates[a];
+					const auto& rhs = chain.predicates[b];
+					return lhs.cost * rhs.passRate < rhs.cost * lhs.passRate;
+				});
+			}
+
+			// Clauses that are cheap and likely to fail go first, so the chain is rejected early.
+			std::ranges::stable_sort(clauses, [&](const Clause& a, const Clause& b) {
+				return GetClauseCost(chain, a) * GetClauseFailRate(chain, b) < GetClauseCost(chain, b) * GetClauseFailRate(chain, a);
+			});
+
+			Chain result;
+			result.predicates = chain.predicates;
+			for (const auto& clause : clauses)
+				for (std::size_t i = 0; i < clause.size(); i++)
+					result.items.push_back({ clause[i], i + 1 < clause.size() });
+			return result;
+		}
+
+		bool Evaluate(const Chain& chain, std::uint32_t truth, std::size_t* evaluations)
+		{
+			bool clauseResult = false;
+			for (const auto& item : chain.items) {
+				if (!clauseResult) {
+					clauseResult = (truth >> item.predicate) & 1;
+					if (evaluations)
+						++*evaluations;
+				}
+				if (item.isOR)
+					continue;
+				if (!clauseResult)
+					return false;
+				clauseResult = false;
+			}
+			return true;
+		}
+
+		bool IsEquivalent(const Chain& lhs, const Chain& rhs)
+		{
+			if (lhs.predicates.size() != rhs.predicates.size() || lhs.predicates.size() >= 32)
+				return false;
+
+			const std::uint32_t assignments = 1u << lhs.predicates.size();
+			for (std::uint32_t truth = 0; truth < assignments; truth++)
+				if (Evaluate(lhs, truth) != Evaluate(rhs, truth))
+					return false;
+			return true;
+		}
+
+		double ExpectedEvaluations(const Chain& chain)
+		{
+			const std::uint32_t assignments = 1u << chain.predicates.size();
+			double expected = 0.0;
+			for (std::uint32_t truth = 0; truth < assignments; truth++) {
+				double probability = 1.0;
+				for (std::size_t i = 0; i < chain.predicates.size(); i++)
+					probability *= (truth >> i) & 1 ? chain.predicates[i].passRate : 1.0 - chain.predicates[i].passRate;
+
+				std::size_t evaluations = 0;
+				Evaluate(chain, truth, &evaluations);
+				expected += probability * evaluations;
+			}
+			return expected;
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace CONDITIONS
+	{
+		// One condition function call, by its cost model only; identical calls share a Predicate so truth
+		// assignments stay consistent. RecipeConditions pairs each with the game condition it stands for.
+		struct Predicate
+		{
+			float cost;      // relative evaluation cost
+			float passRate;  // estimated probability of being true
+		};
+
+		// Condition list as the engine stores it: an item flagged isOR is OR'ed with the item after it,
+		// so consecutive OR groups form clauses that are AND'ed together.
+		struct Chain
+		{
+			struct Item
+			{
+				std::size_t predicate;
+				bool isOR;
+			};
+
+			std::vector<Predicate> predicates;
+			std::vector<Item> items;
+		};
+
+		// Recipe chains accept at most this many spells; equivalence checks enumerate every truth assignment.
+		constexpr std::size_t MAX_RECIPE_SPELLS = 8;
+
+		// Predicates of every recipe chain, in this order, followed by one HasSpell per spell.
+		enum RecipePredicate : std::size_t
+		{
+			kScribeLevel,
+			kFilterKnown,
+			kFilterRank,
+			kDustPerk,
+			kFirstSpell
+		};
+
+		// (HasSpell || ScribeLevel >= level) && (HasSpell || FilterKnown == 0) && FilterRank == 1 && HasPerk(Dust) == dustPerk
+		// With several spells, HasSpell becomes HasSpell(a) || HasSpell(b) || ... in both clauses.
+		Chain MakeRecipeShape(std::size_t spellCount);
+
+		// Reorders clauses and the items inside each clause by cost and selectivity; the result is equivalent.
+		Chain Optimize(const Chain& chain);
+
+		// Evaluates the chain with short-circuiting for one truth assignment (bit i = predicate i).
+		bool Evaluate(const Chain& chain, std::uint32_t truth, std::size_t* evaluations = nullptr);
+
+		// True if both chains over the same predicates agree on every truth assignment.
+		bool IsEquivalent(const Chain& lhs, const Chain& rhs);
+
+		// Function evaluations per check, weighted by each predicate's pass rate.
+		double ExpectedEvaluations(const Chain& chain);
+	}
+}
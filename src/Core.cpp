@@ -1,5 +1,22 @@
 #include "Core.hpp"
+#include "CatalogFile.h"
+#include "DustKernel.h"
+#include "FormBuilder.h"
+#include "FormKey.h"
+#include "FormIDPlanner.h"
+#include "FusionRegistry.h"
+#include "FuzzyMatch.h"
+#include "GenerationFilter.h"
+#include "PerkRanks.h"
+#include "PluginExport.h"
+#include "Query.h"
+#include "ScrollCastQueue.h"
+#include "Settings.h"
+#include "Stats.h"
+#include "Trace.h"
 #include "Util.h"
+#include "ZeroCostPool.h"
+#include <execution>
 #include <regex>
 
 namespace SCRIBE
@@ -18,99 +35,164 @@ namespace SCRIBE
 		return tokens;
 	}
 
+	// Times (and optionally traces) calls coming from the VM only; the natives also call each other internally.
+	template <STATS::Native native, auto func>
+	struct Instrumented;
+
+	template <STATS::Native native, typename R, typename... Args, R (*func)(RE::StaticFunctionTag*, Args...)>
+	struct Instrumented<native, func>
+	{
+		static R Call(RE::StaticFunctionTag* tag, Args... args)
+		{
+			STATS::ScopedCall timer(native);
+			// The trace copies what it needs up front, so the arguments can be moved on (batch natives take vectors).
+			TRACE::ScopedCall trace(static_cast<std::uint8_t>(native), args...);
+			return func(tag, std::move(args)...);
+		}
+	};
+
 	bool BindPapyrusFunctions(RE::BSScript::IVirtualMachine* vm)
 	{
-		vm->RegisterFunction("FuseAndCreate", "ScrollScribeExtender", FuseAndCreate);
-		vm->RegisterFunction("CanFuse", "ScrollScribeExtender", CanFuse);
-		vm->RegisterFunction("GetScrollForBook", "ScrollScribeExtender", GetScrollForBook);
-		vm->RegisterFunction("GetSpellFromScroll", "ScrollScribeExtender", GetSpellFromScroll);
-		vm->RegisterFunction("GetZeroCostCopy", "ScrollScribeExtender", GetZeroCostCopy);
-		vm->RegisterFunction("GetApproxFullGoldValue", "ScrollScribeExtender", GetApproxFullGoldValue);
-		vm->RegisterFunction("GetUpgradedSpell", "ScrollScribeExtender", GetUpgradedSpell);
-		vm->RegisterFunction("GetScrollFromSpell", "ScrollScribeExtender", GetScrollFromSpell);
+		using STATS::Native;
+
+		// Natives that only read the catalog and the concurrent caches may run without the VM lock.
+		constexpr bool callableFromTasklets = true;
+
+		vm->RegisterFunction("FuseAndCreate", "ScrollScribeExtender", Instrumented<Native::kFuseAndCreate, FuseAndCreate>::Call);
+		vm->RegisterFunction("CanFuse", "ScrollScribeExtender", Instrumented<Native::kCanFuse, CanFuse>::Call, callableFromTasklets);
+		vm->RegisterFunction("GetScrollForBook", "ScrollScribeExtender", Instrumented<Native::kGetScrollForBook, GetScrollForBook>::Call, callableFromTasklets);
+		vm->RegisterFunction("GetSpellFromScroll", "ScrollScribeExtender", Instrumented<Native::kGetSpellFromScroll, GetSpellFromScroll>::Call, callableFromTasklets);
+		vm->RegisterFunction("GetZeroCostCopy", "ScrollScribeExtender", Instrumented<Native::kGetZeroCostCopy, GetZeroCostCopy>::Call);
+		vm->RegisterFunction("GetApproxFullGoldValue", "ScrollScribeExtender", Instrumented<Native::kGetApproxFullGoldValue, GetApproxFullGoldValue>::Call, callableFromTasklets);
+		vm->RegisterFunction("GetApproxFullGoldValues", "ScrollScribeExtender", Instrumented<Native::kGetApproxFullGoldValues, GetApproxFullGoldValues>::Call, callableFromTasklets);
+		vm->RegisterFunction("GetInventoryGoldValue", "ScrollScribeExtender", Instrumented<Native::kGetInventoryGoldValue, GetInventoryGoldValue>::Call);
+		vm->RegisterFunction("GetUpgradedSpell", "ScrollScribeExtender", Instrumented<Native::kGetUpgradedSpell, GetUpgradedSpell>::Call, callableFromTasklets);
+		vm->RegisterFunction("GetScrollFromSpell", "ScrollScribeExtender", Instrumented<Native::kGetScrollFromSpell, GetScrollFromSpell>::Call, callableFromTasklets);
+		vm->RegisterFunction("FindScrolls", "ScrollScribeExtender", Instrumented<Native::kFindScrolls, FindScrolls>::Call, callableFromTasklets);
+		vm->RegisterFunction("GetScribeStats", "ScrollScribeExtender", GetScribeStats, callableFromTasklets);
+		vm->RegisterFunction("DrainScrollCasts", "ScrollScribeExtender", DrainScrollCasts, callableFromTasklets);
 
 		return true;
 	}
 
-	int GetApproxFullGoldValue(RE::StaticFunctionTag*, RE::TESForm* form)
+	std::vector<RE::TESForm*> DrainScrollCasts(RE::StaticFunctionTag*, int32_t maxCount)
 	{
-		if (form == nullptr)
-			return 0;
-		if (auto weapon = form->As<RE::TESObjectWEAP>(); weapon != nullptr) {
-			logger::info("{} is weapon", form->GetName());
-			if (weapon->formEnchanting == nullptr)
-				return weapon->GetGoldValue();
-			logger::info("{} has enchantment: {}", form->GetName(), weapon->formEnchanting->GetFullName());
-			auto enchItem = weapon->formEnchanting;
-			return (weapon->GetGoldValue() + static_cast<int>(0.4 * enchItem->CalculateTotalGoldValue()));
+		const auto batch = ScrollCastQueue::GetSingleton().Drain(static_cast<std::size_t>(max(maxCount, 0)));
+
+		std::vector<RE::TESForm*> result;
+		result.reserve(batch.size() * 2);
+		for (const auto& cast : batch) {
+			result.push_back(RE::TESForm::LookupByID(cast.scroll));
+			result.push_back(RE::TESForm::LookupByID(cast.caster));
 		}
-		if (auto armor = form->As<RE::TESObjectARMO>(); armor != nullptr) {
-			logger::info("{} is armor", form->GetName());
-			if (armor->formEnchanting == nullptr)
-				return armor->GetGoldValue();
-			logger::info("{} has enchantment: {}", form->GetName(), armor->formEnchanting->GetFullName());
-			auto enchItem = armor->formEnchanting;
-			return (armor->GetGoldValue() + static_cast<int>(0.85 * enchItem->CalculateTotalGoldValue())) / 2;
+		return result;
+	}
+
+	std::vector<std::string> GetScribeStats(RE::StaticFunctionTag*, bool writeToLog)
+	{
+		auto lines = STATS::Format(STATS::Collect());
+
+		const auto pool = ZeroCostPool::GetSingleton().GetStats();
+		lines.push_back(std::format("ZeroCostPool: {} / {} copies | {} recycled", pool.size, pool.capacity, pool.recycled));
+
+		if (writeToLog) {
+			logger::info("{:*^30}", "SCRIBE STATS");
+			for (const auto& line : lines)
+				logger::info("{}", line);
+			logger::info("");
 		}
-		return form->GetGoldValue();
+		return lines;
 	}
 
-	RE::SpellItem* GetZeroCostCopy(RE::StaticFunctionTag*, RE::SpellItem* spell)
+	static float GetEnchantmentGoldValue(RE::EnchantmentItem* enchantment)
 	{
-		if (spell == nullptr)
-			return nullptr;
-		static auto spellFactory = RE::IFormFactory::GetConcreteFormFactoryByType<RE::SpellItem>();
-		if (!spellFactory) {
-			logger::error("Failed to fetch IFormFactory: SPEL!");
-			return nullptr;
+		// An enchantment's effects never change once it exists, so its total is computed once.
+		if (auto value = SCRIBE::CACHE::EnchantmentValueMap.find(enchantment))
+			return *value;
+		return SCRIBE::CACHE::EnchantmentValueMap.insertOrGet(enchantment, enchantment->CalculateTotalGoldValue());
+	}
+
+	static int GetApproxFullGoldValueFunc(RE::TESForm* form)
+	{
+		if (form == nullptr)
+			return 0;
+		switch (form->GetFormType()) {
+		case RE::FormType::Weapon:
+			{
+				auto weapon = static_cast<RE::TESObjectWEAP*>(form);
+				if (weapon->formEnchanting == nullptr)
+					return weapon->GetGoldValue();
+				return (weapon->GetGoldValue() + static_cast<int>(0.4 * GetEnchantmentGoldValue(weapon->formEnchanting)));
+			}
+		case RE::FormType::Armor:
+			{
+				auto armor = static_cast<RE::TESObjectARMO*>(form);
+				if (armor->formEnchanting == nullptr)
+					return armor->GetGoldValue();
+				return (armor->GetGoldValue() + static_cast<int>(0.85 * GetEnchantmentGoldValue(armor->formEnchanting))) / 2;
+			}
+		default:
+			return form->GetGoldValue();
 		}
+	}
 
-		if (!SCRIBE::CACHE::ZeroCostMap.contains(spell)) {
-			auto theScroll = SCRIBE::CACHE::SpellScrollBiMap.containsKey(spell) ? SCRIBE::CACHE::SpellScrollBiMap.getValue(spell) : nullptr;
+	int GetApproxFullGoldValue(RE::StaticFunctionTag*, RE::TESForm* form)
+	{
+		return GetApproxFullGoldValueFunc(form);
+	}
 
-			auto zeroCostSpell = spellFactory->Create();
-			zeroCostSpell->fullName = spell->GetFullName();
-			zeroCostSpell->effects = spell->effects;
-			zeroCostSpell->data.castDuration = spell->data.castDuration;
-			zeroCostSpell->SetDelivery(spell->GetDelivery());
-			zeroCostSpell->SetCastingType(spell->GetCastingType());
-			zeroCostSpell->SetAutoCalc(false);
-			zeroCostSpell->data.flags.set(RE::SpellItem::SpellFlag::kCostOverride);
-			zeroCostSpell->data.costOverride = 0;
+	std::vector<std::int32_t> GetApproxFullGoldValues(RE::StaticFunctionTag*, std::vector<RE::TESForm*> forms)
+	{
+		std::vector<std::int32_t> values;
+		values.reserve(forms.size());
+		for (auto form : forms)
+			values.push_back(GetApproxFullGoldValueFunc(form));
+		return values;
+	}
 
-			for (uint32_t i = 0; theScroll && i < theScroll->GetNumKeywords(); i++)
-				if (auto kwd = theScroll->GetKeywordAt(i); kwd.has_value())
-					zeroCostSpell->AddKeyword(kwd.value());
+	std::int32_t GetInventoryGoldValue(RE::StaticFunctionTag*, RE::TESObjectREFR* container)
+	{
+		if (container == nullptr)
+			return 0;
 
-			SCRIBE::CACHE::ZeroCostMap.insert_or_assign(spell, zeroCostSpell);
+		std::int64_t total = 0;
+		for (const auto& [object, count] : container->GetInventoryCounts()) {
+			if (count > 0)
+				total += static_cast<std::int64_t>(GetApproxFullGoldValueFunc(object)) * count;
 		}
+		return static_cast<std::int32_t>(std::clamp<std::int64_t>(total, 0, (std::numeric_limits<std::int32_t>::max)()));
+	}
 
-		return SCRIBE::CACHE::ZeroCostMap[spell];
+	RE::SpellItem* GetZeroCostCopy(RE::StaticFunctionTag*, RE::SpellItem* spell)
+	{
+		return ZeroCostPool::GetSingleton().Get(spell);
 	}
 
 	RE::SpellItem* GetSpellFromScroll(RE::StaticFunctionTag*, RE::ScrollItem* scroll)
 	{
-		if (SCRIBE::CACHE::SpellScrollBiMap.containsValue(scroll))
-			return SCRIBE::CACHE::SpellScrollBiMap.getKey(scroll);
-		return nullptr;
+		const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		if (auto id = catalog.FindByScroll(scroll); id != CATALOG::INVALID_SCROLL_ID)
+			return catalog.GetSpell(id);
+		return SCRIBE::CACHE::FusionScrollToSpellMap.find(scroll).value_or(nullptr);
 	}
 
 	RE::ScrollItem* GetScrollForBook(RE::StaticFunctionTag*, RE::TESObjectBOOK* book)
 	{
-		if (!SCRIBE::CACHE::BookSpellBiMap.containsKey(book))
-			return nullptr;
-		auto bookSpell = SCRIBE::CACHE::BookSpellBiMap.getValue(book);
-		if (!SCRIBE::CACHE::SpellScrollBiMap.containsKey(bookSpell))
+		const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		auto bookID = catalog.FindByBook(book);
+		if (bookID == CATALOG::INVALID_SCROLL_ID)
 			return nullptr;
 
-		return SCRIBE::CACHE::SpellScrollBiMap.getValue(bookSpell);
+		return GetScrollFromSpell(nullptr, catalog.GetSpell(bookID));
 	}
 
 	bool CanFuse(RE::StaticFunctionTag*, RE::ScrollItem* scrollOne, RE::ScrollItem* scrollTwo, bool canDoubleFuse)
 	{
-		if (SCRIBE::CACHE::FusionComponentsToResultBiMap.containsValue(scrollOne) && SCRIBE::CACHE::FusionComponentsToResultBiMap.containsValue(scrollTwo)) {
-			auto first = SCRIBE::CACHE::FusionComponentsToResultBiMap.getKey(scrollOne);
-			auto second = SCRIBE::CACHE::FusionComponentsToResultBiMap.getKey(scrollTwo);
+		auto firstComponents = SCRIBE::CACHE::FusionResultToComponentsMap.find(scrollOne);
+		auto secondComponents = SCRIBE::CACHE::FusionResultToComponentsMap.find(scrollTwo);
+		if (firstComponents && secondComponents) {
+			const auto& first = *firstComponents;
+			const auto& second = *secondComponents;
 
 			if (first.first == second.first || first.first == second.second || first.second == second.first || first.second == second.second) {
 				logger::info("Incest fusion. Denied.");
@@ -140,12 +222,13 @@ namespace SCRIBE
 	static RE::SpellItem* GetUpgradedSpellFunc(RE::SpellItem* spell, bool listCandidates = false)
 	{
 		static constexpr auto getSpellScrollValue = [](RE::SpellItem* spell) {
-			return SCRIBE::CACHE::SpellScrollBiMap.containsKey(spell) ? SCRIBE::CACHE::SpellScrollBiMap.getValue(spell)->GetGoldValue() : 0;
+			const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+			auto id = catalog.FindBySpell(spell);
+			return id != CATALOG::INVALID_SCROLL_ID ? catalog.GetScroll(id)->GetGoldValue() : 0;
 		};
 
 		static auto biasedRandomNumber = [&](const std::vector<RE::SpellItem*>& container) {
-			static std::random_device rd;
-			static std::mt19937 gen(rd());
+			thread_local std::mt19937 gen(std::random_device{}());
 			std::vector<int> weights;
 
 			int w = 10000;
@@ -164,12 +247,15 @@ namespace SCRIBE
 		const static auto player = RE::PlayerCharacter::GetSingleton();
 		std::vector<RE::SpellItem*> candidates;
 
+		const auto keywordSpells = SCRIBE::CACHE::KeywordSpellListMap.Load();
 		for (auto& eff : spell->effects) {
 			for (size_t i = 0; i < eff->baseEffect->numKeywords && i < 2; i++) {
-				auto& kywd = eff->baseEffect->keywords[i];
-				for (auto& upSpell : SCRIBE::CACHE::KeywordSpellListMap[kywd]) {
-					if ((SCRIBE::CACHE::SpellScrollBiMap.containsKey(upSpell) &&
-							SCRIBE::CACHE::SpellScrollBiMap.containsKey(spell)) &&
+				auto spellList = keywordSpells->find(eff->baseEffect->keywords[i]);
+				if (spellList == keywordSpells->end())
+					continue;
+				for (auto& upSpell : spellList->second) {
+					if ((CATALOG::ScrollCatalog::GetSingleton().FindBySpell(upSpell) != CATALOG::INVALID_SCROLL_ID &&
+							CATALOG::ScrollCatalog::GetSingleton().FindBySpell(spell) != CATALOG::INVALID_SCROLL_ID) &&
 						(getSpellScrollValue(upSpell) > getSpellScrollValue(spell)) &&
 						(upSpell->effects.front()->baseEffect->data.resistVariable == spell->effects.front()->baseEffect->data.resistVariable || upSpell->effects.front()->baseEffect->data.archetype == spell->effects.front()->baseEffect->data.archetype) && upSpell->data.delivery == spell->data.delivery) {
 						candidates.push_back(upSpell);
@@ -211,7 +297,23 @@ namespace SCRIBE
 
 	RE::ScrollItem* GetScrollFromSpell(RE::StaticFunctionTag*, RE::SpellItem* spell)
 	{
-		return SCRIBE::CACHE::SpellScrollBiMap.containsKey(spell) ? SCRIBE::CACHE::SpellScrollBiMap.getValue(spell) : nullptr;
+		const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		if (auto id = catalog.FindBySpell(spell); id != CATALOG::INVALID_SCROLL_ID)
+			return catalog.GetScroll(id);
+		return SCRIBE::CACHE::FusionSpellToScrollMap.find(spell).value_or(nullptr);
+	}
+
+	std::vector<RE::ScrollItem*> FindScrolls(RE::StaticFunctionTag*, int32_t school, int32_t minTier, int32_t maxTier, int32_t castingType, RE::BGSKeyword* keyword, int32_t offset, int32_t count)
+	{
+		const QUERY::ScrollFilter filter{ school, minTier, maxTier, castingType, keyword };
+		const auto ids = QUERY::ScrollIndex::GetSingleton().Find(filter, static_cast<std::size_t>(max(offset, 0)), static_cast<std::size_t>(max(count, 0)));
+
+		const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		std::vector<RE::ScrollItem*> result;
+		result.reserve(ids.size());
+		for (auto id : ids)
+			result.push_back(catalog.GetScroll(id));
+		return result;
 	}
 
 	RE::ScrollItem* FuseAndCreateFunc(RE::ScrollItem* scrollOne, RE::ScrollItem* scrollTwo)
@@ -229,10 +331,23 @@ namespace SCRIBE
 
 		logger::info("Fusion: {} + {}", scrollOne->GetName(), scrollTwo->GetName());
 
-		if (SCRIBE::CACHE::FusionComponentsToResultBiMap.containsKey({ scrollOne, scrollTwo }))
-			return SCRIBE::CACHE::FusionComponentsToResultBiMap.getValue({ scrollOne, scrollTwo });
-		if (SCRIBE::CACHE::FusionComponentsToResultBiMap.containsKey({ scrollTwo, scrollOne }))
-			return SCRIBE::CACHE::FusionComponentsToResultBiMap.getValue({ scrollTwo, scrollOne });
+		constexpr auto findFused = [](RE::ScrollItem* scrollOne, RE::ScrollItem* scrollTwo) -> RE::ScrollItem* {
+			if (auto fused = SCRIBE::CACHE::FusionComponentsToResultMap.find({ scrollOne, scrollTwo }))
+				return *fused;
+			return SCRIBE::CACHE::FusionComponentsToResultMap.find({ scrollTwo, scrollOne }).value_or(nullptr);
+		};
+
+		if (auto fused = findFused(scrollOne, scrollTwo)) {
+			STATS::RecordCache(STATS::Cache::kFusionComponents, true);
+			return fused;
+		}
+		STATS::RecordCache(STATS::Cache::kFusionComponents, false);
+
+		// Two VM threads may fuse the same pair at once; only one of them builds the scroll.
+		static std::mutex fusionLock;
+		std::scoped_lock guard(fusionLock);
+		if (auto fused = findFused(scrollOne, scrollTwo))
+			return fused;
 
 		static auto scrollFactory = RE::IFormFactory::GetConcreteFormFactoryByType<RE::ScrollItem>();
 
@@ -243,12 +358,9 @@ namespace SCRIBE
 
 		auto scrollObj = scrollFactory->Create();
 
-		for (uint32_t i = 0; i < scrollOne->effects.size(); i++) {
-			scrollObj->effects.emplace_back(scrollOne->effects[i]);
-		}
-		for (uint32_t i = 0; i < scrollTwo->effects.size(); i++) {
-			scrollObj->effects.emplace_back(scrollTwo->effects[i]);
-		}
+		FormBuilder builder(scrollObj);
+		builder.AddEffects(scrollOne->effects);
+		builder.AddEffects(scrollTwo->effects);
 
 		auto fusedScrollName =
 			"Fused Scroll of "s +
@@ -256,24 +368,20 @@ namespace SCRIBE
 			" & " +
 			SCRIBE::UTIL::ExtractSpellName(scrollTwo->GetFullName());
 
-		for (uint32_t i = 0; i < scrollOne->GetNumKeywords(); i++)
-			if (auto kwd = scrollOne->GetKeywordAt(i); kwd.has_value())
-				scrollObj->AddKeyword(kwd.value());
-		for (uint32_t i = 0; i < scrollTwo->GetNumKeywords(); i++)
-			if (auto kwd = scrollTwo->GetKeywordAt(i); kwd.has_value())
-				scrollObj->AddKeyword(kwd.value());
+		builder.AddKeywords(scrollOne);
+		builder.AddKeywords(scrollTwo);
 
-		if (scrollObj->HasKeyword(fusedKYWD))
-			scrollObj->AddKeyword(doubleFusedKYWD);
+		if (builder.HasKeyword(fusedKYWD))
+			builder.AddKeyword(doubleFusedKYWD);
 		else
-			scrollObj->AddKeyword(fusedKYWD);
+			builder.AddKeyword(fusedKYWD);
 
-		scrollObj->menuDispObject = RE::TESForm::LookupByID<RE::TESBoundObject>(0x76e8f);
+		builder.Commit();
 
-		SCRIBE::CACHE::FusionComponentsToResultBiMap.insert({ scrollOne, scrollTwo }, scrollObj);
+		scrollObj->menuDispObject = RE::TESForm::LookupByID<RE::TESBoundObject>(0x76e8f);
 
-		auto spellOne = SCRIBE::CACHE::SpellScrollBiMap.containsValue(scrollOne) ? SCRIBE::CACHE::SpellScrollBiMap.getKey(scrollOne) : nullptr;
-		auto spellTwo = SCRIBE::CACHE::SpellScrollBiMap.containsValue(scrollTwo) ? SCRIBE::CACHE::SpellScrollBiMap.getKey(scrollTwo) : nullptr;
+		auto spellOne = GetSpellFromScroll(nullptr, scrollOne);
+		auto spellTwo = GetSpellFromScroll(nullptr, scrollTwo);
 
 		scrollObj->weight = scrollOne->weight + scrollTwo->weight;
 		scrollObj->value = scrollOne->value + scrollTwo->value;
@@ -288,12 +396,16 @@ namespace SCRIBE
 
 		scrollObj->fullName = fusedScrollName;
 
+		// Publish only once the scroll is fully built.
+		SCRIBE::CACHE::FusionResultToComponentsMap.insertOrAssign(scrollObj, { scrollOne, scrollTwo });
+		SCRIBE::CACHE::FusionComponentsToResultMap.insertOrAssign({ scrollOne, scrollTwo }, scrollObj);
+
 		return scrollObj;
 	}
 
 	void GenerateFusedConcSpell(RE::ScrollItem* scrollObj)
 	{
-		if (SCRIBE::CACHE::SpellScrollBiMap.containsValue(scrollObj))
+		if (SCRIBE::CACHE::FusionScrollToSpellMap.contains(scrollObj))
 			return;
 
 		static auto spellFactory = RE::IFormFactory::GetConcreteFormFactoryByType<RE::SpellItem>();
@@ -309,22 +421,49 @@ namespace SCRIBE
 
 		auto fusedSpell = spellFactory->Create();
 		fusedSpell->data = scrollObj->SpellItem::data;
-		for (auto& eff : scrollObj->effects)
-			fusedSpell->effects.push_back(eff);
+
+		FormBuilder builder(fusedSpell);
+		builder.AddEffects(scrollObj->effects);
+		builder.Commit();
 
 		dataHandler->GetFormArray<RE::SpellItem>().emplace_back(fusedSpell);
-		SCRIBE::CACHE::SpellScrollBiMap.insert(fusedSpell, scrollObj);
+		SCRIBE::CACHE::FusionSpellToScrollMap.insertOrAssign(fusedSpell, scrollObj);
+		SCRIBE::CACHE::FusionScrollToSpellMap.insertOrAssign(scrollObj, fusedSpell);
 		logger::info("\tCreated Fusion SPEL: 0x{:08X}", fusedSpell->GetFormID());
 	}
 
 	RE::ScrollItem* FuseAndCreate(RE::StaticFunctionTag*, RE::ScrollItem* scrollOne, RE::ScrollItem* scrollTwo)
 	{
+		// Reuse a recorded fusion of the same ingredients instead of recording a duplicate.
+		if (auto product = FusionRegistry::GetSingleton().FindPending(scrollOne, scrollTwo); product != 0x0) {
+			if (auto restored = FusionRegistry::GetSingleton().Materialize(product); restored != nullptr)
+				return restored;
+		}
+
+		// Fusions already built this session keep their FormID.
+		const bool alreadyFused = SCRIBE::CACHE::FusionComponentsToResultMap.contains({ scrollOne, scrollTwo }) || SCRIBE::CACHE::FusionComponentsToResultMap.contains({ scrollTwo, scrollOne });
+
 		auto result = FuseAndCreateFunc(scrollOne, scrollTwo);
 		if (result == nullptr)
 			return nullptr;
+		if (alreadyFused) {
+			FusionRegistry::GetSingleton().Track(result);
+			return result;
+		}
 
-		if (FORMS::GetSingleton().GetUseOffset())
-			result->SetFormID(FORMS::GetSingleton().NextFormID(), false);
+		if (FORMS::GetSingleton().GetUseOffset()) {
+			// Fusions of other saves are reserved through [FUSIONIDS]; still skip any ID a live form holds.
+			constexpr int maxAttempts = 64;
+			for (int i = 0; i < maxAttempts; i++) {
+				auto formID = FormIDAllocator::GetSingleton().Allocate();
+				if (formID == 0)
+					break;
+				if (RE::TESForm::LookupByID(formID) == nullptr) {
+					result->SetFormID(formID, false);
+					break;
+				}
+			}
+		}
 
 		static auto dataHandler = RE::TESDataHandler::GetSingleton();
 		if (!dataHandler) {
@@ -332,31 +471,8 @@ namespace SCRIBE
 			return nullptr;
 		}
 
-		auto& ini = SCRIBE::CONFIG::Plugin::GetSingleton();
-
-		RE::FormID leftFormID = scrollOne->GetFormID();
-		if (SCRIBE::CACHE::FormIDRelocationBiMap.containsKey(leftFormID))
-			leftFormID = SCRIBE::CACHE::FormIDRelocationBiMap.getValue(leftFormID);
-
-		std::string leftFormString = std::format("0x{:08X}", leftFormID);
-		if (leftFormID < 0xFF000000) {
-			leftFormString = std::format("{}~0x{:08X}", scrollOne->GetFile(0)->GetFilename(), scrollOne->GetLocalFormID());
-		}
-
-		RE::FormID rightFormID = scrollTwo->GetFormID();
-		if (SCRIBE::CACHE::FormIDRelocationBiMap.containsKey(rightFormID))
-			rightFormID = SCRIBE::CACHE::FormIDRelocationBiMap.getValue(rightFormID);
-		std::string rightFormString = std::format("0x{:08X}", rightFormID);
-		if (rightFormID < 0xFF000000) {
-			rightFormString = std::format("{}~0x{:08X}", scrollTwo->GetFile(0)->GetFilename(), scrollTwo->GetLocalFormID());
-		}
-
-		ini.SetValue("FUSION",
-			std::format("0x{:08X}", result->GetFormID()).c_str(),
-			std::format("{}+{}", leftFormString, rightFormString).c_str(),
-			std::format("# {}", result->GetName()).c_str());
-
 		dataHandler->GetFormArray<RE::ScrollItem>().emplace_back(result);
+		FusionRegistry::GetSingleton().Track(result);
 
 		return result;
 	}
@@ -365,19 +481,19 @@ namespace SCRIBE
 	{
 		logger::info("{:*^30}", "CHECK OFFSET");
 		auto& ini = SCRIBE::CONFIG::Plugin::GetSingleton();
-		RE::FormID off = 0x0;
-		for (const auto& [key, value] : ini.GetAllKeyValuePairs("SCROLLS")) {
-			auto cur = UTIL::lexical_cast_formid(value);
-			if (cur > off)
-				off = cur;
-		}
-		for (const auto& [key, value] : ini.GetAllKeyValuePairs("FUSION")) {
-			auto cur = UTIL::lexical_cast_formid(key);
-			if (cur > off)
-				off = cur;
-		}
 
-		if (off > 0x0 && off < FORMS::FORMID_OFFSET_BASE) {
+		std::vector<RE::FormID> recorded;
+		for (const auto& [key, value] : ini.GetAllKeyValuePairs("SCROLLS"))
+			recorded.push_back(UTIL::lexical_cast_formid(value));
+		for (const auto& [key, value] : ini.GetAllKeyValuePairs("FUSION"))
+			recorded.push_back(UTIL::lexical_cast_formid(key));
+		// Fusions of every save, not only the legacy ones above.
+		for (const auto& [key, value] : ini.GetAllKeyValuePairs("FUSIONIDS"))
+			recorded.push_back(UTIL::lexical_cast_formid(key));
+
+		const bool anyRecorded = std::ranges::any_of(recorded, [](RE::FormID formID) { return formID > 0x0; });
+		const bool anyOffset = std::ranges::any_of(recorded, [](RE::FormID formID) { return formID >= FormIDAllocator::BASE; });
+		if (anyRecorded && !anyOffset) {
 			logger::info("V2 Format detected. Offset will not be used.\n");
 			FORMS::GetSingleton().SetUseOffset(false);
 			return;
@@ -385,195 +501,98 @@ namespace SCRIBE
 		if (ini.GetLongValue("VERSION", "Version") < 0x3)
 			ini.SetLongValue("VERSION", "Version", 0x3);
 
-		off &= ~FORMS::FORMID_OFFSET_BASE;
-		logger::info("Local Offset: 0x{:08X}", off);
-		logger::info("Global Offset: 0x{:08X}\n", FORMS::FORMID_OFFSET_BASE);
+		auto& allocator = FormIDAllocator::GetSingleton();
+		allocator.Seed(recorded);
+
+		const auto stats = allocator.GetStats();
+		logger::info("Global Offset: 0x{:08X}", FormIDAllocator::BASE);
+		logger::info("High Water: 0x{:08X} | Occupied: {} | Reclaimable: {} | Capacity: {}\n", FormIDAllocator::BASE + stats.highWater, stats.occupied, stats.reclaimable, stats.capacity);
 
-		FORMS::GetSingleton().SetOffset(off);
 		FORMS::GetSingleton().SetUseOffset(true);
 	}
 
-	struct FusionKeyValue
+	void SetupZeroCostPool()
 	{
-		RE::FormID product;
-		std::pair<std::string, RE::FormID> leftIngredient;
-		std::pair<std::string, RE::FormID> rightIngredient;
-	};
-	void LoadFused()
-	{
-		auto& ini = SCRIBE::CONFIG::Plugin::GetSingleton();
-
-		size_t purgedCount = 0;
-		bool updateFile = !FORMS::GetSingleton().GetUseOffset();
+		const auto& settings = CONFIG::GetSettings();
+		auto& pool = ZeroCostPool::GetSingleton();
 
-		logger::info("{:*^30}", "RESTORING FUSIONS");
+		pool.SetCapacity(static_cast<std::size_t>(max(settings.zeroCostCacheSize, 0L)));
 
-		static auto dataHandler = RE::TESDataHandler::GetSingleton();
-		if (!dataHandler) {
-			logger::error("Failed to fetch TESDataHandler!");
+		const auto prewarmCount = static_cast<std::size_t>(max(settings.zeroCostPrewarmCount, 0L));
+		if (prewarmCount == 0)
 			return;
-		}
-
-		constexpr auto splitComponents = [](const std::string& input) -> std::pair<std::string, std::string> {
-			std::pair<std::string, std::string> components;
 
-			std::size_t plusPos = input.find("+");
+		// Low-tier scrolls drop and sell far more often, so warm those first.
+		std::vector<RE::SpellItem*> spells;
+		const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		for (auto tier = 0; tier < static_cast<int>(CATALOG::Tier::kTotal) && spells.size() < prewarmCount; tier++) {
+			for (auto id : QUERY::ScrollIndex::GetSingleton().Find({ QUERY::ANY, tier, tier }, 0, prewarmCount - spells.size()))
+				spells.push_back(catalog.GetSpell(id));
+		}
 
-			if (plusPos != std::string::npos) {
-				components.first = input.substr(0, plusPos);
-				components.second = input.substr(plusPos + 1);
-			}
+		logger::info("Prewarming {} zero-cost spells.\n", spells.size());
+		pool.Prewarm(std::move(spells));
+	}
 
-			return components;
-		};
+	void VerifyPrebakedCatalog()
+	{
+		std::ifstream file(std::filesystem::path("Data/SKSE/Plugins") / PREBAKE::FILE_NAME, std::ios::binary);
+		if (!file)
+			return;
 
-		constexpr auto getPluginNameWithLocalID = [](const std::string& part) -> std::pair<std::string, RE::FormID> {
-			std::size_t tildePos = part.find("~");
+		logger::info("{:*^30}", "VERIFYING PREBAKED CATALOG");
 
-			if (tildePos == std::string::npos)
-				return { std::string(), UTIL::lexical_cast_formid(part) };
+		const auto prebaked = PREBAKE::Read(file);
+		if (!prebaked) {
+			logger::warn("{} is not a version {} catalog. Ignoring.\n", PREBAKE::FILE_NAME, PREBAKE::VERSION);
+			return;
+		}
 
-			std::string pluginName = part.substr(0, tildePos);
-			auto localFormID = UTIL::lexical_cast_formid(part.substr(tildePos + 1));
-			return { pluginName, localFormID };
+		// Plugin names on disk and in the load order may differ in case.
+		const auto makeKey = [](std::string_view plugin, RE::FormID localFormID) {
+			std::string key(plugin);
+			std::ranges::transform(key, key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return std::format("{}~0x{:08X}", key, localFormID);
 		};
 
-		auto& keyValues = ini.GetAllKeyValuePairs("FUSION");
-
-		std::vector<FusionKeyValue> lateLoadFusions;
-
-		for (auto& kv : keyValues) {
-			auto fusionResultFormID = UTIL::lexical_cast_formid(kv.first);
-
-			auto fusionComponents = splitComponents(kv.second);
-			logger::info("Restoring {} with components {} & {}", kv.first, fusionComponents.first, fusionComponents.second);
-
-			auto leftFullPair = getPluginNameWithLocalID(fusionComponents.first);
-			auto rightFullPair = getPluginNameWithLocalID(fusionComponents.second);
-
-			if (leftFullPair.first.empty() && leftFullPair.second == 0x0 || rightFullPair.first.empty() && rightFullPair.second == 0x0) {
-				logger::info("Invalid data for {}", kv.first);
-				ini.DeleteKey("FUSION", kv.first);
-				++purgedCount;
+		std::unordered_map<std::string, const PREBAKE::Entry*> byBook;
+		byBook.reserve(prebaked->entries.size());
+		for (const auto& entry : prebaked->entries)
+			byBook.try_emplace(makeKey(prebaked->plugins[entry.bookPlugin], entry.bookLocalID), &entry);
+
+		const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		std::size_t matched = 0, differing = 0, notPrebaked = 0;
+		for (CATALOG::ScrollID id = 0; id < catalog.size(); id++) {
+			const auto book = catalog.GetBook(id);
+			const auto bookFile = book->GetFile(0);
+			auto it = byBook.find(makeKey(bookFile ? bookFile->GetFilename() : "", book->GetLocalFormID()));
+			if (it == byBook.end()) {
+				++notPrebaked;
 				continue;
 			}
 
-			RE::ScrollItem* leftScrollItem;
-			RE::ScrollItem* rightScrollItem;
-
-			if (!leftFullPair.first.empty())
-				leftScrollItem = dataHandler->LookupForm<RE::ScrollItem>(leftFullPair.second, leftFullPair.first);
-			else
-				leftScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(leftFullPair.second);
-
-			if (!rightFullPair.first.empty())
-				rightScrollItem = dataHandler->LookupForm<RE::ScrollItem>(rightFullPair.second, rightFullPair.first);
-			else
-				rightScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(rightFullPair.second);
-
-			if (!leftScrollItem && SCRIBE::CACHE::FormIDRelocationBiMap.containsKey(leftFullPair.second)) {
-				auto rel = SCRIBE::CACHE::FormIDRelocationBiMap.getValue(leftFullPair.second);
-				logger::info("\tFound relocation: 0x{:08X} => 0x{:08X}", leftFullPair.second, rel);
-				leftScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(rel);
-			}
-
-			if (!rightScrollItem && SCRIBE::CACHE::FormIDRelocationBiMap.containsKey(rightFullPair.second)) {
-				auto rel = SCRIBE::CACHE::FormIDRelocationBiMap.getValue(rightFullPair.second);
-				logger::info("\tFound relocation: 0x{:08X} => 0x{:08X}", rightFullPair.second, rel);
-				rightScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(rel);
-			}
-
-			if (leftScrollItem && rightScrollItem) {
-				auto loadedScroll = FuseAndCreateFunc(leftScrollItem, rightScrollItem);
-
-				if (loadedScroll == nullptr) {
-					logger::info("\tFuseAndCreateFunc RETURNED NULL!");
-					ini.DeleteKey("FUSION", kv.first);
-					++purgedCount;
-				} else {
-					logger::info("\tForcing FormID to 0x{:08X}", fusionResultFormID);
-
-					if (auto entry = RE::TESForm::LookupByID<RE::TESForm>(fusionResultFormID); entry != nullptr) {
-						logger::info("\tWARNING FORMID ALREADY IN USE BY {} ({})! Choosing to swap: 0x{:08X} <=> 0x{:08X}", entry->GetName(), RE::FormTypeToString(entry->GetFormType()), loadedScroll->GetFormID(), entry->GetFormID());
-						entry->SetFormID(loadedScroll->formID, updateFile);
-						loadedScroll->SetFormID(fusionResultFormID, updateFile);
-					} else {
-						loadedScroll->SetFormID(fusionResultFormID, updateFile);
-					}
-				}
+			const auto& entry = *it->second;
+			if (entry.rank == catalog.GetRank(id) && entry.level == catalog.GetLevel(id) && entry.tier == static_cast<std::uint8_t>(catalog.GetTier(id))
+				&& entry.baseDust == catalog.GetBaseDust(id) && entry.reducedDust == catalog.GetReducedDust(id) && entry.concentration == catalog.IsConcentration(id)) {
+				++matched;
 			} else {
-				FusionKeyValue entry{
-					fusionResultFormID,
-					leftFullPair,
-					rightFullPair
-				};
-				lateLoadFusions.push_back(entry);
-				logger::info("Invalid entry or components not loaded yet? Deferring...");
+				logger::info("{} (0x{:08X}) differs: rank {}/{} | level {}/{} | tier {}/{} | dust {}/{} (prebaked/generated)",
+					book->GetName(), book->GetFormID(),
+					entry.rank, catalog.GetRank(id),
+					entry.level, catalog.GetLevel(id),
+					entry.tier, static_cast<std::uint8_t>(catalog.GetTier(id)),
+					entry.baseDust, catalog.GetBaseDust(id));
+				++differing;
 			}
+			byBook.erase(it);
 		}
 
-		for (auto& kv : lateLoadFusions) {
-			logger::info("RETRY 0x{:08X} with components 0x{:08X} & 0x{:08X}", kv.product, kv.leftIngredient.second, kv.rightIngredient.second);
-
-			RE::ScrollItem* leftScrollItem;
-			RE::ScrollItem* rightScrollItem;
-
-			if (!kv.leftIngredient.first.empty())
-				leftScrollItem = dataHandler->LookupForm<RE::ScrollItem>(kv.leftIngredient.second, kv.leftIngredient.first);
-			else
-				leftScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(kv.leftIngredient.second);
-
-			if (!kv.rightIngredient.first.empty())
-				rightScrollItem = dataHandler->LookupForm<RE::ScrollItem>(kv.rightIngredient.second, kv.rightIngredient.first);
-			else
-				rightScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(kv.rightIngredient.second);
-
-			if (!leftScrollItem && SCRIBE::CACHE::FormIDRelocationBiMap.containsKey(kv.leftIngredient.second)) {
-				auto rel = SCRIBE::CACHE::FormIDRelocationBiMap.getValue(kv.leftIngredient.second);
-				logger::info("\tFound relocation: 0x{:08X} => 0x{:08X}", kv.leftIngredient.second, rel);
-				leftScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(rel);
-			}
-
-			if (!rightScrollItem && SCRIBE::CACHE::FormIDRelocationBiMap.containsKey(kv.rightIngredient.second)) {
-				auto rel = SCRIBE::CACHE::FormIDRelocationBiMap.getValue(kv.rightIngredient.second);
-				logger::info("\tFound relocation: 0x{:08X} => 0x{:08X}", kv.rightIngredient.second, rel);
-				rightScrollItem = RE::TESForm::LookupByID<RE::ScrollItem>(rel);
-			}
-
-			if (leftScrollItem && rightScrollItem) {
-				auto loadedScroll = FuseAndCreateFunc(leftScrollItem, rightScrollItem);
-
-				if (loadedScroll == nullptr) {
-					logger::info("\tFuseAndCreateFunc RETURNED NULL!");
-					ini.DeleteKey("FUSION", std::format("0x{:08X}", kv.product));
-					++purgedCount;
-				} else {
-					logger::info("\tForcing FormID to 0x{:08X}", kv.product);
-
-					if (auto entry = RE::TESForm::LookupByID<RE::TESForm>(kv.product); entry != nullptr) {
-						logger::info("\tWARNING FORMID ALREADY IN USE BY {} ({})! Choosing to swap: 0x{:08X} <=> 0x{:08X}", entry->GetName(), RE::FormTypeToString(entry->GetFormType()), loadedScroll->GetFormID(), entry->GetFormID());
-						entry->SetFormID(loadedScroll->formID, updateFile);
-						loadedScroll->SetFormID(kv.product, updateFile);
-					} else {
-						loadedScroll->SetFormID(kv.product, updateFile);
-					}
-				}
-			} else {
-				logger::info("\tInvalid Entry! Purging...");
-				ini.DeleteKey("FUSION", std::format("0x{:08X}", kv.product));
-				++purgedCount;
-			}
-		}
-
-		logger::info("Done.\n");
+		logger::info("{} scrolls match the prebaked catalog, {} differ, {} were not prebaked. {} prebaked tomes were not generated.\n", matched, differing, notPrebaked, byBook.size());
 	}
 
 	void PatchSoulGemFormList()
 	{
-		auto& ini = SCRIBE::CONFIG::Plugin::GetSingleton();
-
-		bool patchGems = ini.GetBoolValue("SETTINGS", "PatchSoulgems");
-		if (!patchGems)
+		if (!CONFIG::GetSettings().patchSoulgems)
 			return;
 
 		logger::info("{:*^30}", "PATCHING SOULGEM LISTS");
@@ -625,24 +644,7 @@ namespace SCRIBE
 			ini.SetLongValue("VERSION", "Version", 0L);
 		}
 
-		if (!ini.HasKey("SETTINGS", "ModSpellChargingTime"))
-			ini.SetBoolValue("SETTINGS", "ModSpellChargingTime", true, "# If true, will make concentration spells/scrolls charge up instantly. Might not affect master-tier spells.");
-
-		if (!ini.HasKey("SETTINGS", "PatchVanillaScrolls")) {
-			ini.SetBoolValue("SETTINGS", "PatchVanillaScrolls", true, "# If true, will attempt to integrate vanilla/modded scrolls into Scribe's systems.");
-		}
-
-		if (!ini.HasKey("SETTINGS", "ApplyScrollMismatchFix")) {
-			ini.SetBoolValue("SETTINGS", "ApplyScrollMismatchFix", true, "# If true, will match scroll stats to be the same as their origin spell. This is necessary for certain modpacks that come with incorrectly setup scrolls.");
-		}
-
-		if (!ini.HasKey("SETTINGS", "PatchSoulgems")) {
-			ini.SetBoolValue("SETTINGS", "PatchSoulgems", true, "# If true, will integrate all (non-reusable) soulgems into Scribe's systems.");
-		}
-
-		if (!ini.HasKey("SETTINGS", "Generate10xRecipes")) {
-			ini.SetBoolValue("SETTINGS", "Generate10xRecipes", false, "# If true, will generate the recipes to craft 10 scrolls at a time. Leave false to declutter the crafting menu.");
-		}
+		CONFIG::LoadSettings(static_cast<std::uint32_t>(max(ini.GetLongValue("VERSION", "Version"), 0L)));
 
 		logger::info("Done.\n");
 	}
@@ -666,30 +668,32 @@ namespace SCRIBE
 
 			auto bookFormID = UTIL::lexical_cast_formid(kv.first);
 			if (bookFormID == 0x0) {
-				ini.DeleteKey("SCROLLS", kv.first);
+				ini.DeleteKey("SCROLLS", std::string(kv.first));
 				continue;
 			}
 
 			auto bookForm = RE::TESForm::LookupByID<RE::TESObjectBOOK>(bookFormID);
 			if (bookForm == nullptr) {
-				ini.DeleteKey("SCROLLS", kv.first);
+				ini.DeleteKey("SCROLLS", std::string(kv.first));
 				continue;
 			}
 
-			auto bookSourceFile = bookForm->GetFile(0)->GetFilename();
-			auto newKey = std::format("{}~0x{:08X}", bookSourceFile, bookForm->GetLocalFormID());
+			auto newKey = FormatFormKey(GetFormKey(bookForm));
 
 			logger::info("\tChange key {} => {}", kv.first, newKey);
-			ini.DeleteKey("SCROLLS", kv.first);
+			const std::string value(kv.second);
+			ini.DeleteKey("SCROLLS", std::string(kv.first));
 			ini.SetValue("SCROLLS",
 				newKey,
-				kv.second,
+				value,
 				std::format("# {}", bookForm->GetName()).c_str());
 		}
 
 		logger::info("\tDone.");
 	}
 
+	static_assert(INI_VERSION == CONFIG::GetSchemaVersion(), "INI_VERSION must match the newest settings in SETTINGS_SCHEMA");
+
 	void PerformIniMigrations()
 	{
 		auto& ini = SCRIBE::CONFIG::Plugin::GetSingleton();
@@ -717,6 +721,10 @@ namespace SCRIBE
 			}
 		}
 
+		// Later versions only add settings, which LoadSettings has already written (and logged) with their defaults.
+		if (loadedVersion >= 3 && loadedVersion < SCRIBE::INI_VERSION)
+			loadedVersion = SCRIBE::INI_VERSION;
+
 		ini.SetLongValue("VERSION", "Version", loadedVersion);
 
 		logger::info("Done.\n");
@@ -737,26 +745,27 @@ namespace SCRIBE
 
 		size_t removedEntries = 0;
 
-		std::map<std::string, bool> foundPlugins;
+		std::unordered_map<std::uint32_t, bool> foundPlugins;
 
 		for (auto& kv : keyValues) {
 			auto& pluginSource = kv.first;
 
-			std::size_t tildePos = pluginSource.find("~");
-
-			if (tildePos != std::string::npos) {
-				std::string pluginName = pluginSource.substr(0, tildePos);
+			if (auto key = ParseFormKey(pluginSource); key != INVALID_FORM_KEY) {
+				const auto plugin = GetPluginIndex(key);
 
-				if (!foundPlugins.contains(pluginName))
-					foundPlugins.insert_or_assign(pluginName, dataHandler->LookupModByName(pluginName) != nullptr);
+				if (!foundPlugins.contains(plugin))
+					foundPlugins.insert_or_assign(plugin, dataHandler->LookupModByName(PluginNames::GetSingleton().GetName(plugin)) != nullptr);
 
-				if (foundPlugins[pluginName] == true)
+				if (foundPlugins[plugin] == true)
 					continue;
 				logger::info("Missing plugin. Removing {}", kv.first);
 			} else {
 				logger::info("Invalid format. Removing {}", kv.first);
 			}
-			ini.DeleteKey("SCROLLS", pluginSource);
+			const auto released = kv.second.starts_with("0x") ? UTIL::lexical_cast_formid(kv.second) : 0x0;
+			ini.DeleteKey("SCROLLS", std::string(pluginSource));
+			if (released != 0x0)
+				FormIDAllocator::GetSingleton().Release(released);
 			++removedEntries;
 		}
 
@@ -798,12 +807,50 @@ namespace SCRIBE
 		}
 	}
 
-	void PatchVanillaScrolls()
+	struct ScrollMatch
 	{
-		auto& ini = SCRIBE::CONFIG::Plugin::GetSingleton();
+		enum class Status : std::uint8_t
+		{
+			kIgnored,
+			kNullEffect,
+			kCandidate
+		};
+
+		Status status = Status::kIgnored;
+		RE::SpellItem* spell = nullptr;
+	};
 
-		bool patchVanilla = ini.GetBoolValue("SETTINGS", "PatchVanillaScrolls");
-		if (!patchVanilla)
+	static ScrollMatch MatchVanillaScroll(const RE::ScrollItem* replacerScroll, const SCRIBE::CACHE::HashToSpell& hashCache)
+	{
+		if (!replacerScroll)
+			return {};
+		if (replacerScroll->effects.size() == 0 || replacerScroll->effects.front() == nullptr)
+			return { ScrollMatch::Status::kNullEffect };
+
+		const auto& forms = SCRIBE::FORMS::GetSingleton();
+		if (replacerScroll->HasKeyword(forms.KywdScrollCustom)                                                // ignore Scribe's scrolls
+			|| !replacerScroll->HasKeyword(forms.KywdVendorItemScroll) || *replacerScroll->GetName() == '\0'  // filter bogus scrolls
+			|| std::string_view(replacerScroll->model.c_str()).contains("Actors\\DLC02"sv))                  // filter Dragonborn spiders which are treated as scroll items
+			return {};
+
+		if (auto it = hashCache.find(SCRIBE::UTIL::GetNameHash(SCRIBE::UTIL::ExtractSpellName(replacerScroll->GetName()))); it != hashCache.end()) {
+			SCRIBE::STATS::RecordCache(SCRIBE::STATS::Cache::kHashToSpellName, true);
+			return { ScrollMatch::Status::kCandidate, it->second };
+		}
+		SCRIBE::STATS::RecordCache(SCRIBE::STATS::Cache::kHashToSpellName, false);
+
+		if (auto it = hashCache.find(SCRIBE::UTIL::GetEffectListHash(replacerScroll->effects)); it != hashCache.end()) {
+			SCRIBE::STATS::RecordCache(SCRIBE::STATS::Cache::kHashToSpellEffect, true);
+			return { ScrollMatch::Status::kCandidate, it->second };
+		}
+		SCRIBE::STATS::RecordCache(SCRIBE::STATS::Cache::kHashToSpellEffect, false);
+		return { ScrollMatch::Status::kCandidate };
+	}
+
+	void PatchVanillaScrolls()
+	{
+		const auto& settings = CONFIG::GetSettings();
+		if (!settings.patchVanillaScrolls)
 			return;
 
 		logger::info("{:*^30}", "PATCHING VANILLA SCROLLS");
@@ -814,77 +861,131 @@ namespace SCRIBE
 			return;
 		}
 
-		bool applyMismatchFix = ini.GetBoolValue("SETTINGS", "ApplyScrollMismatchFix");
+		bool applyMismatchFix = settings.applyScrollMismatchFix;
 
 		size_t formTotal = 0;
 		size_t integratedCount = 0;
 
-		std::vector<RE::TESForm*> missedItems;
+		std::vector<RE::ScrollItem*> missedItems;
 
-		for (auto& replacerScroll : dataHandler->GetFormArray<RE::ScrollItem>()) {
-			if (replacerScroll->effects.size() == 0 || replacerScroll->effects.front() == nullptr) {
-				logger::info("Skipped null-effect scroll {} (0x{:08X})", replacerScroll->GetName(), replacerScroll->GetFormID());
-				continue;
-			}
-			if (replacerScroll && !replacerScroll->HasKeyword(SCRIBE::FORMS::GetSingleton().KywdScrollCustom)                               // ignore Scribe's scrolls
-				&& replacerScroll->HasKeyword(SCRIBE::FORMS::GetSingleton().KywdVendorItemScroll) && strlen(replacerScroll->GetName()) > 0  // filter bogus scrolls
-				&& !std::string(replacerScroll->model.c_str()).contains("Actors\\DLC02")) {                                                 // filter Dragonborn spiders which are treated as scroll items
-
-				std::string logString = std::format("Patched {} (0x{:08X})", replacerScroll->GetFullName(), replacerScroll->GetFormID());
-
-				replacerScroll->AddKeyword(SCRIBE::FORMS::GetSingleton().KywdScrollCustom);
-
-				RE::SpellItem* foundSpell = nullptr;
-				auto nameHash = SCRIBE::UTIL::GetNameHash(SCRIBE::UTIL::ExtractSpellName(replacerScroll->GetName()));
-				if (SCRIBE::CACHE::HashToSpellMap.contains(nameHash)) {
-					foundSpell = SCRIBE::CACHE::HashToSpellMap[nameHash];
-				} else {
-					auto effHash = SCRIBE::UTIL::GetEffectListHash(replacerScroll->effects);
-					if (SCRIBE::CACHE::HashToSpellMap.contains(effHash)) {
-						foundSpell = SCRIBE::CACHE::HashToSpellMap[effHash];
-					}
-				}
+		auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		auto& scrollArray = dataHandler->GetFormArray<RE::ScrollItem>();
 
-				if (foundSpell && SCRIBE::CACHE::SpellScrollBiMap.containsKey(foundSpell)) {
-					logString.append(std::format(" = SPEL {} (0x{:08X})", foundSpell->GetName(), foundSpell->formID));
+		// Classification and spell matching only read forms and the hash cache, so they run in parallel.
+		// Everything that mutates forms or caches happens below, serially and in form-array order.
+		std::vector<ScrollMatch> matches(scrollArray.size());
+		std::transform(std::execution::par, scrollArray.begin(), scrollArray.end(), matches.begin(), [&hashCache = *SCRIBE::CACHE::HashToSpellMap.Load()](const RE::ScrollItem* replacerScroll) {
+			return MatchVanillaScroll(replacerScroll, hashCache);
+		});
 
-					auto oldScroll = SCRIBE::CACHE::SpellScrollBiMap.getValue(foundSpell);
+		const auto integrate = [&](RE::ScrollItem* replacerScroll, CATALOG::ScrollID catalogID, FormBuilder& builder, std::string& logString) {
+			auto foundSpell = catalog.GetSpell(catalogID);
+			logString.append(std::format(" = SPEL {} (0x{:08X})", foundSpell->GetName(), foundSpell->formID));
 
-					SCRIBE::CACHE::SpellScrollBiMap.eraseKey(foundSpell);
-					SCRIBE::CACHE::SpellScrollBiMap.insert(foundSpell, replacerScroll);
+			auto oldScroll = catalog.GetScroll(catalogID);
 
-					for (auto& cobj : SCRIBE::CACHE::SpellScrollCobjMap[foundSpell])
-						cobj->createdItem = replacerScroll;
+			catalog.RebindScroll(catalogID, replacerScroll);
 
-					replacerScroll->weight = oldScroll->weight;
-					replacerScroll->value = oldScroll->value;
+			for (auto& cobj : catalog.GetConstructibles(catalogID))
+				cobj->createdItem = replacerScroll;
 
-					SCRIBE::CACHE::FormIDRelocationBiMap.insert(oldScroll->GetFormID(), replacerScroll->GetFormID());
-					logString.append(std::format(" REL 0x{:08X} => 0x{:08X}", oldScroll->GetFormID(), replacerScroll->GetFormID()));
+			replacerScroll->weight = oldScroll->weight;
+			replacerScroll->value = oldScroll->value;
 
-					SCRIBE::UTIL::AddDisintegrateEffect(replacerScroll);
-					SCRIBE::UTIL::AddTierKeywords(replacerScroll, foundSpell);
-					SCRIBE::UTIL::AddRankKeywords(replacerScroll, foundSpell);
+			SCRIBE::CACHE::FormIDRelocationBiMap.insert(oldScroll->GetFormID(), replacerScroll->GetFormID());
+			logString.append(std::format(" REL 0x{:08X} => 0x{:08X}", oldScroll->GetFormID(), replacerScroll->GetFormID()));
 
-					if (applyMismatchFix)
-						FixScrollSpellMismatch(replacerScroll, foundSpell);
+			SCRIBE::UTIL::AddDisintegrateEffect(builder);
+			SCRIBE::UTIL::AddTierKeywords(builder, catalogID);
+			SCRIBE::UTIL::AddRankKeywords(builder, catalogID);
+			builder.Commit();
 
-					++integratedCount;
+			if (applyMismatchFix)
+				FixScrollSpellMismatch(replacerScroll, foundSpell);
 
-				} else {
-					missedItems.push_back(replacerScroll);
-				}
+			++integratedCount;
+		};
 
-				logger::info("{}", logString);
-				++formTotal;
+		for (std::size_t i = 0; i < matches.size(); i++) {
+			auto& replacerScroll = scrollArray[i];
+			const auto& match = matches[i];
+
+			if (match.status == ScrollMatch::Status::kNullEffect) {
+				logger::info("Skipped null-effect scroll {} (0x{:08X})", replacerScroll->GetName(), replacerScroll->GetFormID());
+				continue;
 			}
+			if (match.status != ScrollMatch::Status::kCandidate)
+				continue;
+
+			std::string logString = std::format("Patched {} (0x{:08X})", replacerScroll->GetFullName(), replacerScroll->GetFormID());
+
+			FormBuilder builder(replacerScroll);
+			builder.AddKeyword(SCRIBE::FORMS::GetSingleton().KywdScrollCustom);
+
+			auto foundSpell = match.spell;
+			auto catalogID = foundSpell ? catalog.FindBySpell(foundSpell) : CATALOG::INVALID_SCROLL_ID;
+			if (catalogID != CATALOG::INVALID_SCROLL_ID) {
+				integrate(replacerScroll, catalogID, builder, logString);
+			} else {
+				builder.Commit();
+				missedItems.push_back(replacerScroll);
+			}
+
+			logger::info("{}", logString);
+			++formTotal;
+		}
+
+		// Fuzzy fallback, only for misses and only after every exact match has claimed its spell.
+		if (settings.fuzzyMatchScrolls && !missedItems.empty()) {
+			QUERY::FuzzySpellMatcher matcher;
+			matcher.Build(catalog);
+
+			std::erase_if(missedItems, [&](RE::ScrollItem* replacerScroll) {
+				const auto match = matcher.Find(replacerScroll);
+				SCRIBE::STATS::RecordCache(SCRIBE::STATS::Cache::kFuzzySpellMatch, match.id != CATALOG::INVALID_SCROLL_ID);
+				if (match.id == CATALOG::INVALID_SCROLL_ID)
+					return false;
+
+				std::string logString = std::format("Fuzzy-patched {} (0x{:08X}) with score {:.2f}", replacerScroll->GetFullName(), replacerScroll->GetFormID(), match.score);
+				FormBuilder builder(replacerScroll);
+				integrate(replacerScroll, match.id, builder, logString);
+				logger::info("{}", logString);
+				return true;
+			});
 		}
+
 		for (auto& ele : missedItems)
 			logger::info("Skipped {} (0x{:08X})", ele->GetName(), ele->formID);
 
 		logger::info("Successfully patched {} scrolls. Integrated {} into Scribe's cache.\n", formTotal, integratedCount);
 	}
 
+	// Whether an exported scroll's recipes still ask for the dust this boot computed for its tome.
+	static bool HasCurrentDust(const std::vector<RE::BGSConstructibleObject*>& cobjList, const CATALOG::ScrollFacts& facts, bool with10x)
+	{
+		std::vector<std::int32_t> expected{ facts.baseDust, facts.reducedDust };
+		if (with10x) {
+			expected.push_back(facts.baseDust * 10);
+			expected.push_back(facts.reducedDust * 10);
+		}
+
+		const auto dust = FORMS::GetSingleton().MiscArcaneDust;
+		std::vector<std::int32_t> actual;
+		for (const auto cobj : cobjList) {
+			const auto& items = cobj->requiredItems;
+			std::int32_t count = 0;
+			for (std::uint32_t i = 0; i < items.numContainerObjects; i++) {
+				if (items.containerObjects[i]->obj == dust)
+					count += items.containerObjects[i]->count;
+			}
+			actual.push_back(count);
+		}
+
+		std::ranges::sort(expected);
+		std::ranges::sort(actual);
+		return expected == actual;
+	}
+
 	void GenerateDynamicScrolls()
 	{
 		logger::info("{:*^30}", "PROCESSING SPELL TOMES");
@@ -903,13 +1004,45 @@ namespace SCRIBE
 
 		std::vector<RE::BGSConstructibleObject*> generatedConstructibles;
 		std::vector<RE::ScrollItem*> generatedScrolls;
+		std::vector<std::pair<FormKey, RE::TESObjectBOOK*>> generatedBookKeys;
 
 		auto& ini = SCRIBE::CONFIG::Plugin::GetSingleton();
-		auto modChargeTime = ini.GetBoolValue("SETTINGS", "ModSpellChargingTime");
+		auto modChargeTime = CONFIG::GetSettings().modSpellChargingTime;
 
 		size_t processedEntries = 0;
 		bool updateFile = !FORMS::GetSingleton().GetUseOffset();
 
+		// Collect every persisted target up front so the planner can order the moves before any form exists.
+		FormIDPlanner planner(updateFile);
+		std::unordered_map<FormKey, RE::FormID> persistedScrollIDs;
+		for (const auto& [key, value] : ini.GetAllKeyValuePairs("SCROLLS")) {
+			auto formID = UTIL::lexical_cast_formid(value);
+			if (auto bookKey = ParseFormKey(key); bookKey != INVALID_FORM_KEY)
+				persistedScrollIDs.insert_or_assign(bookKey, formID);
+			planner.Reserve(formID);
+		}
+		for (const auto& [key, value] : ini.GetAllKeyValuePairs("FUSION"))
+			planner.Reserve(UTIL::lexical_cast_formid(key));
+		for (const auto& [key, value] : ini.GetAllKeyValuePairs("FUSIONIDS"))
+			planner.Reserve(UTIL::lexical_cast_formid(key));
+
+		auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+		catalog.Reserve(dataHandler->GetFormArray<RE::TESObjectBOOK>().size());
+
+		// Pass 1: collect every tome that teaches a usable spell. Optionally, tomes teaching a spell that already has
+		// a tome (or an equivalent spell) become aliases of that tome instead of getting a scroll of their own.
+		const bool dedupEquivalent = CONFIG::GetSettings().deduplicateEquivalentSpells;
+		const bool dedupSpellTomes = CONFIG::GetSettings().deduplicateSpellTomes || dedupEquivalent;
+		auto& filter = GenerationFilter::GetSingleton();
+		filter.ResetCounts();
+		std::vector<CATALOG::ScrollFacts> tomes;
+		tomes.reserve(dataHandler->GetFormArray<RE::TESObjectBOOK>().size());
+		std::unordered_map<const RE::SpellItem*, std::size_t> tomeBySpell;
+		std::unordered_map<std::string, std::size_t> tomeBySignature;
+		using AliasTome = std::pair<std::size_t, RE::TESObjectBOOK*>;  // primary tome index, alias tome
+		std::vector<AliasTome> aliasTomes;
+		std::size_t duplicateSpells = 0;
+		std::size_t equivalentSpells = 0;
 		for (auto& book : dataHandler->GetFormArray<RE::TESObjectBOOK>()) {
 			//logger::info("{} (0x{:08X})", book->fullName.c_str(), book->formID);
 			if (!book || !book->TeachesSpell() || book->GetSpell() == nullptr) {
@@ -927,24 +1060,164 @@ namespace SCRIBE
 				//logger::info("Skipped null-effect spell {} (0x{:08X})", theSpell->GetName(), theSpell->GetFormID());
 				continue;
 			}
-			
+
+			if (!filter.Accepts(book, theSpell))
+				continue;
+
+			if (auto it = tomeBySpell.find(theSpell); dedupSpellTomes && it != tomeBySpell.end()) {
+				aliasTomes.emplace_back(it->second, book);
+				++duplicateSpells;
+				continue;
+			}
+			if (dedupEquivalent) {
+				const auto [it, inserted] = tomeBySignature.try_emplace(UTIL::GetEffectSignature(theSpell), tomes.size());
+				if (!inserted) {
+					logger::info("{} (0x{:08X}) is equivalent to {} (0x{:08X})", theSpell->GetName(), theSpell->GetFormID(), tomes[it->second].spell->GetName(), tomes[it->second].spell->GetFormID());
+					tomeBySpell.insert_or_assign(theSpell, it->second);
+					aliasTomes.emplace_back(it->second, book);
+					++equivalentSpells;
+					continue;
+				}
+			}
+
+			tomeBySpell.insert_or_assign(theSpell, tomes.size());
+			tomes.push_back(SCRIBE::UTIL::GetScrollFacts(book, theSpell));
+		}
+
+		// Pass 2: dust costs and tiers for all tomes in one batch.
+		const auto tomeCount = tomes.size();
+		std::vector<std::int32_t> inRank(tomeCount), inLevel(tomeCount);
+		std::vector<float> inCostliest(tomeCount), inOverride(tomeCount);
+		std::vector<std::uint8_t> inConcentration(tomeCount);
+		for (std::size_t i = 0; i < tomeCount; i++) {
+			const auto& facts = tomes[i];
+			inRank[i] = facts.rank;
+			inLevel[i] = facts.level;
+			inCostliest[i] = facts.spell->GetCostliestEffectItem()->cost;
+			inOverride[i] = static_cast<float>(facts.spell->data.costOverride);
+			inConcentration[i] = facts.concentration ? 1 : 0;
+		}
+
+		std::vector<std::int32_t> outBaseDust(tomeCount), outReducedDust(tomeCount);
+		std::vector<std::uint8_t> outTier(tomeCount), outFilter(tomeCount);
+		KERNEL::ClassifyBatch({ inRank, inLevel, inCostliest, inOverride, inConcentration }, { outBaseDust, outReducedDust, outTier, outFilter });
+
+		// Pass 3: build the scroll forms, or reuse the exported plugin's where it has one.
+		const ESP::ExportedPlugin exported;
+		const auto recipesPerScroll = CONFIG::GetSettings().generate10xRecipes ? 4u : 2u;
+		std::size_t reusedScrolls = 0;
+		std::size_t staleExports = 0;
+		std::unordered_set<FormKey> acceptedBookKeys;
+
+		// Aliases are registered as soon as their primary tome has an entry, so its recipes accept the alias spells too.
+		// Aliases of tier-filtered tomes are never registered.
+		std::ranges::stable_sort(aliasTomes, {}, &AliasTome::first);
+		std::size_t registeredAliases = 0;
+		const auto addAliases = [&](std::size_t tome, CATALOG::ScrollID catalogID) {
+			for (const auto& [primary, aliasBook] : std::ranges::equal_range(aliasTomes, tome, {}, &AliasTome::first)) {
+				catalog.AddAlias(catalogID, aliasBook, aliasBook->GetSpell());
+				++registeredAliases;
+			}
+		};
+
+		// Saves made before an alias tome was deduplicated hold its own scroll. It keeps its [SCROLLS] ID as a copy
+		// of the shared scroll without recipes, resolving to the shared entry. Call once the shared scroll is built.
+		std::size_t keptAliasScrolls = 0;
+		const auto keepAliasScrolls = [&](std::size_t tome, CATALOG::ScrollID catalogID) {
+			const auto shared = catalog.GetScroll(catalogID);
+			for (const auto& [primary, aliasBook] : std::ranges::equal_range(aliasTomes, tome, {}, &AliasTome::first)) {
+				const auto aliasKey = GetFormKey(aliasBook);
+				const auto persisted = persistedScrollIDs.find(aliasKey);
+				if (persisted == persistedScrollIDs.end())
+					continue;
+
+				auto legacyScroll = scrollFactory->Create();
+				legacyScroll->fullName = shared->fullName;
+				legacyScroll->weight = shared->weight;
+				legacyScroll->value = shared->value;
+				legacyScroll->SpellItem::data = shared->SpellItem::data;
+				legacyScroll->model = shared->model;
+				legacyScroll->menuDispObject = shared->menuDispObject;
+				legacyScroll->SetEquipSlot(shared->GetEquipSlot());
+
+				FormBuilder builder(legacyScroll);
+				builder.AddKeywords(shared);
+				builder.AddEffects(shared->effects);
+				builder.Commit();
+
+				catalog.AddLegacyScroll(catalogID, legacyScroll);
+				planner.Assign(legacyScroll, persisted->second);
+				generatedScrolls.push_back(legacyScroll);
+				generatedBookKeys.emplace_back(aliasKey, aliasBook);
+				logger::info("Kept 0x{:08X} of {} (0x{:08X}) as a copy of {}", persisted->second, aliasBook->GetName(), aliasBook->GetFormID(), shared->GetName());
+				++keptAliasScrolls;
+			}
+		};
+		for (std::size_t i = 0; i < tomeCount; i++) {
+			if (!filter.AcceptsTier(static_cast<CATALOG::Tier>(outTier[i])))
+				continue;
+
+			auto& facts = tomes[i];
+			auto book = facts.book;
+			auto theSpell = facts.spell;
+			auto bookKey = GetFormKey(book);
+			acceptedBookKeys.insert(bookKey);
+
 			logger::info("{} (0x{:08X}) = SPEL 0x{:08X}", book->fullName.c_str(), book->formID, theSpell->formID);
 
+			facts.baseDust = outBaseDust[i];
+			facts.reducedDust = outReducedDust[i];
+			facts.tier = static_cast<CATALOG::Tier>(outTier[i]);
+
+			if (auto exportedScroll = exported.IsLoaded() ? exported.FindScroll(bookKey) : nullptr) {
+				SCRIBE::CACHE::AddKeywordSpellCache(theSpell);
+				SCRIBE::CACHE::AddNameAndEffectHashedSpell(theSpell);
+
+				facts.scroll = exportedScroll;
+				auto catalogID = catalog.Add(facts);
+				addAliases(i, catalogID);
+
+				// The plugin stores effects without their conditions; share the spell's effects as generated scrolls do.
+				FormBuilder builder(exportedScroll);
+				builder.ClearEffects();
+				builder.AddEffects(theSpell->effects);
+				SCRIBE::UTIL::AddDisintegrateEffect(builder);
+				builder.Commit();
+
+				// ModSpellChargingTime may have changed since the export; apply it as the generated path does.
+				const auto chargeTime = modChargeTime && facts.concentration ? 0.0f : theSpell->data.chargeTime;
+
+				auto cobjList = exported.GetConstructibles(exportedScroll);
+				if (exportedScroll->value != facts.baseDust || exportedScroll->SpellItem::data.chargeTime != chargeTime || cobjList.size() != recipesPerScroll || !HasCurrentDust(cobjList, facts, recipesPerScroll == 4))
+					++staleExports;
+				exportedScroll->value = facts.baseDust;
+				exportedScroll->SpellItem::data.chargeTime = chargeTime;
+				catalog.SetConstructibles(catalogID, cobjList);
+				keepAliasScrolls(i, catalogID);
+
+				++reusedScrolls;
+				++processedEntries;
+				continue;
+			}
+			if (exported.IsLoaded())
+				++staleExports;
+
 			auto scrollObj = scrollFactory->Create();
 
 			SCRIBE::CACHE::AddKeywordSpellCache(theSpell);
 			SCRIBE::CACHE::AddNameAndEffectHashedSpell(theSpell);
 
-			auto spellRank = SCRIBE::UTIL::GetSpellRank(theSpell);
-			auto isConcentration = SCRIBE::UTIL::IsConcentrationSpell(theSpell);
+			facts.scroll = scrollObj;
+			auto isConcentration = facts.concentration;
 
 			auto fullScrollName = std::format("Scroll of {}", theSpell->GetFullName());
 
-			scrollObj->AddKeyword(SCRIBE::FORMS::GetSingleton().KywdVendorItemScroll);
-			scrollObj->AddKeyword(SCRIBE::FORMS::GetSingleton().KywdScrollCustom);
+			FormBuilder builder(scrollObj);
+			builder.AddKeyword(SCRIBE::FORMS::GetSingleton().KywdVendorItemScroll);
+			builder.AddKeyword(SCRIBE::FORMS::GetSingleton().KywdScrollCustom);
 			if (isConcentration) {
 				fullScrollName.append(" - Concentration");
-				scrollObj->AddKeyword(SCRIBE::FORMS::GetSingleton().KywdKeywordScrollConcentration);
+				builder.AddKeyword(SCRIBE::FORMS::GetSingleton().KywdKeywordScrollConcentration);
 			}
 
 			scrollObj->fullName = fullScrollName;
@@ -955,8 +1228,7 @@ namespace SCRIBE
 			scrollObj->menuDispObject = RE::TESForm::LookupByID<RE::TESBoundObject>(0x76e8f);
 			scrollObj->SetEquipSlot(SCRIBE::FORMS::GetSingleton().EquipSlotEither);
 
-			for (auto& eff : theSpell->effects)
-				scrollObj->effects.emplace_back(eff);
+			builder.AddEffects(theSpell->effects);
 
 			if (modChargeTime && isConcentration) {
 				//for (auto& eff : scrollObj->effects)
@@ -964,63 +1236,67 @@ namespace SCRIBE
 				scrollObj->SpellItem::data.chargeTime = 0.0f;
 			}
 
-			SCRIBE::CACHE::BookSpellBiMap.insert(book, theSpell);
-			SCRIBE::CACHE::SpellScrollBiMap.insert(theSpell, scrollObj);
-
-			SCRIBE::UTIL::AddDisintegrateEffect(scrollObj);
-			SCRIBE::UTIL::AddTierKeywords(scrollObj, theSpell);
-			SCRIBE::UTIL::AddRankKeywords(scrollObj, theSpell);
-
-			int baseDustCost = std::max<int>(spellRank * 5, SCRIBE::UTIL::GetSpellLevelApprox(theSpell)) + static_cast<int>(std::max<float>(std::min<float>(theSpell->GetCostliestEffectItem()->cost, 500), static_cast<float>(theSpell->data.costOverride)));
-			baseDustCost = max(baseDustCost / 4, 5);
-			if (isConcentration)
-				baseDustCost *= 2;
-			int reducedDustCost = max((baseDustCost * 66) / 100, 5);
-
-			scrollObj->value = baseDustCost;
-
-			auto bookFormID = std::format("{}~0x{:08X}", book->GetFile(0)->GetFilename(), book->GetLocalFormID());
-			if (ini.HasKey("SCROLLS", bookFormID)) {
-				std::string logString = "Found ID in INI...";
-
-				auto assignedScrollFormID = UTIL::lexical_cast_formid(ini.GetValue("SCROLLS", bookFormID));
-				if (scrollObj->GetFormID() != assignedScrollFormID) {
-					logString.append(std::format("Overwrite with 0x{:08X}...", assignedScrollFormID));
-					if (auto existingEntry = RE::TESForm::LookupByID<RE::TESForm>(assignedScrollFormID); existingEntry != nullptr && existingEntry->GetFormID() != scrollObj->formID) {
-						logString.append(std::format("ID IN USE BY {} ({})! Swapping...", existingEntry->GetName(), RE::FormTypeToString(existingEntry->GetFormType())));
-						{
-							existingEntry->SetFormID(scrollObj->formID, updateFile);
-							scrollObj->SetFormID(assignedScrollFormID, updateFile);
-						}
-					} else {
-						scrollObj->SetFormID(assignedScrollFormID, updateFile);
-					}
-				}
+			auto catalogID = catalog.Add(facts);
+			addAliases(i, catalogID);
 
-				logger::info("{}", logString);
-			} else {
-				if (FORMS::GetSingleton().GetUseOffset())
-					scrollObj->SetFormID(FORMS::GetSingleton().NextFormID(), updateFile);
+			SCRIBE::UTIL::AddDisintegrateEffect(builder);
+			SCRIBE::UTIL::AddTierKeywords(builder, catalogID);
+			SCRIBE::UTIL::AddRankKeywords(builder, catalogID);
+			builder.Commit();
+
+			scrollObj->value = facts.baseDust;
+			keepAliasScrolls(i, catalogID);
+
+			if (auto it = persistedScrollIDs.find(bookKey); it != persistedScrollIDs.end()) {
+				logger::info("Found ID in INI... Planned 0x{:08X}", it->second);
+				planner.Assign(scrollObj, it->second);
+			} else if (FORMS::GetSingleton().GetUseOffset()) {
+				planner.AssignFresh(scrollObj);
 			}
 
 			generatedScrolls.push_back(scrollObj);
-			auto cobjList = SCRIBE::UTIL::GetConstructibleObjectForScroll({ scrollObj, theSpell, baseDustCost, reducedDustCost });
+			generatedBookKeys.emplace_back(bookKey, book);
+			auto cobjList = SCRIBE::UTIL::GetConstructibleObjectForScroll(catalogID);
 			for (auto& cobj : cobjList)
 				generatedConstructibles.push_back(cobj);
 
-			SCRIBE::CACHE::SpellScrollCobjMap.insert_or_assign(theSpell, cobjList);
+			catalog.SetConstructibles(catalogID, cobjList);
+
+			++processedEntries;
+		}
+
+		if (!aliasTomes.empty()) {
+			logger::info("Deduplication: {} tomes with an already seen spell, {} with an equivalent spell; {} share a generated scroll, saving as many scrolls and {} recipes",
+				duplicateSpells,
+				equivalentSpells,
+				registeredAliases,
+				registeredAliases * recipesPerScroll);
+			if (keptAliasScrolls > 0)
+				logger::info("Kept {} scrolls of deduplicated tomes for existing saves", keptAliasScrolls);
+		}
+
+		planner.Commit();
+		SCRIBE::CACHE::PublishSpellCaches();
 
-			auto rightHandSide = std::format("0x{:08X}", scrollObj->GetFormID());
+		for (std::size_t i = 0; i < generatedScrolls.size(); i++) {
+			const auto& scrollObj = generatedScrolls[i];
+			const auto& [bookKey, book] = generatedBookKeys[i];
 
 			ini.SetValue("SCROLLS",
-				bookFormID,
-				rightHandSide,
+				FormatFormKey(bookKey),
+				std::format("0x{:08X}", scrollObj->GetFormID()),
 				std::format("# {}", book->GetName()));
 
 			logger::info("Generated Scroll {} (0x{:08X})", scrollObj->GetName(), scrollObj->GetFormID());
-			++processedEntries;
 		}
 
+		// Exported tomes that were not generated this boot would keep their scroll and recipes in the plugin.
+		if (exported.IsLoaded())
+			staleExports += exported.CountUnclaimed(acceptedBookKeys);
+
+		filter.LogCounts();
+		if (exported.IsLoaded())
+			logger::info("Reused {} scrolls from {}; {} tomes changed since it was exported", reusedScrolls, ESP::EXPORT_PLUGIN_NAME, staleExports);
 		logger::info("Successfully processed {} Spell Tomes.\n\n", processedEntries);
 
 		std::ranges::copy(generatedConstructibles, std::back_inserter(dataHandler->GetFormArray<RE::BGSConstructibleObject>()));
@@ -1028,9 +1304,22 @@ namespace SCRIBE
 
 		std::ranges::copy(generatedScrolls, std::back_inserter(dataHandler->GetFormArray<RE::ScrollItem>()));
 		generatedScrolls.clear();
+
+		if (CONFIG::GetSettings().exportGeneratedPlugin && (!exported.IsLoaded() || staleExports > 0))
+			ESP::ExportGeneratedForms();
 	}
 }
 
+static std::string_view GetSaveName(const SKSE::MessagingInterface::Message* a_msg)
+{
+	if (!a_msg->data)
+		return {};
+	std::string_view name(static_cast<const char*>(a_msg->data), a_msg->dataLen);
+	if (auto end = name.find('\0'); end != std::string_view::npos)
+		name = name.substr(0, end);
+	return name;
+}
+
 void OnInit(SKSE::MessagingInterface::Message* const a_msg)
 {
 	switch (a_msg->type) {
@@ -1040,14 +1329,42 @@ void OnInit(SKSE::MessagingInterface::Message* const a_msg)
 		SCRIBE::LoadFormIDOffset();
 		SCRIBE::VerifyConfiguration();
 		SCRIBE::PerformIniMigrations();
+		SCRIBE::PerkRankTable::GetSingleton().Load();
+		SCRIBE::GenerationFilter::GetSingleton().Load();
+		if (SCRIBE::CONFIG::GetSettings().traceNativeCalls) {
+			if (auto path = SKSE::log::log_directory())
+				SCRIBE::TRACE::Recorder::GetSingleton().Start(*path / "ScrollScribeNG.trace");
+		}
 		//SCRIBE::PerformCleanup();
 		SCRIBE::GenerateDynamicScrolls();
+		SCRIBE::VerifyPrebakedCatalog();
 		SCRIBE::PatchVanillaScrolls();
+		SCRIBE::QUERY::ScrollIndex::GetSingleton().Build();
+		SCRIBE::SetupZeroCostPool();
 		SCRIBE::PatchSoulGemFormList();
-		SCRIBE::LoadFused();
+		SCRIBE::ScrollCastQueue::GetSingleton().SetInterval(std::chrono::milliseconds(SCRIBE::CONFIG::GetSettings().scrollCastBatchInterval));
+		if (SCRIBE::CONFIG::GetSettings().restoreLegacyFusions)
+			SCRIBE::FusionRegistry::GetSingleton().LoadLegacy();
+		break;
+	case SKSE::MessagingInterface::kPreLoadGame:
+		// Fused products must exist before the engine reads the inventories that hold them; the co-save's
+		// load callback runs too late for that, so they are rebuilt from the save's index here.
+		SCRIBE::FusionRegistry::GetSingleton().BeginLoad(GetSaveName(a_msg));
+		break;
+	case SKSE::MessagingInterface::kPostLoadGame:
+		SCRIBE::FusionRegistry::GetSingleton().EndLoad();
+		break;
+	case SKSE::MessagingInterface::kNewGame:
+		SCRIBE::FusionRegistry::GetSingleton().Reset();
+		SCRIBE::TRACE::Recorder::GetSingleton().Flush();
 		break;
 	case SKSE::MessagingInterface::kSaveGame:
+		SCRIBE::FusionRegistry::GetSingleton().SetSaveName(GetSaveName(a_msg));
 		SCRIBE::CONFIG::Plugin::GetSingleton().Save();
+		SCRIBE::TRACE::Recorder::GetSingleton().Flush();
+		break;
+	case SKSE::MessagingInterface::kDeleteGame:
+		SCRIBE::FusionRegistry::DeleteIndex(GetSaveName(a_msg));
 		break;
 	default:
 		break;
@@ -1060,7 +1377,12 @@ public:
 	virtual RE::BSEventNotifyControl ProcessEvent(const RE::TESSpellCastEvent* a_event, RE::BSTEventSource<RE::TESSpellCastEvent>*)
 	{
 		auto castForm = RE::TESForm::LookupByID<RE::TESForm>(a_event->spell);
-		if (auto scrollForm = castForm->As<RE::ScrollItem>(); scrollForm != nullptr) {
+		if (auto scrollForm = castForm ? castForm->As<RE::ScrollItem>() : nullptr; scrollForm != nullptr) {
+			if (SCRIBE::CONFIG::GetSettings().coalesceScrollCasts) {
+				SCRIBE::ScrollCastQueue::GetSingleton().Push(scrollForm->GetFormID(), a_event->object ? a_event->object->GetFormID() : 0x0);
+				return RE::BSEventNotifyControl::kContinue;
+			}
+
 			SKSE::ModCallbackEvent myEvent{ scrollForm->SpellItem::data.castingType == RE::MagicSystem::CastingType::kConcentration ? "ConcScrollCast" : "FFScrollCast" };
 			myEvent.sender = scrollForm;  //RE::TESForm::LookupByID<RE::TESForm>(a_event->spell);
 			myEvent.strArg = std::format("{:x}", a_event->object->GetFormID());
@@ -1083,6 +1405,12 @@ bool Load()
 
 	SKSE::GetPapyrusInterface()->Register(SCRIBE::BindPapyrusFunctions);
 
+	const auto serialization = SKSE::GetSerializationInterface();
+	serialization->SetUniqueID(SCRIBE::FusionRegistry::SERIALIZATION_ID);
+	serialization->SetSaveCallback(SCRIBE::FusionRegistry::OnSave);
+	serialization->SetLoadCallback(SCRIBE::FusionRegistry::OnLoad);
+	serialization->SetRevertCallback(SCRIBE::FusionRegistry::OnRevert);
+
 	auto& eventProcessor = ScrollSpellCastEventHandler::GetSingleton();
 	RE::ScriptEventSourceHolder::GetSingleton()->AddEventSink<RE::TESSpellCastEvent>(&eventProcessor);
 	return true;
@@ -2,16 +2,17 @@
 
 namespace SCRIBE
 {
-	constexpr uint32_t INI_VERSION = 3;
+	constexpr uint32_t INI_VERSION = 4;
 
 	void VerifyConfiguration();
 	void GenerateDynamicScrolls();
-	void LoadFused();
+	void VerifyPrebakedCatalog();
 	void PatchVanillaScrolls();
 	void PerformCleanup();
 	void PatchSoulGemFormList();
 	void PerformIniMigrations();
 	void LoadFormIDOffset();
+	void SetupZeroCostPool();
 	
 	bool			BindPapyrusFunctions(RE::BSScript::IVirtualMachine*);
 	RE::ScrollItem* FuseAndCreateFunc(RE::ScrollItem* scrollOne, RE::ScrollItem* scrollTwo);
@@ -23,6 +24,11 @@ namespace SCRIBE
 	void			OverrideSpell(RE::StaticFunctionTag*, RE::SpellItem*, RE::SpellItem*);
 	RE::SpellItem*	GetZeroCostCopy(RE::StaticFunctionTag*, RE::SpellItem*);
 	int				GetApproxFullGoldValue(RE::StaticFunctionTag*, RE::TESForm*);
+	std::vector<std::int32_t> GetApproxFullGoldValues(RE::StaticFunctionTag*, std::vector<RE::TESForm*> forms);
+	std::int32_t	GetInventoryGoldValue(RE::StaticFunctionTag*, RE::TESObjectREFR* container);
 	RE::SpellItem*	GetUpgradedSpell(RE::StaticFunctionTag*, RE::SpellItem* spell);
 	RE::ScrollItem* GetScrollFromSpell(RE::StaticFunctionTag*, RE::SpellItem* spell);
+	std::vector<RE::TESForm*> DrainScrollCasts(RE::StaticFunctionTag*, int32_t maxCount);
+	std::vector<std::string> GetScribeStats(RE::StaticFunctionTag*, bool writeToLog);
+	std::vector<RE::ScrollItem*> FindScrolls(RE::StaticFunctionTag*, int32_t school, int32_t minTier, int32_t maxTier, int32_t castingType, RE::BGSKeyword* keyword, int32_t offset, int32_t count);
 }
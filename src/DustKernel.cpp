@@ -0,0 +1,59 @@
+#include "DustKernel.h"
+
+namespace SCRIBE
+{
+	namespace KERNEL
+	{
+		void ClassifyBatch(const DustInputs& in, const DustOutputs& out)
+		{
+			const auto count = in.rank.size();
+
+			const auto* const rank = in.rank.data();
+			const auto* const level = in.level.data();
+			const auto* const costliestCost = in.costliestCost.data();
+			const auto* const costOverride = in.costOverride.data();
+			const auto* const concentration = in.concentration.data();
+			auto* const baseDust = out.baseDust.data();
+			auto* const reducedDust = out.reducedDust.data();
+			auto* const tier = out.tier.data();
+			auto* const filterIndex = out.filterIndex.data();
+
+			for (std::size_t i = 0; i < count; i++) {
+				const float capped = costliestCost[i] > 500.0f ? 500.0f : costliestCost[i];
+				const float effectCost = capped < costOverride[i] ? costOverride[i] : capped;
+				const std::int32_t rankCost = rank[i] * 5;
+				const std::int32_t levelCost = rankCost < level[i] ? level[i] : rankCost;
+
+				std::int32_t dust = (levelCost + static_cast<std::int32_t>(effectCost)) / 4;
+				dust = dust < 5 ? 5 : dust;
+				dust *= 1 + static_cast<std::int32_t>(concentration[i] != 0);
+				baseDust[i] = dust;
+
+				const std::int32_t reduced = (dust * 66) / 100;
+				reducedDust[i] = reduced < 5 ? 5 : reduced;
+			}
+
+			for (std::size_t i = 0; i < count; i++) {
+				const auto t = static_cast<std::uint8_t>((level[i] >= 25) + (level[i] >= 50) + (level[i] >= 75) + (level[i] >= 100));
+				tier[i] = t;
+				filterIndex[i] = rank[i] == 0 ? FILTER_STRANGE : t;
+			}
+		}
+
+		void ClassifyScalar(const DustInputs& in, const DustOutputs& out)
+		{
+			for (std::size_t i = 0; i < in.rank.size(); i++) {
+				int baseDustCost = std::max<int>(in.rank[i] * 5, in.level[i]) + static_cast<int>(std::max<float>(std::min<float>(in.costliestCost[i], 500), in.costOverride[i]));
+				baseDustCost = std::max<int>(baseDustCost / 4, 5);
+				if (in.concentration[i])
+					baseDustCost *= 2;
+				int reducedDustCost = std::max<int>((baseDustCost * 66) / 100, 5);
+
+				out.baseDust[i] = baseDustCost;
+				out.reducedDust[i] = reducedDustCost;
+				out.tier[i] = GetTierIndex(in.level[i]);
+				out.filterIndex[i] = in.rank[i] == 0 ? FILTER_STRANGE : out.tier[i];
+			}
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace KERNEL
+	{
+		constexpr std::uint8_t FILTER_STRANGE = 5;  // filter-global index past the five tiers
+
+		// CATALOG::Tier index for a spell level: Novice below 25, then one tier per 25 levels up to Master at 100.
+		constexpr std::uint8_t GetTierIndex(std::int32_t spellLevel)
+		{
+			if (spellLevel < 25)
+				return 0;
+			if (spellLevel < 50)
+				return 1;
+			if (spellLevel < 75)
+				return 2;
+			if (spellLevel < 100)
+				return 3;
+			return 4;
+		}
+
+		// Structure-of-arrays spell inputs; every span must have the same length.
+		struct DustInputs
+		{
+			std::span<const std::int32_t> rank;
+			std::span<const std::int32_t> level;
+			std::span<const float> costliestCost;
+			std::span<const float> costOverride;
+			std::span<const std::uint8_t> concentration;
+		};
+
+		struct DustOutputs
+		{
+			std::span<std::int32_t> baseDust;
+			std::span<std::int32_t> reducedDust;
+			std::span<std::uint8_t> tier;
+			std::span<std::uint8_t> filterIndex;
+		};
+
+		// Branch-free batch pass over all tomes; written so the compiler can vectorize each loop.
+		void ClassifyBatch(const DustInputs& in, const DustOutputs& out);
+
+		// Per-spell reference implementation of the same formulas; tools/Tests checks both against golden values.
+		// Neither pass touches game types, so the prebake tool and the host tests link this file as is.
+		void ClassifyScalar(const DustInputs& in, const DustOutputs& out);
+	}
+}
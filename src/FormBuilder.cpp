@@ -0,0 +1,91 @@
+#include "FormBuilder.h"
+
+namespace SCRIBE
+{
+	FormBuilder::FormBuilder(RE::MagicItem* form) :
+		form(form)
+	{
+		keywords.reserve(form->GetNumKeywords() + 8);
+		for (std::uint32_t i = 0; i < form->GetNumKeywords(); i++)
+			if (auto kwd = form->GetKeywordAt(i); kwd.has_value() && kwd.value())
+				keywords.push_back(kwd.value());
+
+		effects.reserve(form->effects.size() + 4);
+		for (auto eff : form->effects)
+			effects.push_back(eff);
+	}
+
+	bool FormBuilder::HasKeyword(const RE::BGSKeyword* keyword) const
+	{
+		return std::ranges::find(keywords, keyword) != keywords.end();
+	}
+
+	bool FormBuilder::HasEffect(const RE::Effect* effect) const
+	{
+		return std::ranges::find(effects, effect) != effects.end();
+	}
+
+	void FormBuilder::AddKeyword(RE::BGSKeyword* keyword)
+	{
+		if (!keyword || HasKeyword(keyword))
+			return;
+		keywords.push_back(keyword);
+		keywordsChanged = true;
+	}
+
+	void FormBuilder::AddKeywords(const RE::BGSKeywordForm* source)
+	{
+		if (!source)
+			return;
+		for (std::uint32_t i = 0; i < source->GetNumKeywords(); i++)
+			if (auto kwd = source->GetKeywordAt(i); kwd.has_value())
+				AddKeyword(kwd.value());
+	}
+
+	void FormBuilder::ClearKeywords()
+	{
+		keywordsChanged = keywordsChanged || !keywords.empty();
+		keywords.clear();
+	}
+
+	void FormBuilder::AddEffect(RE::Effect* effect)
+	{
+		effects.push_back(effect);
+		effectsChanged = true;
+	}
+
+	void FormBuilder::AddEffects(const RE::BSTArray<RE::Effect*>& source)
+	{
+		effects.reserve(effects.size() + source.size());
+		for (auto eff : source)
+			effects.push_back(eff);
+		effectsChanged = effectsChanged || !source.empty();
+	}
+
+	void FormBuilder::ClearEffects()
+	{
+		effectsChanged = effectsChanged || !effects.empty();
+		effects.clear();
+	}
+
+	void FormBuilder::Commit()
+	{
+		if (keywordsChanged) {
+			auto newKeywords = keywords.empty() ? nullptr : RE::calloc<RE::BGSKeyword*>(keywords.size());
+			std::ranges::copy(keywords, newKeywords);
+			if (form->keywords)
+				RE::free(form->keywords);
+			form->keywords = newKeywords;
+			form->numKeywords = static_cast<std::uint32_t>(keywords.size());
+			keywordsChanged = false;
+		}
+
+		if (effectsChanged) {
+			form->effects.clear();
+			form->effects.reserve(static_cast<std::uint32_t>(effects.size()));
+			for (auto eff : effects)
+				form->effects.push_back(eff);
+			effectsChanged = false;
+		}
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace SCRIBE
+{
+	// Collects the final keyword set and effect list of a magic item, then writes each array once at its exact size.
+	// Adding keywords one at a time reallocates the engine's keyword array on every call.
+	// Keywords are deduplicated; effects are kept as added, so a fusion carries every effect of both parents.
+	class FormBuilder
+	{
+	public:
+		// Starts from the form's current keywords and effects.
+		explicit FormBuilder(RE::MagicItem* form);
+
+		RE::MagicItem* GetForm() const { return form; }
+		const std::vector<RE::Effect*>& GetEffects() const { return effects; }
+
+		bool HasKeyword(const RE::BGSKeyword* keyword) const;
+		bool HasEffect(const RE::Effect* effect) const;
+
+		void AddKeyword(RE::BGSKeyword* keyword);
+		void AddKeywords(const RE::BGSKeywordForm* source);
+		void ClearKeywords();
+
+		void AddEffect(RE::Effect* effect);
+		void AddEffects(const RE::BSTArray<RE::Effect*>& source);
+		void ClearEffects();
+
+		// Writes only the arrays that changed.
+		void Commit();
+
+	private:
+		RE::MagicItem* form;
+		std::vector<RE::BGSKeyword*> keywords;
+		std::vector<RE::Effect*> effects;
+		bool keywordsChanged = false;
+		bool effectsChanged = false;
+	};
+}
@@ -0,0 +1,95 @@
+#include "FormIDAllocator.h"
+
+namespace SCRIBE
+{
+	void FormIDAllocator::Seed(std::span<const RE::FormID> recorded)
+	{
+		std::vector<bool> occupied(CAPACITY, false);
+		std::uint32_t highest = 0;
+		for (auto formID : recorded) {
+			if (!InRange(formID))
+				continue;
+			const auto index = formID - BASE;
+			occupied[index] = true;
+			highest = std::max<std::uint32_t>(highest, index);
+		}
+
+		// Everything below the high-water mark that nobody recorded is a hole left by purged entries.
+		std::int32_t holes = 0;
+		for (std::uint32_t word = 0; word < WORD_COUNT; word++) {
+			std::uint64_t bits = 0;
+			for (std::uint32_t bit = 0; bit < WORD_BITS; bit++) {
+				const auto index = word * WORD_BITS + bit;
+				if (index == 0 || index > highest || occupied[index])
+					continue;
+				bits |= 1ull << bit;
+				++holes;
+			}
+			freeBits[word].store(bits, std::memory_order_relaxed);
+		}
+
+		freeCount.store(holes, std::memory_order_relaxed);
+		next.store(highest + 1, std::memory_order_release);
+	}
+
+	RE::FormID FormIDAllocator::Allocate()
+	{
+		if (freeCount.load(std::memory_order_acquire) > 0) {
+			for (std::uint32_t word = 0; word < WORD_COUNT; word++) {
+				auto bits = freeBits[word].load(std::memory_order_relaxed);
+				while (bits != 0) {
+					const auto mask = 1ull << std::countr_zero(bits);
+					if (freeBits[word].fetch_and(~mask, std::memory_order_acq_rel) & mask) {
+						freeCount.fetch_sub(1, std::memory_order_acq_rel);
+						return BASE + word * WORD_BITS + static_cast<std::uint32_t>(std::countr_zero(mask));
+					}
+					bits = freeBits[word].load(std::memory_order_relaxed);
+				}
+			}
+			// Another thread claimed the last free bit but has not decremented the counter yet; use the bump pointer.
+		}
+
+		const auto index = next.fetch_add(1, std::memory_order_acq_rel);
+		if (index >= CAPACITY) {
+			logger::error("FormID range 0x{:08X}-0x{:08X} exhausted!", BASE, BASE + CAPACITY - 1);
+			return 0;
+		}
+		return BASE + index;
+	}
+
+	void FormIDAllocator::Release(RE::FormID formID)
+	{
+		if (!InRange(formID))
+			return;
+
+		const auto index = formID - BASE;
+		if (index >= next.load(std::memory_order_acquire))
+			return;
+
+		const auto mask = 1ull << (index % WORD_BITS);
+		if ((freeBits[index / WORD_BITS].fetch_or(mask, std::memory_order_acq_rel) & mask) == 0)
+			freeCount.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	void FormIDAllocator::Claim(RE::FormID formID)
+	{
+		if (!InRange(formID))
+			return;
+
+		const auto index = formID - BASE;
+		const auto mask = 1ull << (index % WORD_BITS);
+		if (freeBits[index / WORD_BITS].fetch_and(~mask, std::memory_order_acq_rel) & mask)
+			freeCount.fetch_sub(1, std::memory_order_acq_rel);
+
+		// IDs skipped by moving the bump pointer are not handed out this session; the next Seed finds them as holes.
+		auto current = next.load(std::memory_order_acquire);
+		while (current <= index && !next.compare_exchange_weak(current, index + 1, std::memory_order_acq_rel)) {}
+	}
+
+	FormIDAllocator::Stats FormIDAllocator::GetStats() const
+	{
+		const auto highWater = std::min<std::uint32_t>(next.load(std::memory_order_acquire), CAPACITY) - 1;
+		const auto reclaimable = static_cast<std::uint32_t>(std::max<std::int32_t>(freeCount.load(std::memory_order_acquire), 0));
+		return { highWater - std::min<std::uint32_t>(reclaimable, highWater), reclaimable, highWater, CAPACITY - 1 };
+	}
+}
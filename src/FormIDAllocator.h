@@ -0,0 +1,56 @@
+#pragma once
+
+namespace SCRIBE
+{
+	// Hands out FormIDs from Scribe's private 0xFF03xxxx range.
+	// Fresh IDs come from an atomic bump pointer; released IDs go into a free bitmap and are reused first.
+	class FormIDAllocator
+	{
+	public:
+		static constexpr RE::FormID BASE = 0xFF030000;
+		static constexpr std::uint32_t CAPACITY = 0x10000;
+
+		struct Stats
+		{
+			std::uint32_t occupied;
+			std::uint32_t reclaimable;
+			std::uint32_t highWater;
+			std::uint32_t capacity;
+		};
+
+		static FormIDAllocator& GetSingleton()
+		{
+			static FormIDAllocator instance;
+			return instance;
+		}
+
+		static bool InRange(RE::FormID formID)
+		{
+			return formID > BASE && formID - BASE < CAPACITY;
+		}
+
+		// Not thread-safe; call once at kDataLoaded before any allocation happens.
+		void Seed(std::span<const RE::FormID> recorded);
+
+		// Returns 0 when the range is exhausted.
+		RE::FormID Allocate();
+		void Release(RE::FormID formID);
+		// Marks an ID that was handed out elsewhere (an older session) as taken, so Allocate never returns it.
+		void Claim(RE::FormID formID);
+
+		Stats GetStats() const;
+
+		FormIDAllocator(FormIDAllocator const&) = delete;
+		void operator=(FormIDAllocator const&) = delete;
+
+	private:
+		static constexpr std::uint32_t WORD_BITS = 64;
+		static constexpr std::uint32_t WORD_COUNT = CAPACITY / WORD_BITS;
+
+		FormIDAllocator() = default;
+
+		std::array<std::atomic<std::uint64_t>, WORD_COUNT> freeBits{};
+		std::atomic<std::uint32_t> next{ 1 };  // index 0 (BASE itself) is never handed out
+		std::atomic<std::int32_t> freeCount{ 0 };
+	};
+}
@@ -0,0 +1,133 @@
+#include "FormIDPlanner.h"
+#include "FormIDAllocator.h"
+
+namespace SCRIBE
+{
+	void FormIDPlanner::Reserve(RE::FormID target)
+	{
+		reserved.insert(target);
+	}
+
+	void FormIDPlanner::Assign(RE::TESForm* form, RE::FormID target)
+	{
+		if (!form || target == 0x0)
+			return;
+
+		reserved.insert(target);
+		if (auto it = moveIndex.find(form); it != moveIndex.end()) {
+			moves[it->second].target = target;
+			return;
+		}
+		moveIndex.insert_or_assign(form, moves.size());
+		moves.push_back({ form, target });
+	}
+
+	void FormIDPlanner::AssignFresh(RE::TESForm* form)
+	{
+		if (auto formID = AllocateScratch(); formID != 0x0)
+			Assign(form, formID);
+	}
+
+	RE::FormID FormIDPlanner::AllocateScratch()
+	{
+		constexpr int maxAttempts = 64;
+		for (int i = 0; i < maxAttempts; i++) {
+			auto formID = FormIDAllocator::GetSingleton().Allocate();
+			if (formID == 0x0)
+				return 0x0;
+			if (!reserved.contains(formID) && RE::TESForm::LookupByID<RE::TESForm>(formID) == nullptr)
+				return formID;
+		}
+		logger::error("\tCould not find a free scratch FormID!");
+		return 0x0;
+	}
+
+	void FormIDPlanner::SetFormID(RE::TESForm* form, RE::FormID formID)
+	{
+		form->SetFormID(formID, updateFile);
+		++report.setFormIDCalls;
+	}
+
+	FormIDPlanner::Report FormIDPlanner::Commit()
+	{
+		// Current holder of every ID that belongs to a form of this batch.
+		std::unordered_map<RE::FormID, RE::TESForm*> holders;
+		std::unordered_set<RE::TESForm*> settled;
+		std::vector<Move> work;
+		std::vector<RE::FormID> scratchIDs;
+
+		for (const auto& move : moves) {
+			holders.insert_or_assign(move.form->GetFormID(), move.form);
+			if (move.form->GetFormID() == move.target) {
+				settled.insert(move.form);
+				++report.assigned;
+			} else {
+				work.push_back(move);
+			}
+		}
+
+		while (!work.empty()) {
+			bool progress = false;
+
+			std::erase_if(work, [&](const Move& move) {
+				if (auto it = holders.find(move.target); it != holders.end()) {
+					if (!settled.contains(it->second))
+						return false;  // the holder still has to move away first
+
+					logger::warn("\tFormID 0x{:08X} is claimed twice! Keeping {} at 0x{:08X}", move.target, move.form->GetName(), move.form->GetFormID());
+					++report.dropped;
+					progress = true;
+					return true;
+				}
+
+				if (auto occupant = RE::TESForm::LookupByID<RE::TESForm>(move.target); occupant != nullptr && occupant != move.form) {
+					auto parking = AllocateScratch();
+					if (parking == 0x0) {
+						++report.dropped;
+						progress = true;
+						return true;
+					}
+					logger::info("\tFormID 0x{:08X} in use by {} ({})! Parking it at 0x{:08X}", move.target, occupant->GetName(), RE::FormTypeToString(occupant->GetFormType()), parking);
+					SetFormID(occupant, parking);
+					++report.foreignConflicts;
+				}
+
+				holders.erase(move.form->GetFormID());
+				SetFormID(move.form, move.target);
+				holders.insert_or_assign(move.target, move.form);
+				settled.insert(move.form);
+				++report.assigned;
+				progress = true;
+				return true;
+			});
+
+			if (!progress) {
+				// Every remaining move waits on another one: park the first form to break the cycle.
+				auto& move = work.front();
+				auto parking = AllocateScratch();
+				if (parking == 0x0) {
+					report.dropped += work.size();
+					break;
+				}
+				holders.erase(move.form->GetFormID());
+				SetFormID(move.form, parking);
+				holders.insert_or_assign(parking, move.form);
+				scratchIDs.push_back(parking);
+				++report.cycles;
+			}
+		}
+
+		for (auto formID : scratchIDs)
+			if (!holders.contains(formID))
+				FormIDAllocator::GetSingleton().Release(formID);
+
+		logger::info("Assigned {} FormIDs with {} SetFormID calls ({} foreign conflicts, {} cycles, {} dropped).",
+			report.assigned, report.setFormIDCalls, report.foreignConflicts, report.cycles, report.dropped);
+
+		const auto result = report;
+		report = {};
+		moves.clear();
+		moveIndex.clear();
+		return result;
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace SCRIBE
+{
+	// Collects every FormID a batch of freshly created forms must end up with, then applies them in one pass.
+	// Moves are ordered so a form never lands on an ID that another form of the batch still holds;
+	// cycles are broken through a scratch ID and foreign occupants are parked out of the way once.
+	class FormIDPlanner
+	{
+	public:
+		struct Report
+		{
+			std::size_t assigned = 0;
+			std::size_t setFormIDCalls = 0;
+			std::size_t foreignConflicts = 0;
+			std::size_t cycles = 0;
+			std::size_t dropped = 0;
+		};
+
+		explicit FormIDPlanner(bool updateFile) :
+			updateFile(updateFile) {}
+
+		void Reserve(RE::FormID target);
+		void Assign(RE::TESForm* form, RE::FormID target);
+		void AssignFresh(RE::TESForm* form);
+		Report Commit();
+
+	private:
+		struct Move
+		{
+			RE::TESForm* form;
+			RE::FormID target;
+		};
+
+		RE::FormID AllocateScratch();
+		void SetFormID(RE::TESForm* form, RE::FormID formID);
+
+		bool updateFile;
+		std::unordered_set<RE::FormID> reserved;
+		std::vector<Move> moves;
+		std::unordered_map<RE::TESForm*, std::size_t> moveIndex;
+		Report report;
+	};
+}
@@ -0,0 +1,82 @@
+#include "FormKey.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	PluginNames::PluginNames()
+	{
+		names.emplace_back();
+		byName.insert_or_assign(names.back(), NONE);
+	}
+
+	std::uint32_t PluginNames::Intern(std::string_view name)
+	{
+		std::scoped_lock guard(lock);
+		if (auto it = byName.find(name); it != byName.end())
+			return it->second;
+
+		const auto index = static_cast<std::uint32_t>(names.size());
+		names.emplace_back(name);
+		byName.insert_or_assign(names.back(), index);
+		return index;
+	}
+
+	std::uint32_t PluginNames::Intern(const RE::TESFile* file)
+	{
+		if (!file)
+			return NONE;
+
+		{
+			std::scoped_lock guard(lock);
+			if (auto it = byFile.find(file); it != byFile.end())
+				return it->second;
+		}
+
+		const auto index = Intern(file->GetFilename());
+		std::scoped_lock guard(lock);
+		byFile.insert_or_assign(file, index);
+		return index;
+	}
+
+	std::string_view PluginNames::GetName(std::uint32_t index) const
+	{
+		std::scoped_lock guard(lock);
+		return index < names.size() ? std::string_view(names[index]) : std::string_view();
+	}
+
+	FormKey GetFormKey(const RE::TESForm* form)
+	{
+		if (!form)
+			return INVALID_FORM_KEY;
+		return MakeFormKey(PluginNames::GetSingleton().Intern(form->GetFile(0)), form->GetLocalFormID());
+	}
+
+	FormKey ParseFormKey(std::string_view text)
+	{
+		const auto tildePos = text.find('~');
+		if (tildePos == std::string_view::npos || tildePos == 0)
+			return INVALID_FORM_KEY;
+
+		const auto local = text.substr(tildePos + 1);
+		if (!local.starts_with("0x"))
+			return INVALID_FORM_KEY;
+
+		RE::FormID localFormID = 0;
+		if (auto [ptr, ec] = std::from_chars(local.data() + 2, local.data() + local.size(), localFormID, 16); ec != std::errc())
+			return INVALID_FORM_KEY;
+
+		return MakeFormKey(PluginNames::GetSingleton().Intern(text.substr(0, tildePos)), localFormID);
+	}
+
+	std::string FormatFormKey(FormKey key)
+	{
+		return std::format("{}~0x{:08X}", PluginNames::GetSingleton().GetName(GetPluginIndex(key)), GetLocalFormID(key));
+	}
+
+	RE::FormID ResolveFormKey(FormKey key)
+	{
+		if (GetPluginIndex(key) == PluginNames::NONE)
+			return GetLocalFormID(key);
+		return RE::TESDataHandler::GetSingleton()->LookupFormID(GetLocalFormID(key), PluginNames::GetSingleton().GetName(GetPluginIndex(key)));
+	}
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+namespace SCRIBE
+{
+	// Load-order independent form reference: interned plugin index in the high half, local FormID in the low half.
+	// Used for every in-memory lookup; the "Plugin.esp~0xLocalID" text form is only produced when writing files.
+	using FormKey = std::uint64_t;
+	constexpr FormKey INVALID_FORM_KEY = 0;
+
+	// Interned plugin names. Index 0 is reserved for "no plugin" (runtime FormIDs).
+	class PluginNames
+	{
+	public:
+		static constexpr std::uint32_t NONE = 0;
+
+		static PluginNames& GetSingleton()
+		{
+			static PluginNames instance;
+			return instance;
+		}
+
+		std::uint32_t Intern(std::string_view name);
+		std::uint32_t Intern(const RE::TESFile* file);
+		std::string_view GetName(std::uint32_t index) const;
+
+		PluginNames(PluginNames const&) = delete;
+		void operator=(PluginNames const&) = delete;
+
+	private:
+		PluginNames();
+
+		mutable std::mutex lock;
+		std::deque<std::string> names;  // deque keeps the views below stable
+		std::unordered_map<std::string_view, std::uint32_t> byName;
+		std::unordered_map<const RE::TESFile*, std::uint32_t> byFile;
+	};
+
+	constexpr FormKey MakeFormKey(std::uint32_t plugin, RE::FormID localFormID)
+	{
+		return (static_cast<FormKey>(plugin) << 32) | localFormID;
+	}
+
+	constexpr std::uint32_t GetPluginIndex(FormKey key) { return static_cast<std::uint32_t>(key >> 32); }
+	constexpr RE::FormID GetLocalFormID(FormKey key) { return static_cast<RE::FormID>(key); }
+
+	FormKey GetFormKey(const RE::TESForm* form);
+
+	// Parses "Plugin.esp~0xLocalID"; INVALID_FORM_KEY if the text is malformed.
+	FormKey ParseFormKey(std::string_view text);
+	std::string FormatFormKey(FormKey key);
+
+	// Runtime FormID of the keyed form in the current load order, 0 if its plugin is not loaded.
+	RE::FormID ResolveFormKey(FormKey key);
+}
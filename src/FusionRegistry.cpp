@@ -0,0 +1,523 @@
+#include "FusionRegistry.h"
+#include "Core.hpp"
+#include "FormIDPlanner.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	namespace
+	{
+		constexpr int MAX_FUSION_DEPTH = 8;
+		constexpr auto INDEX_DIRECTORY = "Data/SKSE/Plugins/ScrollScribeNG/Fusions"sv;
+		constexpr auto ID_SECTION = "FUSIONIDS"sv;
+
+		std::pair<std::string_view, std::string_view> SplitComponents(std::string_view input)
+		{
+			std::pair<std::string_view, std::string_view> components;
+
+			if (std::size_t plusPos = input.find("+"); plusPos != std::string_view::npos) {
+				components.first = input.substr(0, plusPos);
+				components.second = input.substr(plusPos + 1);
+			}
+
+			return components;
+		}
+
+		FusionRegistry::Ingredient ParseIngredient(std::string_view part)
+		{
+			if (part.find("~") == std::string_view::npos)
+				return { MakeFormKey(PluginNames::NONE, UTIL::lexical_cast_formid(part)), 0x0 };
+			return { ParseFormKey(part), 0x0 };
+		}
+
+		std::string FormatIngredient(const FusionRegistry::Ingredient& ingredient)
+		{
+			if (GetPluginIndex(ingredient.key) == PluginNames::NONE)
+				return std::format("0x{:08X}", GetLocalFormID(ingredient.key));
+			return FormatFormKey(ingredient.key);
+		}
+
+		bool IsEmpty(const FusionRegistry::Ingredient& ingredient)
+		{
+			return ingredient.key == INVALID_FORM_KEY;
+		}
+
+		RE::FormID ResolveFormID(const FusionRegistry::Ingredient& ingredient)
+		{
+			if (GetPluginIndex(ingredient.key) != PluginNames::NONE)
+				return ResolveFormKey(ingredient.key);
+
+			const auto formID = GetLocalFormID(ingredient.key);
+			if (RE::TESForm::LookupByID(formID) == nullptr && CACHE::FormIDRelocationBiMap.containsKey(formID)) {
+				auto rel = CACHE::FormIDRelocationBiMap.getValue(formID);
+				logger::info("\tFound relocation: 0x{:08X} => 0x{:08X}", formID, rel);
+				return rel;
+			}
+			return formID;
+		}
+
+		std::filesystem::path GetIndexPath(std::string_view saveName)
+		{
+			if (saveName.ends_with(".ess"))
+				saveName.remove_suffix(4);
+			return std::filesystem::path(INDEX_DIRECTORY) / std::format("{}.fusions", saveName);
+		}
+
+		// Same layout in the co-save record and the index file. Plugins are written by name so records
+		// survive load order changes. write(const void*, std::uint32_t)
+		template <typename Write>
+		void WriteRecords(const std::vector<std::pair<RE::FormID, FusionRegistry::Record>>& records, Write&& write)
+		{
+			const auto writeIngredient = [&write](const FusionRegistry::Ingredient& ingredient) {
+				const auto plugin = PluginNames::GetSingleton().GetName(GetPluginIndex(ingredient.key));
+				const auto length = static_cast<std::uint16_t>(plugin.size());
+				const auto formID = GetLocalFormID(ingredient.key);
+				write(&length, sizeof(length));
+				write(plugin.data(), length);
+				write(&formID, sizeof(formID));
+			};
+
+			const auto count = static_cast<std::uint32_t>(records.size());
+			write(&count, sizeof(count));
+			for (const auto& [product, record] : records) {
+				write(&product, sizeof(product));
+				writeIngredient(record.left);
+				writeIngredient(record.right);
+			}
+		}
+
+		// read(void*, std::uint32_t) -> bool. Stops at the first truncated entry.
+		template <typename Read>
+		std::vector<std::pair<RE::FormID, FusionRegistry::Record>> ReadRecords(Read&& read)
+		{
+			std::string plugin;
+			const auto readIngredient = [&read, &plugin](FusionRegistry::Ingredient& ingredient) {
+				std::uint16_t length = 0;
+				if (!read(&length, sizeof(length)))
+					return false;
+				plugin.resize(length);
+				if (length != 0 && !read(plugin.data(), length))
+					return false;
+				RE::FormID formID = 0x0;
+				if (!read(&formID, sizeof(formID)))
+					return false;
+				ingredient.key = MakeFormKey(PluginNames::GetSingleton().Intern(plugin), formID);
+				return true;
+			};
+
+			std::vector<std::pair<RE::FormID, FusionRegistry::Record>> records;
+			std::uint32_t count = 0;
+			if (!read(&count, sizeof(count)))
+				return records;
+			records.reserve(count);
+			for (std::uint32_t i = 0; i < count; i++) {
+				RE::FormID product = 0x0;
+				FusionRegistry::Record record;
+				if (!read(&product, sizeof(product)) || !readIngredient(record.left) || !readIngredient(record.right)) {
+					logger::error("Fusion records are truncated after {} of {} entries!", i, count);
+					break;
+				}
+				records.emplace_back(product, std::move(record));
+			}
+			return records;
+		}
+	}
+
+	void FusionRegistry::LoadLegacy()
+	{
+		logger::info("{:*^30}", "INDEXING FUSIONS");
+
+		auto& ini = CONFIG::Plugin::GetSingleton();
+		std::size_t purgedCount = 0;
+
+		std::scoped_lock guard(lock);
+		for (const auto& [key, value] : ini.GetAllKeyValuePairs("FUSION")) {
+			auto product = UTIL::lexical_cast_formid(key);
+			auto components = SplitComponents(value);
+
+			Record record{ ParseIngredient(components.first), ParseIngredient(components.second), true };
+			if (product == 0x0 || IsEmpty(record.left) || IsEmpty(record.right)) {
+				logger::info("Invalid data for {}", key);
+				ini.DeleteKey("FUSION", std::string(key));
+				FormIDAllocator::GetSingleton().Release(product);
+				++purgedCount;
+				continue;
+			}
+
+			Add(product, std::move(record));
+		}
+
+		logger::info("Indexed {} legacy fusions, purged {}.\n", pending.size(), purgedCount);
+	}
+
+	void FusionRegistry::Add(RE::FormID product, Record record)
+	{
+		record.left.resolved = ResolveFormID(record.left);
+		record.right.resolved = ResolveFormID(record.right);
+		if (record.left.resolved != 0x0 && record.right.resolved != 0x0)
+			byIngredients.insert_or_assign({ record.left.resolved, record.right.resolved }, product);
+
+		pending.insert_or_assign(product, std::move(record));
+	}
+
+	RE::ScrollItem* FusionRegistry::Materialize(RE::FormID product)
+	{
+		std::scoped_lock guard(lock);
+		if (!pending.contains(product))
+			return RE::TESForm::LookupByID<RE::ScrollItem>(product);
+
+		FormIDPlanner planner(!FORMS::GetSingleton().GetUseOffset());
+		std::unordered_map<RE::FormID, RE::ScrollItem*> restored;
+		auto result = Restore(product, planner, restored, 0);
+		planner.Commit();
+		return result;
+	}
+
+	std::size_t FusionRegistry::MaterializeAll(bool includeLegacy)
+	{
+		std::scoped_lock guard(lock);
+
+		std::vector<RE::FormID> products;
+		products.reserve(pending.size());
+		for (const auto& [product, record] : pending)
+			if (includeLegacy || !record.legacy)
+				products.push_back(product);
+
+		if (products.empty())
+			return 0;
+
+		logger::info("{:*^30}", "RESTORING FUSIONS");
+
+		FormIDPlanner planner(!FORMS::GetSingleton().GetUseOffset());
+		for (auto product : products)
+			planner.Reserve(product);
+
+		std::unordered_map<RE::FormID, RE::ScrollItem*> restored;
+		for (auto product : products)
+			Restore(product, planner, restored, 0);
+
+		planner.Commit();
+
+		logger::info("Restored {} fusions.\n", restored.size());
+		return restored.size();
+	}
+
+	RE::FormID FusionRegistry::FindPending(const RE::ScrollItem* left, const RE::ScrollItem* right) const
+	{
+		if (!left || !right)
+			return 0x0;
+
+		std::scoped_lock guard(lock);
+		if (auto it = byIngredients.find({ left->GetFormID(), right->GetFormID() }); it != byIngredients.end() && pending.contains(it->second))
+			return it->second;
+		if (auto it = byIngredients.find({ right->GetFormID(), left->GetFormID() }); it != byIngredients.end() && pending.contains(it->second))
+			return it->second;
+		return 0x0;
+	}
+
+	std::size_t FusionRegistry::PendingCount() const
+	{
+		std::scoped_lock guard(lock);
+		return pending.size();
+	}
+
+	RE::ScrollItem* FusionRegistry::Restore(RE::FormID product, FormIDPlanner& planner, std::unordered_map<RE::FormID, RE::ScrollItem*>& restored, int depth)
+	{
+		if (auto it = restored.find(product); it != restored.end())
+			return it->second;
+
+		auto it = pending.find(product);
+		if (it == pending.end())
+			return nullptr;
+
+		if (depth > MAX_FUSION_DEPTH) {
+			logger::info("0x{:08X} nests too deep. Purging...", product);
+			Purge(product);
+			return nullptr;
+		}
+
+		const auto record = it->second;
+		logger::info("Restoring 0x{:08X}", product);
+
+		auto leftScrollItem = ResolveIngredient(record.left, planner, restored, depth);
+		auto rightScrollItem = ResolveIngredient(record.right, planner, restored, depth);
+		if (!leftScrollItem || !rightScrollItem) {
+			logger::info("\tComponents 0x{:08X} & 0x{:08X} not loaded! Purging...", record.left.resolved, record.right.resolved);
+			Purge(product);
+			return nullptr;
+		}
+
+		auto loadedScroll = FuseAndCreateFunc(leftScrollItem, rightScrollItem);
+		if (loadedScroll == nullptr) {
+			logger::info("\tFuseAndCreateFunc RETURNED NULL!");
+			Purge(product);
+			return nullptr;
+		}
+
+		logger::info("\tPlanned FormID 0x{:08X}", product);
+		planner.Assign(loadedScroll, product);
+		ReserveID(product, record);
+		owned.insert_or_assign(loadedScroll, record);
+		pending.erase(product);
+		restored.insert_or_assign(product, loadedScroll);
+		return loadedScroll;
+	}
+
+	RE::ScrollItem* FusionRegistry::ResolveIngredient(const Ingredient& ingredient, FormIDPlanner& planner, std::unordered_map<RE::FormID, RE::ScrollItem*>& restored, int depth)
+	{
+		if (ingredient.resolved == 0x0)
+			return nullptr;
+		if (pending.contains(ingredient.resolved) || restored.contains(ingredient.resolved))
+			return Restore(ingredient.resolved, planner, restored, depth + 1);
+		return RE::TESForm::LookupByID<RE::ScrollItem>(ingredient.resolved);
+	}
+
+	void FusionRegistry::Purge(RE::FormID product)
+	{
+		// Only a legacy record that no save has taken over frees its ID; any other save may still hold the product.
+		auto& ini = CONFIG::Plugin::GetSingleton();
+		const auto key = std::format("0x{:08X}", product);
+		if (auto it = pending.find(product); it != pending.end() && it->second.legacy) {
+			ini.DeleteKey("FUSION", key);
+			if (ini.GetValue(std::string(ID_SECTION), key).empty())
+				FormIDAllocator::GetSingleton().Release(product);
+		}
+		pending.erase(product);
+	}
+
+	void FusionRegistry::ReserveID(RE::FormID product, const Record& record)
+	{
+		if (!FormIDAllocator::InRange(product))
+			return;
+
+		auto& ini = CONFIG::Plugin::GetSingleton();
+		const auto key = std::format("0x{:08X}", product);
+		if (ini.GetValue(std::string(ID_SECTION), key).empty())
+			ini.SetValue(std::string(ID_SECTION), key, std::format("{}+{}", FormatIngredient(record.left), FormatIngredient(record.right)));
+		// Indexes written before [FUSIONIDS] existed hold IDs the allocator was not seeded with.
+		FormIDAllocator::GetSingleton().Claim(product);
+	}
+
+	FusionRegistry::Ingredient FusionRegistry::Describe(const RE::ScrollItem* scroll)
+	{
+		RE::FormID formID = scroll->GetFormID();
+		if (CACHE::FormIDRelocationBiMap.containsKey(formID))
+			formID = CACHE::FormIDRelocationBiMap.getValue(formID);
+
+		if (formID < 0xFF000000)
+			return { GetFormKey(scroll), formID };
+		return { MakeFormKey(PluginNames::NONE, formID), formID };
+	}
+
+	void FusionRegistry::Track(RE::ScrollItem* product)
+	{
+		std::scoped_lock guard(lock);
+		std::vector<RE::ScrollItem*> work{ product };
+		while (!work.empty()) {
+			const auto scroll = work.back();
+			work.pop_back();
+			if (!scroll || owned.contains(scroll))
+				continue;
+			const auto components = CACHE::FusionResultToComponentsMap.find(scroll);
+			if (!components)
+				continue;
+			const auto& record = owned.emplace(scroll, Record{ Describe(components->first), Describe(components->second) }).first->second;
+			ReserveID(scroll->GetFormID(), record);
+			work.push_back(components->first);
+			work.push_back(components->second);
+		}
+	}
+
+	void FusionRegistry::ResetLocked()
+	{
+		owned.clear();
+		std::erase_if(pending, [](const auto& entry) { return !entry.second.legacy; });
+		std::erase_if(byIngredients, [&](const auto& entry) { return !pending.contains(entry.second); });
+	}
+
+	void FusionRegistry::Reset()
+	{
+		std::scoped_lock guard(lock);
+		ResetLocked();
+		preloaded = false;
+	}
+
+	void FusionRegistry::BeginLoad(std::string_view name)
+	{
+		const auto path = GetIndexPath(name);
+		bool hasIndex = false;
+		{
+			std::scoped_lock guard(lock);
+			ResetLocked();
+			preloaded = true;
+			saveName = name;
+
+			if (std::ifstream in(path, std::ios::binary); in) {
+				std::uint32_t magic = 0, version = 0;
+				in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+				in.read(reinterpret_cast<char*>(&version), sizeof(version));
+				if (in && magic == SERIALIZATION_ID && version == RECORD_VERSION) {
+					hasIndex = true;
+					for (auto& [product, record] : ReadRecords([&in](void* data, std::uint32_t size) { return static_cast<bool>(in.read(static_cast<char*>(data), size)); }))
+						Add(product, std::move(record));
+				} else {
+					logger::warn("Ignoring unreadable fusion index {}", path.string());
+				}
+			}
+		}
+
+		// Only a save without an index may still depend on the legacy records.
+		MaterializeAll(!hasIndex);
+	}
+
+	void FusionRegistry::EndLoad()
+	{
+		std::scoped_lock guard(lock);
+		preloaded = false;
+	}
+
+	void FusionRegistry::SetSaveName(std::string_view name)
+	{
+		std::scoped_lock guard(lock);
+		saveName = name;
+	}
+
+	void FusionRegistry::DeleteIndex(std::string_view saveName)
+	{
+		std::error_code error;
+		std::filesystem::remove(GetIndexPath(saveName), error);
+	}
+
+	FusionRegistry::RecordList FusionRegistry::CollectOwned() const
+	{
+		std::scoped_lock guard(lock);
+		RecordList records;
+		records.reserve(owned.size() + pending.size());
+		for (const auto& [scroll, record] : owned)
+			records.emplace_back(scroll->GetFormID(), record);
+		// Records not rebuilt this session (nothing asked for them yet) are carried forward unchanged.
+		for (const auto& [product, record] : pending)
+			if (!record.legacy)
+				records.emplace_back(product, record);
+		return records;
+	}
+
+	void FusionRegistry::WriteIndex(const RecordList& records) const
+	{
+		std::string name;
+		{
+			std::scoped_lock guard(lock);
+			name = saveName;
+		}
+		if (name.empty())
+			return;
+
+		const auto path = GetIndexPath(name);
+		auto temporary = path;
+		temporary += ".tmp";
+
+		std::error_code error;
+		std::filesystem::create_directories(path.parent_path(), error);
+		{
+			std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+			const auto write = [&out](const void* data, std::uint32_t size) { out.write(static_cast<const char*>(data), size); };
+			write(&SERIALIZATION_ID, sizeof(SERIALIZATION_ID));
+			write(&RECORD_VERSION, sizeof(RECORD_VERSION));
+			WriteRecords(records, write);
+			if (!out) {
+				logger::error("Failed to write fusion index {}", path.string());
+				return;
+			}
+		}
+		std::filesystem::rename(temporary, path, error);
+		if (error)
+			logger::error("Failed to write fusion index {}: {}", path.string(), error.message());
+	}
+
+	void FusionRegistry::MigrateLegacy()
+	{
+		auto& ini = CONFIG::Plugin::GetSingleton();
+		std::size_t migrated = 0;
+		{
+			std::scoped_lock guard(lock);
+			for (auto& [scroll, record] : owned) {
+				if (!record.legacy)
+					continue;
+				ini.DeleteKey("FUSION", std::format("0x{:08X}", scroll->GetFormID()));
+				record.legacy = false;
+				++migrated;
+			}
+		}
+		if (migrated == 0)
+			return;
+
+		logger::info("Moved {} legacy fusions into this save's co-save.", migrated);
+		if (ini.GetAllKeyValuePairs("FUSION").empty()) {
+			ini.DeleteSection("FUSION");
+			ini.SetBoolValue("SETTINGS", "RestoreLegacyFusions", false);
+			logger::info("Every legacy fusion has been migrated. RestoreLegacyFusions is now off.");
+		}
+		ini.Save();
+	}
+
+	void FusionRegistry::OnSave(SKSE::SerializationInterface* serde)
+	{
+		auto& registry = GetSingleton();
+		const auto records = registry.CollectOwned();
+
+		if (!serde->OpenRecord(RECORD_FUSIONS, RECORD_VERSION)) {
+			logger::error("Failed to open fusion record!");
+			return;
+		}
+		WriteRecords(records, [serde](const void* data, std::uint32_t size) { serde->WriteRecordData(data, size); });
+		logger::info("Saved {} fusions.", records.size());
+
+		registry.WriteIndex(records);
+		registry.MigrateLegacy();
+	}
+
+	void FusionRegistry::OnLoad(SKSE::SerializationInterface* serde)
+	{
+		auto& registry = GetSingleton();
+
+		std::size_t late = 0;
+		std::uint32_t type, version, length;
+		while (serde->GetNextRecordInfo(type, version, length)) {
+			if (type != RECORD_FUSIONS)
+				continue;
+			if (version != RECORD_VERSION) {
+				logger::warn("Unknown fusion record version {}. Skipping.", version);
+				continue;
+			}
+
+			const auto records = ReadRecords([serde](void* data, std::uint32_t size) { return serde->ReadRecordData(data, size) == size; });
+
+			std::scoped_lock guard(registry.lock);
+			std::unordered_set<RE::FormID> restored;
+			for (const auto& [scroll, record] : registry.owned)
+				restored.insert(scroll->GetFormID());
+			for (const auto& [product, record] : records) {
+				if (restored.contains(product) || registry.pending.contains(product))
+					continue;
+				registry.Add(product, record);
+				++late;
+			}
+		}
+
+		// Normally kPreLoadGame restored everything from the index already. Without one (deleted, or the save
+		// predates it), the products come too late for inventories but are still rebuilt for later use.
+		if (late > 0) {
+			logger::warn("{} fusions were missing from the save's index.", late);
+			registry.MaterializeAll(false);
+		}
+		registry.EndLoad();
+	}
+
+	void FusionRegistry::OnRevert(SKSE::SerializationInterface*)
+	{
+		auto& registry = GetSingleton();
+		std::scoped_lock guard(registry.lock);
+		if (!registry.preloaded)
+			registry.ResetLocked();
+	}
+}
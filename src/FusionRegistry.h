@@ -0,0 +1,102 @@
+#pragma once
+
+#include "FormKey.h"
+
+namespace SCRIBE
+{
+	class FormIDPlanner;
+
+	// Fusion records, kept as plain data until something needs the product.
+	// Each save stores its fusions in its SKSE co-save, mirrored into a small index file named after the save:
+	// co-save records are only read after the engine has loaded the save's inventories, so kPreLoadGame rebuilds
+	// the products from the index first. The old global [FUSION] INI section is only read as a legacy import source
+	// for saves made before that; its entries are removed once a co-save has taken them over.
+	// The ScrollItem (and fused concentration SpellItem) for a record is built the first time its product is
+	// requested, together with any fused ingredients it depends on.
+	// Every product FormID is also listed in the global [FUSIONIDS] section: other saves may still hold it, so
+	// the FormID allocator is seeded with it and never hands it to a generated scroll or another fusion.
+	class FusionRegistry
+	{
+	public:
+		static constexpr std::uint32_t SERIALIZATION_ID = 'SCRB';
+		static constexpr std::uint32_t RECORD_FUSIONS = 'FUSN';
+		static constexpr std::uint32_t RECORD_VERSION = 1;
+
+		struct Ingredient
+		{
+			FormKey key;  // plugin NONE: the local half is a full runtime FormID
+			RE::FormID resolved;
+		};
+
+		struct Record
+		{
+			Ingredient left;
+			Ingredient right;
+			bool legacy = false;
+		};
+
+		static FusionRegistry& GetSingleton()
+		{
+			static FusionRegistry instance;
+			return instance;
+		}
+
+		// Parses the legacy [FUSION] section. Call at kDataLoaded.
+		void LoadLegacy();
+		RE::ScrollItem* Materialize(RE::FormID product);
+		std::size_t MaterializeAll(bool includeLegacy);
+
+		// kPreLoadGame: drops the previous save's records and rebuilds this save's products from its index.
+		// Saves without an index (made before it existed) restore the legacy records instead.
+		void BeginLoad(std::string_view saveName);
+		// kPostLoadGame
+		void EndLoad();
+		// kNewGame
+		void Reset();
+		// kSaveGame, before the co-save is written; names the index the save callback writes.
+		void SetSaveName(std::string_view saveName);
+		// kDeleteGame
+		static void DeleteIndex(std::string_view saveName);
+
+		// Records a fusion built this session, and any fused ingredients, as belonging to the current save.
+		void Track(RE::ScrollItem* product);
+
+		// Recorded product FormID for this pair of ingredients (in either order), 0 if none is pending.
+		RE::FormID FindPending(const RE::ScrollItem* left, const RE::ScrollItem* right) const;
+		std::size_t PendingCount() const;
+
+		static Ingredient Describe(const RE::ScrollItem* scroll);
+
+		static void OnSave(SKSE::SerializationInterface* serde);
+		static void OnLoad(SKSE::SerializationInterface* serde);
+		static void OnRevert(SKSE::SerializationInterface* serde);
+
+		FusionRegistry(FusionRegistry const&) = delete;
+		void operator=(FusionRegistry const&) = delete;
+
+	private:
+		FusionRegistry() = default;
+
+		using RecordList = std::vector<std::pair<RE::FormID, Record>>;
+
+		void Add(RE::FormID product, Record record);
+		void ResetLocked();
+		RE::ScrollItem* Restore(RE::FormID product, FormIDPlanner& planner, std::unordered_map<RE::FormID, RE::ScrollItem*>& restored, int depth);
+		RE::ScrollItem* ResolveIngredient(const Ingredient& ingredient, FormIDPlanner& planner, std::unordered_map<RE::FormID, RE::ScrollItem*>& restored, int depth);
+		void Purge(RE::FormID product);
+		void ReserveID(RE::FormID product, const Record& record);
+
+		RecordList CollectOwned() const;
+		void WriteIndex(const RecordList& records) const;
+		void MigrateLegacy();
+
+		mutable std::mutex lock;
+		std::unordered_map<RE::FormID, Record> pending;
+		std::map<std::pair<RE::FormID, RE::FormID>, RE::FormID> byIngredients;
+		// Fusions of the current save. Records are only dropped when their ingredients are gone, never for
+		// being out of sight: fused scrolls in unloaded cells or merchant chests are still carried forward.
+		std::unordered_map<RE::ScrollItem*, Record> owned;
+		std::string saveName;
+		bool preloaded = false;  // records of the save being loaded are already restored; keep them on revert
+	};
+}
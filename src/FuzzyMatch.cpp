@@ -0,0 +1,156 @@
+#include "FuzzyMatch.h"
+
+namespace SCRIBE
+{
+	namespace QUERY
+	{
+		namespace
+		{
+			// Lowercase letters and digits separated by single spaces, padded with one space on each side so word
+			// starts and ends get their own trigrams. A leading "scroll of" is dropped; every non-ASCII byte is kept as is.
+			std::string NormalizeName(std::string_view name)
+			{
+				std::string result(" ");
+				result.reserve(name.size() + 2);
+				for (const unsigned char c : name) {
+					const bool keep = std::isalnum(c) || c >= 0x80;
+					if (keep)
+						result.push_back(c < 0x80 ? static_cast<char>(std::tolower(c)) : static_cast<char>(c));
+					else if (result.back() != ' ')
+						result.push_back(' ');
+				}
+				if (result.back() != ' ')
+					result.push_back(' ');
+
+				if (result.starts_with(" scroll of "sv))
+					result.erase(1, "scroll of "sv.size());
+				return result;
+			}
+
+			std::size_t GetSymbol(unsigned char c)
+			{
+				if (c == ' ')
+					return 0;
+				if (c >= 'a' && c <= 'z')
+					return 1 + (c - 'a');
+				if (c >= '0' && c <= '9')
+					return 27 + (c - '0');
+				return 37;
+			}
+		}
+
+		std::vector<FuzzySpellMatcher::Trigram> FuzzySpellMatcher::GetTrigrams(std::string_view name)
+		{
+			const auto normalized = NormalizeName(name);
+
+			std::vector<Trigram> trigrams;
+			if (normalized.size() < 3)
+				return trigrams;
+
+			trigrams.reserve(normalized.size() - 2);
+			for (std::size_t i = 0; i + 2 < normalized.size(); i++) {
+				const auto a = GetSymbol(normalized[i]), b = GetSymbol(normalized[i + 1]), c = GetSymbol(normalized[i + 2]);
+				trigrams.push_back(static_cast<Trigram>((a * SYMBOLS + b) * SYMBOLS + c));
+			}
+			std::ranges::sort(trigrams);
+			trigrams.erase(std::ranges::unique(trigrams).begin(), trigrams.end());
+			return trigrams;
+		}
+
+		std::vector<const RE::EffectSetting*> FuzzySpellMatcher::GetBaseEffects(const RE::MagicItem* item)
+		{
+			std::vector<const RE::EffectSetting*> effects;
+			effects.reserve(item->effects.size());
+			for (const auto eff : item->effects) {
+				if (eff && eff->baseEffect)
+					effects.push_back(eff->baseEffect);
+			}
+			std::ranges::sort(effects);
+			effects.erase(std::ranges::unique(effects).begin(), effects.end());
+			return effects;
+		}
+
+		void FuzzySpellMatcher::Build(const CATALOG::ScrollCatalog& catalog)
+		{
+			const auto count = catalog.size();
+
+			trigramPostings.assign(SYMBOLS * SYMBOLS * SYMBOLS, {});
+			effectPostings.clear();
+			nameTrigrams.assign(count, 0);
+			effectCounts.assign(count, 0);
+			trigramHits.assign(count, 0);
+			effectHits.assign(count, 0);
+			touched.clear();
+			touched.reserve(count);
+
+			for (CATALOG::ScrollID id = 0; id < count; id++) {
+				const auto spell = catalog.GetSpell(id);
+
+				const auto trigrams = GetTrigrams(spell->GetName());
+				for (const auto trigram : trigrams)
+					trigramPostings[trigram].push_back(id);
+				nameTrigrams[id] = static_cast<std::uint16_t>(std::min<std::size_t>(trigrams.size(), 0xFFFF));
+
+				const auto effects = GetBaseEffects(spell);
+				for (const auto effect : effects)
+					effectPostings[effect].push_back(id);
+				effectCounts[id] = static_cast<std::uint8_t>(std::min<std::size_t>(effects.size(), 0xFF));
+			}
+		}
+
+		FuzzyMatch FuzzySpellMatcher::Find(const RE::ScrollItem* scroll) const
+		{
+			const auto trigrams = GetTrigrams(scroll->GetName());
+			const auto effects = GetBaseEffects(scroll);
+			if (trigrams.empty() || effects.empty())
+				return {};
+
+			for (const auto trigram : trigrams) {
+				for (const auto id : trigramPostings[trigram]) {
+					if (trigramHits[id] == 0 && effectHits[id] == 0)
+						touched.push_back(id);
+					++trigramHits[id];
+				}
+			}
+			for (const auto effect : effects) {
+				if (auto it = effectPostings.find(effect); it != effectPostings.end()) {
+					for (const auto id : it->second) {
+						if (trigramHits[id] == 0 && effectHits[id] == 0)
+							touched.push_back(id);
+						if (effectHits[id] < 0xFF)
+							++effectHits[id];
+					}
+				}
+			}
+
+			const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+			std::array<FuzzyMatch, TOP_K> best{};
+			for (const auto id : touched) {
+				// A match must share at least one effect and must not already have been replaced by another scroll.
+				if (effectHits[id] == 0 || effectCounts[id] == 0 || catalog.GetOrigin(id) != CATALOG::Origin::kGenerated)
+					continue;
+
+				const auto nameScore = 2.0f * trigramHits[id] / static_cast<float>(trigrams.size() + nameTrigrams[id]);
+				// Covering the spell's effects matters more than extra effects on the scroll.
+				const auto effectScore = 0.75f * effectHits[id] / effectCounts[id] + 0.25f * effectHits[id] / static_cast<float>(effects.size());
+				const FuzzyMatch candidate{ id, 0.5f * (nameScore + effectScore) };
+
+				if (candidate.score <= best.back().score)
+					continue;
+				auto pos = std::ranges::upper_bound(best, candidate.score, std::greater<>{}, &FuzzyMatch::score);
+				std::move_backward(pos, best.end() - 1, best.end());
+				*pos = candidate;
+			}
+
+			for (const auto id : touched) {
+				trigramHits[id] = 0;
+				effectHits[id] = 0;
+			}
+			touched.clear();
+
+			if (best[0].score < THRESHOLD || best[0].score - best[1].score < MIN_MARGIN)
+				return { CATALOG::INVALID_SCROLL_ID, best[0].score };
+			return best[0];
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Catalog.h"
+
+namespace SCRIBE
+{
+	namespace QUERY
+	{
+		struct FuzzyMatch
+		{
+			CATALOG::ScrollID id = CATALOG::INVALID_SCROLL_ID;
+			float score = 0.0f;
+		};
+
+		// Fallback for scrolls the exact name/effect hashes miss. Catalog spells are indexed by the trigrams of their
+		// normalized names and by their base effects; a query only touches the posting lists of its own trigrams and
+		// effects, then scores the touched entries (name and effect Dice overlap) and keeps the best TOP_K.
+		// Only entries still holding a generated scroll are returned, so a spell is never integrated twice.
+		// Queries share scratch buffers and must not run concurrently.
+		class FuzzySpellMatcher
+		{
+		public:
+			static constexpr std::size_t TOP_K = 4;
+			static constexpr float THRESHOLD = 0.7f;
+			static constexpr float MIN_MARGIN = 0.05f;  // best must beat the runner-up by this much
+
+			void Build(const CATALOG::ScrollCatalog& catalog);
+			FuzzyMatch Find(const RE::ScrollItem* scroll) const;
+
+			bool empty() const { return nameTrigrams.empty(); }
+
+		private:
+			using Trigram = std::uint16_t;
+			static constexpr std::size_t SYMBOLS = 38;  // space, a-z, 0-9, any non-ASCII byte
+
+			static std::vector<Trigram> GetTrigrams(std::string_view name);
+			static std::vector<const RE::EffectSetting*> GetBaseEffects(const RE::MagicItem* item);
+
+			std::vector<std::vector<CATALOG::ScrollID>> trigramPostings;  // indexed by trigram
+			std::unordered_map<const RE::EffectSetting*, std::vector<CATALOG::ScrollID>> effectPostings;
+			std::vector<std::uint16_t> nameTrigrams;  // distinct trigrams per entry
+			std::vector<std::uint8_t> effectCounts;   // distinct base effects per entry
+
+			mutable std::vector<std::uint16_t> trigramHits;
+			mutable std::vector<std::uint8_t> effectHits;
+			mutable std::vector<CATALOG::ScrollID> touched;
+		};
+	}
+}
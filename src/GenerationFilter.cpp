@@ -0,0 +1,273 @@
+#include "GenerationFilter.h"
+#include "FormKey.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	namespace
+	{
+		constexpr auto SECTION = "GENERATION"sv;
+
+		struct RuleDefault
+		{
+			std::string_view key;
+			std::string_view value;
+			std::string_view comment;
+		};
+
+		constexpr auto RULE_DEFAULTS = std::to_array<RuleDefault>({
+			{ "AllowPlugins", "", "# Comma-separated plugin names whose spell tomes get scrolls; * and ? are wildcards. Empty = every plugin." },
+			{ "DenyPlugins", "", "# Comma-separated plugin names whose spell tomes never get scrolls; * and ? are wildcards. Wins over AllowPlugins." },
+			{ "MinTier", "0", "# Lowest and highest scroll tier to generate: 0 = Novice, 1 = Apprentice, 2 = Adept, 3 = Expert, 4 = Master." },
+			{ "MaxTier", "4", "" },
+			{ "Schools", "", "# Comma-separated schools to generate: Alteration, Conjuration, Destruction, Illusion, Restoration, Other. Empty = all." },
+			{ "CastingTypes", "", "# Comma-separated casting types to generate: FireAndForget, Concentration. Empty = all." },
+			{ "ExcludeForms", "", "# Comma-separated spell tomes or spells never to generate scrolls for, as Plugin.esp~0xLocalID." },
+		});
+
+		std::string ToLower(std::string_view text)
+		{
+			std::string result(text);
+			std::ranges::transform(result, result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+			return result;
+		}
+
+		std::vector<std::string> SplitList(std::string_view text)
+		{
+			std::vector<std::string> items;
+			for (const auto part : std::views::split(text, ',')) {
+				std::string_view item(part.begin(), part.end());
+				const auto first = item.find_first_not_of(" \t");
+				if (first == std::string_view::npos)
+					continue;
+				item = item.substr(first, item.find_last_not_of(" \t") - first + 1);
+				items.emplace_back(item);
+			}
+			return items;
+		}
+
+		// Both sides lowercase. '*' matches any run, '?' any single character.
+		bool GlobMatch(std::string_view pattern, std::string_view text)
+		{
+			std::size_t p = 0, t = 0;
+			std::size_t star = std::string_view::npos, resume = 0;
+			while (t < text.size()) {
+				if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+					++p;
+					++t;
+				} else if (p < pattern.size() && pattern[p] == '*') {
+					star = p++;
+					resume = t;
+				} else if (star != std::string_view::npos) {
+					p = star + 1;
+					t = ++resume;
+				} else {
+					return false;
+				}
+			}
+			while (p < pattern.size() && pattern[p] == '*')
+				++p;
+			return p == pattern.size();
+		}
+
+		bool MatchesAny(const std::vector<std::string>& patterns, std::string_view name)
+		{
+			return std::ranges::any_of(patterns, [name](const std::string& pattern) { return GlobMatch(pattern, name); });
+		}
+
+		std::string_view GetReasonName(GenerationFilter::Reason reason)
+		{
+			switch (reason) {
+			case GenerationFilter::Reason::kPlugin:
+				return "plugin"sv;
+			case GenerationFilter::Reason::kExcluded:
+				return "excluded form"sv;
+			case GenerationFilter::Reason::kSchool:
+				return "school"sv;
+			case GenerationFilter::Reason::kCastingType:
+				return "casting type"sv;
+			case GenerationFilter::Reason::kTier:
+				return "tier"sv;
+			default:
+				return "unknown"sv;
+			}
+		}
+	}
+
+	void GenerationFilter::Load()
+	{
+		logger::info("{:*^30}", "LOADING GENERATION RULES");
+
+		auto& ini = CONFIG::Plugin::GetSingleton();
+		const std::string section(SECTION);
+		for (const auto& rule : RULE_DEFAULTS) {
+			if (!ini.HasKey(section, std::string(rule.key)))
+				ini.SetValue(section, std::string(rule.key), std::string(rule.value), std::string(rule.comment));
+		}
+
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		if (!dataHandler) {
+			logger::error("Failed to fetch TESDataHandler!");
+			return;
+		}
+
+		// Plugins
+		std::vector<std::string> allow, deny;
+		for (const auto& item : SplitList(ini.GetValue(section, "AllowPlugins")))
+			allow.push_back(ToLower(item));
+		for (const auto& item : SplitList(ini.GetValue(section, "DenyPlugins")))
+			deny.push_back(ToLower(item));
+
+		allowedPlugins.set();
+		std::size_t loadedPlugins = 0, deniedPlugins = 0;
+		const auto compilePlugin = [&](const RE::TESFile* file, std::size_t slot) {
+			if (!file || slot >= PLUGIN_SLOTS)
+				return;
+			++loadedPlugins;
+			const auto name = ToLower(file->GetFilename());
+			if ((!allow.empty() && !MatchesAny(allow, name)) || MatchesAny(deny, name)) {
+				allowedPlugins.reset(slot);
+				++deniedPlugins;
+			}
+		};
+		for (const auto file : dataHandler->compiledFileCollection.files)
+			compilePlugin(file, file->GetCompileIndex());
+		for (const auto file : dataHandler->compiledFileCollection.smallFiles)
+			compilePlugin(file, FULL_SLOTS + file->GetSmallFileCompileIndex());
+
+		// Tiers
+		const auto minTier = std::clamp(ini.GetLongValue(section, "MinTier"), 0L, 4L);
+		const auto maxTier = std::clamp(ini.GetLongValue(section, "MaxTier"), 0L, 4L);
+		tierMask = 0;
+		for (auto tier = minTier; tier <= maxTier; tier++)
+			tierMask |= static_cast<std::uint8_t>(1u << tier);
+
+		// Schools
+		constexpr auto SCHOOL_NAMES = std::to_array<std::pair<std::string_view, RE::ActorValue>>({
+			{ "alteration", RE::ActorValue::kAlteration },
+			{ "conjuration", RE::ActorValue::kConjuration },
+			{ "destruction", RE::ActorValue::kDestruction },
+			{ "illusion", RE::ActorValue::kIllusion },
+			{ "restoration", RE::ActorValue::kRestoration },
+			{ "other", RE::ActorValue::kNone },
+		});
+		const auto schools = SplitList(ini.GetValue(section, "Schools"));
+		schoolMask = schools.empty() ? 0xFF : 0;
+		for (const auto& item : schools) {
+			auto it = std::ranges::find(SCHOOL_NAMES, ToLower(item), &std::pair<std::string_view, RE::ActorValue>::first);
+			if (it == SCHOOL_NAMES.end()) {
+				logger::warn("Unknown school {}. Ignoring.", item);
+				continue;
+			}
+			schoolMask |= GetSchoolBit(it->second);
+		}
+
+		// Casting types
+		const auto castingTypes = SplitList(ini.GetValue(section, "CastingTypes"));
+		castingTypeMask = castingTypes.empty() ? 0xFF : 0;
+		for (const auto& item : castingTypes) {
+			const auto name = ToLower(item);
+			if (name == "fireandforget")
+				castingTypeMask |= GetCastingTypeBit(RE::MagicSystem::CastingType::kFireAndForget);
+			else if (name == "concentration")
+				castingTypeMask |= GetCastingTypeBit(RE::MagicSystem::CastingType::kConcentration);
+			else
+				logger::warn("Unknown casting type {}. Ignoring.", item);
+		}
+
+		// Explicit excludes
+		excluded.clear();
+		for (const auto& item : SplitList(ini.GetValue(section, "ExcludeForms"))) {
+			const auto key = ParseFormKey(item);
+			if (key == INVALID_FORM_KEY) {
+				logger::warn("Invalid format. Ignoring {}", item);
+				continue;
+			}
+			if (const auto formID = ResolveFormKey(key); formID != 0x0)
+				excluded.push_back(formID);
+			else
+				logger::info("Form {} not loaded. Ignoring.", item);
+		}
+		std::ranges::sort(excluded);
+		excluded.erase(std::ranges::unique(excluded).begin(), excluded.end());
+
+		ResetCounts();
+		logger::info("{} of {} plugins denied, tiers {}-{}, {} excluded forms.\n", deniedPlugins, loadedPlugins, minTier, maxTier, excluded.size());
+	}
+
+	bool GenerationFilter::Accepts(const RE::TESObjectBOOK* book, const RE::SpellItem* spell)
+	{
+		auto reject = [this](Reason reason) {
+			++skipped[static_cast<std::size_t>(reason)];
+			return false;
+		};
+
+		if (const auto slot = GetPluginSlot(book->GetFormID()); slot < PLUGIN_SLOTS && !allowedPlugins.test(slot))
+			return reject(Reason::kPlugin);
+		if (!excluded.empty() && (std::ranges::binary_search(excluded, book->GetFormID()) || std::ranges::binary_search(excluded, spell->GetFormID())))
+			return reject(Reason::kExcluded);
+		if (!(schoolMask & GetSchoolBit(spell->GetAssociatedSkill())))
+			return reject(Reason::kSchool);
+		if (!(castingTypeMask & GetCastingTypeBit(spell->GetCastingType())))
+			return reject(Reason::kCastingType);
+		return true;
+	}
+
+	bool GenerationFilter::AcceptsTier(CATALOG::Tier tier)
+	{
+		if (tierMask & (1u << static_cast<std::uint8_t>(tier)))
+			return true;
+		++skipped[static_cast<std::size_t>(Reason::kTier)];
+		return false;
+	}
+
+	void GenerationFilter::LogCounts() const
+	{
+		for (std::size_t i = 0; i < skipped.size(); i++) {
+			if (skipped[i] > 0)
+				logger::info("Skipped {} spell tomes by {} rules.", skipped[i], GetReasonName(static_cast<Reason>(i)));
+		}
+	}
+
+	std::size_t GenerationFilter::GetPluginSlot(RE::FormID formID)
+	{
+		switch (const auto index = formID >> 24) {
+		case 0xFE:
+			return FULL_SLOTS + ((formID >> 12) & 0xFFF);
+		case 0xFF:
+			return PLUGIN_SLOTS;  // created at runtime, no plugin
+		default:
+			return index;
+		}
+	}
+
+	std::uint8_t GenerationFilter::GetSchoolBit(RE::ActorValue school)
+	{
+		switch (school) {
+		case RE::ActorValue::kAlteration:
+			return 1 << 0;
+		case RE::ActorValue::kConjuration:
+			return 1 << 1;
+		case RE::ActorValue::kDestruction:
+			return 1 << 2;
+		case RE::ActorValue::kIllusion:
+			return 1 << 3;
+		case RE::ActorValue::kRestoration:
+			return 1 << 4;
+		default:
+			return 1 << 5;
+		}
+	}
+
+	std::uint8_t GenerationFilter::GetCastingTypeBit(RE::MagicSystem::CastingType castingType)
+	{
+		switch (castingType) {
+		case RE::MagicSystem::CastingType::kFireAndForget:
+			return 1 << 0;
+		case RE::MagicSystem::CastingType::kConcentration:
+			return 1 << 1;
+		default:
+			return 1 << 2;
+		}
+	}
+}
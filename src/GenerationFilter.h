@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Catalog.h"
+
+namespace SCRIBE
+{
+	// [GENERATION] rules deciding which spell tomes get a scroll. Compiled once at kDataLoaded into a bitset over
+	// plugin slots (full plugins by compile index, light plugins after them) plus a few masks, so each tome costs
+	// a couple of bit tests and, only with excludes configured, one binary search.
+	class GenerationFilter
+	{
+	public:
+		enum class Reason : std::uint8_t
+		{
+			kPlugin,
+			kExcluded,
+			kSchool,
+			kCastingType,
+			kTier,
+
+			kTotal
+		};
+
+		static GenerationFilter& GetSingleton()
+		{
+			static GenerationFilter instance;
+			return instance;
+		}
+
+		// Writes missing keys, then compiles the rules against the current load order.
+		void Load();
+
+		// Everything but the tier, which is only known after the dust kernel ran. Counts the skip on failure.
+		bool Accepts(const RE::TESObjectBOOK* book, const RE::SpellItem* spell);
+		bool AcceptsTier(CATALOG::Tier tier);
+
+		void ResetCounts() { skipped.fill(0); }
+		void LogCounts() const;
+
+		GenerationFilter(GenerationFilter const&) = delete;
+		void operator=(GenerationFilter const&) = delete;
+
+	private:
+		GenerationFilter() = default;
+
+		static constexpr std::size_t FULL_SLOTS = 0xFE;
+		static constexpr std::size_t PLUGIN_SLOTS = FULL_SLOTS + 0x1000;
+
+		static std::size_t GetPluginSlot(RE::FormID formID);
+		static std::uint8_t GetSchoolBit(RE::ActorValue school);
+		static std::uint8_t GetCastingTypeBit(RE::MagicSystem::CastingType castingType);
+
+		std::bitset<PLUGIN_SLOTS> allowedPlugins;
+		std::uint8_t schoolMask = 0xFF;
+		std::uint8_t castingTypeMask = 0xFF;
+		std::uint8_t tierMask = 0xFF;
+		std::vector<RE::FormID> excluded;  // sorted book and spell FormIDs
+
+		std::array<std::size_t, static_cast<std::size_t>(Reason::kTotal)> skipped{};
+	};
+}
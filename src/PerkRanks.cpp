@@ -0,0 +1,83 @@
+#include "PerkRanks.h"
+#include "FormKey.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	PerkRankTable::PerkRankTable() :
+		table(VANILLA_PERK_RANKS.begin(), VANILLA_PERK_RANKS.end())
+	{
+	}
+
+	void PerkRankTable::Load()
+	{
+		logger::info("{:*^30}", "LOADING CASTING PERKS");
+
+		const auto dataHandler = RE::TESDataHandler::GetSingleton();
+		if (!dataHandler) {
+			logger::error("Failed to fetch TESDataHandler!");
+			return;
+		}
+
+		std::unordered_map<RE::FormID, std::int8_t> ranks;
+		for (const auto& entry : VANILLA_PERK_RANKS)
+			ranks.insert_or_assign(entry.perk, entry.rank);
+
+		std::size_t loadedEntries = 0;
+		for (const auto& [key, value] : CONFIG::Plugin::GetSingleton().GetAllKeyValuePairs("CASTINGPERKS")) {
+			const auto perkKey = ParseFormKey(key);
+			if (perkKey == INVALID_FORM_KEY) {
+				logger::warn("Invalid format. Ignoring {}", key);
+				continue;
+			}
+
+			const auto perkFormID = ResolveFormKey(perkKey);
+			if (perkFormID == 0x0) {
+				logger::info("Perk {} not loaded. Ignoring.", key);
+				continue;
+			}
+
+			int rank = 0;
+			std::from_chars(value.data(), value.data() + value.size(), rank);
+			rank = std::clamp(rank, 0, 5);
+			ranks.insert_or_assign(perkFormID, static_cast<std::int8_t>(rank));
+			++loadedEntries;
+		}
+
+		table.clear();
+		table.reserve(ranks.size());
+		for (const auto& [perk, rank] : ranks)
+			table.push_back({ perk, rank });
+		std::ranges::sort(table, {}, &Entry::perk);
+
+		{
+			std::scoped_lock guard(memoLock);
+			memo.clear();
+		}
+
+		logger::info("Loaded {} casting perks ({} from INI).\n", table.size(), loadedEntries);
+	}
+
+	int PerkRankTable::GetRankForPerk(RE::FormID perk) const
+	{
+		auto it = std::ranges::lower_bound(table, perk, {}, &Entry::perk);
+		return it != table.end() && it->perk == perk ? it->rank : 0;
+	}
+
+	int PerkRankTable::GetRank(const RE::SpellItem* spell)
+	{
+		if (!spell || !spell->data.castingPerk)
+			return 0;
+
+		{
+			std::scoped_lock guard(memoLock);
+			if (auto it = memo.find(spell); it != memo.end())
+				return it->second;
+		}
+
+		const auto rank = GetRankForPerk(spell->data.castingPerk->GetFormID());
+		std::scoped_lock guard(memoLock);
+		memo.insert_or_assign(spell, static_cast<std::int8_t>(rank));
+		return rank;
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "VanillaPerkRanks.h"
+
+namespace SCRIBE
+{
+	// Maps casting perks to spell ranks (1 = Novice ... 5 = Master, 0 = unknown/"Strange").
+	// Vanilla perks are built in; perk overhauls add or override entries in the [CASTINGPERKS] INI section
+	// as "Plugin.esp~0xLocalID = rank". Lookups are a binary search over a flat table, memoized per spell.
+	class PerkRankTable
+	{
+	public:
+		using Entry = PerkRank;
+
+		static PerkRankTable& GetSingleton()
+		{
+			static PerkRankTable instance;
+			return instance;
+		}
+
+		// Resolves the INI entries against the loaded plugins. Call at kDataLoaded, before any rank is queried.
+		void Load();
+		int GetRank(const RE::SpellItem* spell);
+		int GetRankForPerk(RE::FormID perk) const;
+
+		PerkRankTable(PerkRankTable const&) = delete;
+		void operator=(PerkRankTable const&) = delete;
+
+	private:
+		PerkRankTable();
+
+		std::vector<Entry> table;
+
+		std::mutex memoLock;
+		std::unordered_map<const RE::SpellItem*, std::int8_t> memo;
+	};
+}
@@ -0,0 +1,339 @@
+#include "PluginExport.h"
+#include "PluginWriter.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	namespace ESP
+	{
+		namespace
+		{
+			constexpr auto SECTION = "EXPORTED"sv;
+			constexpr auto NEXT_ID_KEY = "NextID"sv;  // not a FormKey, so LoadScrollIDs skips it
+			constexpr std::uint32_t FIRST_LOCAL_ID = 0x800;
+			constexpr std::uint32_t LAST_LIGHT_ID = 0xFFF;
+
+			std::unordered_map<FormKey, RE::FormID> LoadScrollIDs()
+			{
+				std::unordered_map<FormKey, RE::FormID> result;
+				for (const auto& [key, value] : CONFIG::Plugin::GetSingleton().GetAllKeyValuePairs(std::string(SECTION))) {
+					const auto bookKey = ParseFormKey(key);
+					if (bookKey == INVALID_FORM_KEY)
+						continue;
+					try {
+						result.insert_or_assign(bookKey, UTIL::lexical_cast_formid(value));
+					} catch (const std::invalid_argument&) {
+						logger::warn("[EXPORTED] Ignored malformed ID {} for {}", value, key);
+					}
+				}
+				return result;
+			}
+
+			bool IsFormParameter(RE::FUNCTION_DATA::FunctionID function)
+			{
+				using Function = RE::FUNCTION_DATA::FunctionID;
+				return function == Function::kHasSpell || function == Function::kGetGlobalValue || function == Function::kHasPerk;
+			}
+
+			// Maps forms to FormIDs as the exported file must store them: the high byte indexes its master list,
+			// and the plugin's own records come right after the last master. Forms without a plugin (created at
+			// runtime) cannot be referenced and resolve to 0.
+			class FormResolver
+			{
+			public:
+				void AddExported(const RE::TESForm* form, std::uint32_t localID) { exported.emplace(form, localID); }
+
+				// Sorts the masters seen so far into load order; forms first seen after this resolve to 0.
+				void FinalizeMasters()
+				{
+					std::vector<const RE::TESFile*> ordered;
+					for (const auto file : RE::TESDataHandler::GetSingleton()->files) {
+						if (masterIndex.contains(file)) {
+							masterIndex[file] = static_cast<std::uint32_t>(ordered.size());
+							ordered.push_back(file);
+						}
+					}
+					masters = std::move(ordered);
+					finalized = true;
+					unresolved = 0;
+				}
+
+				std::uint32_t operator()(const RE::TESForm* form)
+				{
+					if (!form)
+						return 0;
+					if (auto it = exported.find(form); it != exported.end())
+						return (static_cast<std::uint32_t>(masters.size()) << 24) | it->second;
+
+					const auto file = form->GetFile(0);
+					if (!file) {
+						++unresolved;
+						return 0;
+					}
+					if (!finalized) {
+						masterIndex.try_emplace(file, 0);
+						return 0;
+					}
+					const auto it = masterIndex.find(file);
+					if (it == masterIndex.end()) {
+						++unresolved;
+						return 0;
+					}
+					return (it->second << 24) | form->GetLocalFormID();
+				}
+
+				std::vector<std::string> GetMasterNames() const
+				{
+					std::vector<std::string> names;
+					names.reserve(masters.size());
+					for (const auto file : masters)
+						names.emplace_back(file->GetFilename());
+					return names;
+				}
+
+				std::size_t GetUnresolvedCount() const { return unresolved; }
+
+			private:
+				std::unordered_map<const RE::TESForm*, std::uint32_t> exported;
+				std::unordered_map<const RE::TESFile*, std::uint32_t> masterIndex;
+				std::vector<const RE::TESFile*> masters;
+				std::size_t unresolved = 0;
+				bool finalized = false;
+			};
+
+			struct ExportEntry
+			{
+				CATALOG::ScrollID id;
+				std::uint32_t localID;
+			};
+
+			void WriteScroll(PluginWriter& writer, FormResolver& resolve, const RE::ScrollItem* scroll, std::uint32_t localID)
+			{
+				writer.BeginRecord(MakeSignature("SCRL"), resolve(scroll));
+				writer.AddString(MakeSignature("EDID"), std::format("_scrGenScroll{:03X}", localID));
+				writer.AddFields(MakeSignature("OBND"), std::array<std::int16_t, 6>{});
+				writer.AddString(MakeSignature("FULL"), scroll->GetFullName());
+
+				if (scroll->numKeywords > 0) {
+					std::vector<std::uint32_t> keywords;
+					keywords.reserve(scroll->numKeywords);
+					for (std::uint32_t i = 0; i < scroll->numKeywords; i++)
+						keywords.push_back(resolve(scroll->keywords[i]));
+					writer.AddFields(MakeSignature("KSIZ"), static_cast<std::uint32_t>(keywords.size()));
+					writer.AddSubrecord(MakeSignature("KWDA"), std::as_bytes(std::span(keywords)));
+				}
+
+				writer.AddFields(MakeSignature("MDOB"), resolve(scroll->menuDispObject));
+				writer.AddFields(MakeSignature("ETYP"), resolve(scroll->GetEquipSlot()));
+				writer.AddString(MakeSignature("MODL"), scroll->GetModel());
+				writer.AddFields(MakeSignature("DATA"), static_cast<std::uint32_t>(scroll->value), scroll->weight);
+
+				const auto& data = scroll->SpellItem::data;
+				writer.AddFields(MakeSignature("SPIT"),
+					static_cast<std::uint32_t>(data.costOverride),
+					static_cast<std::uint32_t>(data.flags.underlying()),
+					std::to_underlying(data.spellType),
+					data.chargeTime,
+					std::to_underlying(data.castingType),
+					std::to_underlying(data.delivery),
+					data.castDuration,
+					data.range,
+					resolve(data.castingPerk));
+
+				// Effect conditions are not written: the effects are relinked to the spell's own on every load.
+				for (const auto eff : scroll->effects) {
+					if (!eff)
+						continue;
+					writer.AddFields(MakeSignature("EFID"), resolve(eff->baseEffect));
+					writer.AddFields(MakeSignature("EFIT"), eff->effectItem.magnitude, eff->effectItem.area, eff->effectItem.duration);
+				}
+				writer.EndRecord();
+			}
+
+			void WriteRecipe(PluginWriter& writer, FormResolver& resolve, const RE::BGSConstructibleObject* cobj, std::uint32_t localID)
+			{
+				writer.BeginRecord(MakeSignature("COBJ"), resolve(cobj));
+				writer.AddString(MakeSignature("EDID"), std::format("_scrGenRecipe{:03X}", localID));
+
+				const auto& items = cobj->requiredItems;
+				writer.AddFields(MakeSignature("COCT"), items.numContainerObjects);
+				for (std::uint32_t i = 0; i < items.numContainerObjects; i++) {
+					const auto item = items.containerObjects[i];
+					writer.AddFields(MakeSignature("CNTO"), resolve(item->obj), item->count);
+				}
+
+				for (auto node = cobj->conditions.head; node; node = node->next) {
+					const auto& cond = node->data;
+					const auto function = cond.functionData.function.get();
+					const auto flags = static_cast<std::uint8_t>(
+						(cond.flags.isOR ? 0x01 : 0x00) | (cond.flags.global ? 0x04 : 0x00) | (std::to_underlying(cond.flags.opCode) << 5));
+					const auto comparison = cond.flags.global ? std::bit_cast<float>(resolve(cond.comparisonValue.g)) : cond.comparisonValue.f;
+					const auto param = IsFormParameter(function) ? resolve(static_cast<const RE::TESForm*>(cond.functionData.params[0])) : 0u;
+
+					writer.AddFields(MakeSignature("CTDA"),
+						flags, std::array<std::uint8_t, 3>{},
+						comparison,
+						std::to_underlying(function), std::uint16_t(0),
+						param, std::uint32_t(0),
+						std::uint32_t(0),   // run on subject
+						std::uint32_t(0),   // reference
+						std::int32_t(-1));  // no alias or package data
+				}
+
+				writer.AddFields(MakeSignature("CNAM"), resolve(cobj->createdItem));
+				writer.AddFields(MakeSignature("BNAM"), resolve(cobj->benchKeyword));
+				writer.AddFields(MakeSignature("NAM1"), cobj->data.numConstructed);
+				writer.EndRecord();
+			}
+
+			void WriteRecords(PluginWriter& writer, FormResolver& resolve, const std::vector<ExportEntry>& entries, std::uint32_t firstRecipeID)
+			{
+				const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+
+				writer.BeginGroup(MakeSignature("SCRL"));
+				for (const auto& entry : entries)
+					WriteScroll(writer, resolve, catalog.GetScroll(entry.id), entry.localID);
+				writer.EndGroup();
+
+				writer.BeginGroup(MakeSignature("COBJ"));
+				auto recipeID = firstRecipeID;
+				for (const auto& entry : entries)
+					for (const auto cobj : catalog.GetConstructibles(entry.id))
+						WriteRecipe(writer, resolve, cobj, recipeID++);
+				writer.EndGroup();
+			}
+		}
+
+		ExportedPlugin::ExportedPlugin() :
+			file(RE::TESDataHandler::GetSingleton()->LookupModByName(EXPORT_PLUGIN_NAME))
+		{
+			if (!file)
+				return;
+
+			scrollIDs = LoadScrollIDs();
+			for (const auto cobj : RE::TESDataHandler::GetSingleton()->GetFormArray<RE::BGSConstructibleObject>()) {
+				if (cobj && cobj->createdItem && cobj->GetFile(0) == file)
+					recipes[cobj->createdItem].push_back(cobj);
+			}
+			logger::info("Found {} with {} scrolls in [EXPORTED]", EXPORT_PLUGIN_NAME, scrollIDs.size());
+		}
+
+		RE::ScrollItem* ExportedPlugin::FindScroll(FormKey bookKey) const
+		{
+			const auto it = scrollIDs.find(bookKey);
+			if (it == scrollIDs.end())
+				return nullptr;
+			return RE::TESDataHandler::GetSingleton()->LookupForm<RE::ScrollItem>(it->second, EXPORT_PLUGIN_NAME);
+		}
+
+		std::vector<RE::BGSConstructibleObject*> ExportedPlugin::GetConstructibles(const RE::ScrollItem* scroll) const
+		{
+			const auto it = recipes.find(scroll);
+			return it != recipes.end() ? it->second : std::vector<RE::BGSConstructibleObject*>{};
+		}
+
+		std::size_t ExportedPlugin::CountUnclaimed(const std::unordered_set<FormKey>& generated) const
+		{
+			return std::ranges::count_if(scrollIDs, [&](const auto& entry) { return !generated.contains(entry.first); });
+		}
+
+		bool ExportGeneratedForms()
+		{
+			logger::info("{:*^30}", "EXPORTING PLUGIN");
+
+			auto& ini = CONFIG::Plugin::GetSingleton();
+			const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+
+			// Tomes keep their scroll's ID from earlier exports; new tomes get IDs above every ID handed out so far,
+			// including those of dropped tomes, so a save never sees an old scroll ID turn into another scroll.
+			auto scrollIDs = LoadScrollIDs();
+			std::uint32_t nextID = FIRST_LOCAL_ID;
+			if (const auto saved = ini.GetValue(std::string(SECTION), std::string(NEXT_ID_KEY)); !saved.empty()) {
+				try {
+					nextID = std::max<std::uint32_t>(nextID, UTIL::lexical_cast_formid(saved));
+				} catch (const std::invalid_argument&) {
+					logger::warn("[EXPORTED] Ignored malformed {} {}", NEXT_ID_KEY, saved);
+				}
+			}
+			for (const auto& [bookKey, localID] : scrollIDs)
+				nextID = std::max<std::uint32_t>(nextID, localID + 1);
+
+			std::vector<ExportEntry> entries;
+			std::unordered_set<FormKey> exportedKeys;
+			std::size_t recipeCount = 0;
+			FormResolver resolve;
+			for (CATALOG::ScrollID id = 0; id < catalog.size(); id++) {
+				const auto scroll = catalog.GetScroll(id);
+				const auto bookKey = GetFormKey(catalog.GetBook(id));
+				if (!scroll || catalog.GetOrigin(id) != CATALOG::Origin::kGenerated || bookKey == INVALID_FORM_KEY)
+					continue;
+
+				auto [it, inserted] = scrollIDs.try_emplace(bookKey, nextID);
+				if (inserted) {
+					++nextID;
+					ini.SetValue(std::string(SECTION), FormatFormKey(bookKey), std::format("0x{:03X}", it->second), std::format("# {}", catalog.GetBook(id)->GetName()));
+				}
+				resolve.AddExported(scroll, it->second);
+				entries.push_back({ id, it->second });
+				exportedKeys.insert(bookKey);
+				recipeCount += catalog.GetConstructibles(id).size();
+			}
+
+			// Tomes that are filtered out or gone would otherwise be matched against the new file on later boots.
+			std::vector<std::string> droppedKeys;
+			for (const auto& [key, value] : ini.GetAllKeyValuePairs(std::string(SECTION))) {
+				const auto bookKey = ParseFormKey(key);
+				if (bookKey != INVALID_FORM_KEY && !exportedKeys.contains(bookKey))
+					droppedKeys.emplace_back(key);
+			}
+			for (const auto& key : droppedKeys)
+				ini.DeleteKey(std::string(SECTION), key);
+			if (!droppedKeys.empty())
+				logger::info("Dropped {} tomes from [EXPORTED] that are no longer generated", droppedKeys.size());
+			ini.SetValue(std::string(SECTION), std::string(NEXT_ID_KEY), std::format("0x{:03X}", nextID), "# First scroll ID for new tomes");
+
+			const auto firstRecipeID = nextID;
+			auto recipeID = firstRecipeID;
+			for (const auto& entry : entries)
+				for (const auto cobj : catalog.GetConstructibles(entry.id))
+					resolve.AddExported(cobj, recipeID++);
+
+			// Light plugins only address 0x800-0xFFF; larger exports fall back to a regular plugin.
+			const bool light = recipeID - 1 <= LAST_LIGHT_ID;
+			if (!light)
+				logger::warn("{} forms do not fit a light plugin; {} will take a full load order slot", entries.size() + recipeCount, EXPORT_PLUGIN_NAME);
+
+			// First pass only discovers the masters; their load order decides the FormIDs of the real pass.
+			{
+				PluginWriter discovery;
+				WriteRecords(discovery, resolve, entries, firstRecipeID);
+			}
+			resolve.FinalizeMasters();
+
+			PluginWriter writer;
+			const auto masters = resolve.GetMasterNames();
+			writer.WriteHeader(light ? PluginWriter::FLAG_LIGHT : 0, masters, recipeID, "ScrollScribeNG");
+			WriteRecords(writer, resolve, entries, firstRecipeID);
+			writer.Finish();
+
+			if (resolve.GetUnresolvedCount() > 0)
+				logger::warn("{} references to runtime forms were written as null", resolve.GetUnresolvedCount());
+
+			const auto path = std::filesystem::path("Data") / EXPORT_PLUGIN_NAME;
+			if (!writer.Save(path)) {
+				logger::error("Failed to write {}", path.string());
+				return false;
+			}
+			// The file and its [EXPORTED] IDs must agree even if the game is closed before the next save.
+			ini.Save();
+
+			logger::info("Exported {} scrolls and {} recipes with {} masters to {} ({} bytes). Enable it in the load order to skip generation on later boots.\n",
+				entries.size(),
+				recipeCount,
+				masters.size(),
+				path.string(),
+				writer.GetData().size());
+			return true;
+		}
+	}
+}
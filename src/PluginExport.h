@@ -0,0 +1,35 @@
+#pragma once
+
+#include "FormKey.h"
+
+namespace SCRIBE
+{
+	namespace ESP
+	{
+		constexpr std::string_view EXPORT_PLUGIN_NAME = "ScribeGenerated.esp";
+
+		// The exported plugin as loaded this session. Its scrolls are found by tome through [EXPORTED],
+		// so GenerateDynamicScrolls can reuse them instead of creating runtime forms.
+		class ExportedPlugin
+		{
+		public:
+			// Indexes the plugin if it is in the load order; otherwise IsLoaded() is false.
+			ExportedPlugin();
+
+			bool IsLoaded() const { return file != nullptr; }
+			RE::ScrollItem* FindScroll(FormKey bookKey) const;
+			std::vector<RE::BGSConstructibleObject*> GetConstructibles(const RE::ScrollItem* scroll) const;
+			// [EXPORTED] tomes missing from `generated`: filtered out or gone from the load order since the export.
+			std::size_t CountUnclaimed(const std::unordered_set<FormKey>& generated) const;
+
+		private:
+			const RE::TESFile* file = nullptr;
+			std::unordered_map<FormKey, RE::FormID> scrollIDs;
+			std::unordered_map<const RE::TESForm*, std::vector<RE::BGSConstructibleObject*>> recipes;
+		};
+
+		// Writes every generated catalog entry's scroll and recipes into Data/ScribeGenerated.esp.
+		// Scroll FormIDs are kept in [EXPORTED] and stay stable across exports; tomes no longer generated are dropped.
+		bool ExportGeneratedForms();
+	}
+}
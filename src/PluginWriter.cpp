@@ -0,0 +1,121 @@
+#include "PluginWriter.h"
+
+namespace SCRIBE
+{
+	namespace ESP
+	{
+		namespace
+		{
+			constexpr std::size_t HEADER_SIZE = 24;
+			constexpr float HEADER_VERSION = 1.7f;
+		}
+
+		void PluginWriter::PutSignature(Signature type)
+		{
+			for (const auto c : type)
+				buffer.push_back(static_cast<std::byte>(c));
+		}
+
+		void PluginWriter::WriteHeader(std::uint32_t flags, std::span<const std::string> masters, std::uint32_t nextObjectID, std::string_view author)
+		{
+			BeginRecord(MakeSignature("TES4"), 0, flags);
+			--objectCount;  // the header does not count itself
+
+			// HEDR: version, number of records and groups (patched in Finish), next object ID
+			std::array<std::byte, 12> hedr{};
+			std::memcpy(hedr.data(), &HEADER_VERSION, sizeof(float));
+			std::memcpy(hedr.data() + 8, &nextObjectID, sizeof(std::uint32_t));
+			AddSubrecord(MakeSignature("HEDR"), hedr);
+			recordCountOffset = buffer.size() - 8;
+
+			AddString(MakeSignature("CNAM"), author);
+			for (const auto& master : masters) {
+				AddString(MakeSignature("MAST"), master);
+				AddFields(MakeSignature("DATA"), std::uint64_t(0));
+			}
+			EndRecord();
+		}
+
+		void PluginWriter::BeginGroup(Signature label)
+		{
+			openGroups.push_back(buffer.size());
+			PutSignature(MakeSignature("GRUP"));
+			Put<std::uint32_t>(0);  // size, patched in EndGroup
+			PutSignature(label);
+			Put<std::int32_t>(0);   // top-level group
+			Put<std::uint16_t>(0);  // timestamp
+			Put<std::uint16_t>(0);  // version control
+			Put<std::uint32_t>(0);
+			++objectCount;
+		}
+
+		void PluginWriter::EndGroup()
+		{
+			const auto start = openGroups.back();
+			openGroups.pop_back();
+			PutAt(start + 4, static_cast<std::uint32_t>(buffer.size() - start));
+		}
+
+		void PluginWriter::BeginRecord(Signature type, std::uint32_t formID, std::uint32_t flags)
+		{
+			openRecord = buffer.size();
+			PutSignature(type);
+			Put<std::uint32_t>(0);  // data size, patched in EndRecord
+			Put(flags);
+			Put(formID);
+			Put<std::uint32_t>(0);  // timestamp and version control
+			Put(FORM_VERSION);
+			Put<std::uint16_t>(0);
+			++objectCount;
+		}
+
+		void PluginWriter::EndRecord()
+		{
+			const auto start = *openRecord;
+			openRecord.reset();
+			PutAt(start + 4, static_cast<std::uint32_t>(buffer.size() - start - HEADER_SIZE));
+		}
+
+		void PluginWriter::AddSubrecord(Signature type, std::span<const std::byte> data)
+		{
+			if (data.size() > 0xFFFF) {
+				PutSignature(MakeSignature("XXXX"));
+				Put<std::uint16_t>(sizeof(std::uint32_t));
+				Put(static_cast<std::uint32_t>(data.size()));
+				PutSignature(type);
+				Put<std::uint16_t>(0);
+			} else {
+				PutSignature(type);
+				Put(static_cast<std::uint16_t>(data.size()));
+			}
+			buffer.insert(buffer.end(), data.begin(), data.end());
+		}
+
+		void PluginWriter::AddString(Signature type, std::string_view text)
+		{
+			std::vector<std::byte> data(text.size() + 1, std::byte{ 0 });
+			std::memcpy(data.data(), text.data(), text.size());
+			AddSubrecord(type, data);
+		}
+
+		void PluginWriter::Finish()
+		{
+			PutAt(recordCountOffset, objectCount);
+		}
+
+		bool PluginWriter::Save(const std::filesystem::path& path) const
+		{
+			// Write next to the target first, so a failed write never leaves a truncated plugin behind.
+			auto temporary = path;
+			temporary += ".tmp";
+			{
+				std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+				if (!out.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+					return false;
+			}
+			std::error_code error;
+			std::filesystem::rename(temporary, path, error);
+			return !error;
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace ESP
+	{
+		using Signature = std::array<char, 4>;
+
+		constexpr Signature MakeSignature(const char (&text)[5])
+		{
+			return { text[0], text[1], text[2], text[3] };
+		}
+
+		// Serializes a Skyrim SE plugin into memory, byte for byte as the Creation Kit lays it out (little endian).
+		// Records and groups are opened and closed like brackets; their sizes are patched on close, and subrecords
+		// over 64 KiB get an XXXX size prefix. No game types, so it is testable on any platform.
+		class PluginWriter
+		{
+		public:
+			static constexpr std::uint32_t FLAG_MASTER = 0x1;
+			static constexpr std::uint32_t FLAG_LIGHT = 0x200;
+			static constexpr std::uint16_t FORM_VERSION = 44;
+
+			// TES4 header; must come first. nextObjectID is the next free local FormID.
+			void WriteHeader(std::uint32_t flags, std::span<const std::string> masters, std::uint32_t nextObjectID, std::string_view author);
+
+			void BeginGroup(Signature label);
+			void EndGroup();
+
+			void BeginRecord(Signature type, std::uint32_t formID, std::uint32_t flags = 0);
+			void EndRecord();
+
+			void AddSubrecord(Signature type, std::span<const std::byte> data);
+			void AddString(Signature type, std::string_view text);  // zero terminated
+
+			template <typename... Fields>
+			requires(std::is_trivially_copyable_v<Fields> && ...)
+			void AddFields(Signature type, const Fields&... fields)
+			{
+				std::array<std::byte, (sizeof(Fields) + ... + 0)> data;
+				std::size_t offset = 0;
+				((std::memcpy(data.data() + offset, &fields, sizeof(Fields)), offset += sizeof(Fields)), ...);
+				AddSubrecord(type, data);
+			}
+
+			// Count of records and groups after the header, as HEDR expects.
+			std::uint32_t GetObjectCount() const { return objectCount; }
+			const std::vector<std::byte>& GetData() const { return buffer; }
+
+			// Writes the header's record count; call once every record is written.
+			void Finish();
+
+			bool Save(const std::filesystem::path& path) const;
+
+		private:
+			template <typename T>
+			void Put(T value)
+			{
+				static_assert(std::endian::native == std::endian::little);
+				const auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+				buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+			}
+
+			template <typename T>
+			void PutAt(std::size_t offset, T value)
+			{
+				std::memcpy(buffer.data() + offset, &value, sizeof(T));
+			}
+
+			void PutSignature(Signature type);
+
+			std::vector<std::byte> buffer;
+			std::vector<std::size_t> openGroups;
+			std::optional<std::size_t> openRecord;
+			std::size_t recordCountOffset = 0;
+			std::uint32_t objectCount = 0;
+		};
+	}
+}
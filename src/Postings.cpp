@@ -0,0 +1,43 @@
+#include "Postings.h"
+
+namespace SCRIBE
+{
+	namespace QUERY
+	{
+		Postings MergePostings(std::span<const Postings> lists)
+		{
+			Postings result;
+			Postings merged;
+			for (const auto& list : lists) {
+				merged.clear();
+				merged.reserve(result.size() + list.size());
+				std::ranges::merge(result, list, std::back_inserter(merged));
+				result.swap(merged);
+			}
+			return result;
+		}
+
+		Postings IntersectPostings(std::span<const Postings*> lists, std::size_t offset, std::size_t count)
+		{
+			if (lists.empty())
+				return {};
+
+			std::ranges::sort(lists, {}, [](const Postings* list) { return list->size(); });
+
+			Postings result = *lists.front();
+			Postings scratch;
+			for (std::size_t i = 1; i < lists.size() && !result.empty(); i++) {
+				scratch.clear();
+				std::ranges::set_intersection(result, *lists[i], std::back_inserter(scratch));
+				result.swap(scratch);
+			}
+
+			if (offset >= result.size())
+				return {};
+
+			auto first = result.begin() + offset;
+			auto last = count == 0 || count >= result.size() - offset ? result.end() : first + count;
+			return { first, last };
+		}
+	}
+}
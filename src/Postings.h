@@ -0,0 +1,17 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace QUERY
+	{
+		// Ascending catalog IDs. Kept free of game types so the host benchmarks can drive it.
+		using Postings = std::vector<std::uint32_t>;
+
+		// Sorted union of disjoint lists, such as one per tier.
+		Postings MergePostings(std::span<const Postings> lists);
+
+		// Intersection of every list, then the [offset, offset + count) page of it; count 0 means the rest.
+		// Lists are reordered smallest-first so the working set only ever shrinks.
+		Postings IntersectPostings(std::span<const Postings*> lists, std::size_t offset, std::size_t count);
+	}
+}
@@ -0,0 +1,129 @@
+#include "Query.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	namespace QUERY
+	{
+		School GetSchoolIndex(RE::ActorValue school)
+		{
+			switch (school) {
+			case RE::ActorValue::kAlteration:
+				return School::kAlteration;
+			case RE::ActorValue::kConjuration:
+				return School::kConjuration;
+			case RE::ActorValue::kDestruction:
+				return School::kDestruction;
+			case RE::ActorValue::kIllusion:
+				return School::kIllusion;
+			case RE::ActorValue::kRestoration:
+				return School::kRestoration;
+			default:
+				return School::kOther;
+			}
+		}
+
+		void ScrollIndex::Build()
+		{
+			const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+
+			all.clear();
+			for (auto& list : bySchool)
+				list.clear();
+			for (auto& list : byTier)
+				list.clear();
+			fireAndForget.clear();
+			concentration.clear();
+			byKeyword.clear();
+
+			const auto spells = catalog.Spells();
+			const auto schools = catalog.Schools();
+			const auto tiers = catalog.Tiers();
+			const auto concFlags = catalog.Concentration();
+
+			// IDs are visited in ascending order, so every list below comes out sorted.
+			for (CATALOG::ScrollID id = 0; id < catalog.size(); id++) {
+				if (catalog.FindBySpell(spells[id]) != id)  // superseded by a later tome teaching the same spell
+					continue;
+
+				all.push_back(id);
+				bySchool[static_cast<std::size_t>(GetSchoolIndex(schools[id]))].push_back(id);
+				byTier[static_cast<std::size_t>(tiers[id])].push_back(id);
+				if (concFlags[id])
+					concentration.push_back(id);
+				else
+					fireAndForget.push_back(id);
+			}
+
+			for (const auto& [kywd, spellList] : *SCRIBE::CACHE::KeywordSpellListMap.Load()) {
+				Postings postings;
+				postings.reserve(spellList.size());
+				for (const auto& spell : spellList) {
+					auto id = catalog.FindBySpell(spell);
+					if (id != CATALOG::INVALID_SCROLL_ID)
+						postings.push_back(id);
+				}
+				if (postings.empty())
+					continue;
+
+				std::ranges::sort(postings);
+				postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+				byKeyword.insert_or_assign(kywd, std::move(postings));
+			}
+
+			logger::info("Indexed {} scrolls under {} effect keywords.\n", all.size(), byKeyword.size());
+		}
+
+		std::vector<CATALOG::ScrollID> ScrollIndex::Find(const ScrollFilter& filter, std::size_t offset, std::size_t count) const
+		{
+			constexpr auto maxTierIndex = static_cast<std::int32_t>(CATALOG::Tier::kTotal) - 1;
+
+			std::vector<const Postings*> lists;
+			Postings tierUnion;
+
+			if (filter.school != ANY) {
+				if (filter.school < 0 || filter.school >= static_cast<std::int32_t>(School::kOther))
+					return {};
+				lists.push_back(&bySchool[filter.school]);
+			}
+
+			if (filter.castingType != ANY) {
+				switch (static_cast<RE::MagicSystem::CastingType>(filter.castingType)) {
+				case RE::MagicSystem::CastingType::kFireAndForget:
+					lists.push_back(&fireAndForget);
+					break;
+				case RE::MagicSystem::CastingType::kConcentration:
+					lists.push_back(&concentration);
+					break;
+				default:
+					return {};
+				}
+			}
+
+			if (filter.keyword) {
+				auto it = byKeyword.find(filter.keyword);
+				if (it == byKeyword.end())
+					return {};
+				lists.push_back(&it->second);
+			}
+
+			const auto minTier = std::max<std::int32_t>(filter.minTier == ANY ? 0 : filter.minTier, 0);
+			const auto maxTier = std::min<std::int32_t>(filter.maxTier == ANY ? maxTierIndex : filter.maxTier, maxTierIndex);
+			if (minTier > maxTier)
+				return {};
+			if (minTier > 0 || maxTier < maxTierIndex) {
+				if (minTier == maxTier) {
+					lists.push_back(&byTier[minTier]);
+				} else {
+					tierUnion = MergePostings(std::span(byTier).subspan(minTier, maxTier - minTier + 1));
+					lists.push_back(&tierUnion);
+				}
+			}
+
+			if (lists.empty())
+				lists.push_back(&all);
+
+			return IntersectPostings(lists, offset, count);
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Catalog.h"
+#include "Postings.h"
+
+namespace SCRIBE
+{
+	namespace QUERY
+	{
+		constexpr std::int32_t ANY = -1;
+
+		// School filter as passed from Papyrus: 0 = Alteration, 1 = Conjuration, 2 = Destruction, 3 = Illusion, 4 = Restoration.
+		enum class School : std::uint8_t
+		{
+			kAlteration,
+			kConjuration,
+			kDestruction,
+			kIllusion,
+			kRestoration,
+			kOther,
+
+			kTotal
+		};
+
+		struct ScrollFilter
+		{
+			std::int32_t school = ANY;
+			std::int32_t minTier = ANY;
+			std::int32_t maxTier = ANY;
+			std::int32_t castingType = ANY;  // RE::MagicSystem::CastingType value
+			RE::BGSKeyword* keyword = nullptr;
+		};
+
+		// Sorted posting lists of catalog IDs, built once after generation and patching.
+		class ScrollIndex
+		{
+		public:
+			static ScrollIndex& GetSingleton()
+			{
+				static ScrollIndex instance;
+				return instance;
+			}
+
+			void Build();
+			std::vector<CATALOG::ScrollID> Find(const ScrollFilter& filter, std::size_t offset, std::size_t count) const;
+
+			ScrollIndex(ScrollIndex const&) = delete;
+			void operator=(ScrollIndex const&) = delete;
+
+		private:
+			static_assert(std::is_same_v<Postings::value_type, CATALOG::ScrollID>);
+
+			ScrollIndex() = default;
+
+			Postings all;
+			std::array<Postings, static_cast<std::size_t>(School::kTotal)> bySchool;
+			std::array<Postings, static_cast<std::size_t>(CATALOG::Tier::kTotal)> byTier;
+			Postings fireAndForget;
+			Postings concentration;
+			std::unordered_map<const RE::BGSKeyword*, Postings> byKeyword;
+		};
+
+		School GetSchoolIndex(RE::ActorValue school);
+	}
+}
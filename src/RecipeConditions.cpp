@@ -0,0 +1,51 @@
+#include "RecipeConditions.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	namespace CONDITIONS
+	{
+		RecipeChain MakeRecipeChain(std::span<RE::SpellItem* const> spells, float requiredLevel, RE::TESGlobal* filterGlobal, bool dustPerk)
+		{
+			using Function = RE::FUNCTION_DATA::FunctionID;
+			using OpCode = RE::CONDITION_ITEM_DATA::OpCode;
+
+			const auto& forms = FORMS::GetSingleton();
+
+			RecipeChain recipe{ MakeRecipeShape(spells.size()) };
+			recipe.conditions = {
+				{ Function::kGetGlobalValue, forms.GlobScribeLevel, OpCode::kGreaterThanOrEqualTo, requiredLevel },
+				{ Function::kGetGlobalValue, forms.GlobFilterKnown, OpCode::kEqualTo, 0.0f },
+				{ Function::kGetGlobalValue, filterGlobal, OpCode::kEqualTo, 1.0f },
+				{ Function::kHasPerk, forms.PerkDustDiscount, OpCode::kEqualTo, dustPerk ? 1.0f : 0.0f },
+			};
+			for (std::size_t i = kFirstSpell; i < recipe.chain.predicates.size(); i++)
+				recipe.conditions.push_back({ Function::kHasSpell, spells[i - kFirstSpell], OpCode::kEqualTo, 1.0f });
+			return recipe;
+		}
+
+		RE::TESConditionItem* Build(const Chain& chain, std::span<const Condition> conditions)
+		{
+			RE::TESConditionItem* head = nullptr;
+			RE::TESConditionItem* tail = nullptr;
+			for (const auto& item : chain.items) {
+				const auto& condition = conditions[item.predicate];
+
+				auto node = new RE::TESConditionItem;
+				node->next = nullptr;
+				node->data.comparisonValue.f = condition.comparison;
+				node->data.flags.opCode = condition.opCode;
+				node->data.functionData.function = condition.function;
+				node->data.functionData.params[0] = condition.param;
+				node->data.flags.isOR = item.isOR;
+
+				if (tail)
+					tail->next = node;
+				else
+					head = node;
+				tail = node;
+			}
+			return head;
+		}
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "ConditionChain.h"
+
+namespace SCRIBE
+{
+	namespace CONDITIONS
+	{
+		// The game condition behind a Predicate.
+		struct Condition
+		{
+			RE::FUNCTION_DATA::FunctionID function;
+			void* param;
+			RE::CONDITION_ITEM_DATA::OpCode opCode;
+			float comparison;
+		};
+
+		// A recipe's chain and, for each of its predicates, the condition it evaluates.
+		struct RecipeChain
+		{
+			Chain chain;
+			std::vector<Condition> conditions;
+		};
+
+		// MakeRecipeShape over the given spells (at most MAX_RECIPE_SPELLS of them) and forms.
+		RecipeChain MakeRecipeChain(std::span<RE::SpellItem* const> spells, float requiredLevel, RE::TESGlobal* filterGlobal, bool dustPerk);
+
+		RE::TESConditionItem* Build(const Chain& chain, std::span<const Condition> conditions);
+	}
+}
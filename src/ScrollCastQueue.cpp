@@ -0,0 +1,83 @@
+#include "ScrollCastQueue.h"
+
+namespace SCRIBE
+{
+	std::uint64_t ScrollCastQueue::Now()
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	void ScrollCastQueue::SetInterval(std::chrono::milliseconds newInterval)
+	{
+		interval.store(static_cast<std::uint64_t>(std::max<std::int64_t>(newInterval.count(), 0)), std::memory_order_relaxed);
+	}
+
+	void ScrollCastQueue::Push(RE::FormID scroll, RE::FormID caster)
+	{
+		if (!ring.TryPush({ scroll, caster, Now() })) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		queued.fetch_add(1, std::memory_order_release);
+		ScheduleDispatch();
+	}
+
+	std::vector<ScrollCastQueue::Cast> ScrollCastQueue::Drain(std::size_t maxCount)
+	{
+		std::vector<Cast> batch;
+		batch.reserve(std::min<std::size_t>(maxCount, queued.load(std::memory_order_acquire)));
+
+		{
+			std::scoped_lock guard(drainLock);
+			Cast cast;
+			while (batch.size() < maxCount && ring.TryPop(cast))
+				batch.push_back(cast);
+		}
+
+		// Casts left behind by a partial drain get their own batch event; nothing else would announce them
+		// until the next cast is pushed.
+		if (queued.fetch_sub(batch.size(), std::memory_order_acq_rel) > batch.size() && !batch.empty())
+			ScheduleDispatch();
+		return batch;
+	}
+
+	void ScrollCastQueue::ScheduleDispatch()
+	{
+		if (dispatchPending.exchange(true, std::memory_order_acq_rel))
+			return;
+		if (const auto taskInterface = SKSE::GetTaskInterface())
+			taskInterface->AddTask([this]() { Dispatch(); });
+		else
+			dispatchPending.store(false, std::memory_order_release);
+	}
+
+	void ScrollCastQueue::Dispatch()
+	{
+		const auto count = queued.load(std::memory_order_acquire);
+		if (count == 0) {
+			dispatchPending.store(false, std::memory_order_release);
+			// A cast may have been queued after the count was read but before the flag was cleared.
+			if (queued.load(std::memory_order_acquire) != 0)
+				ScheduleDispatch();
+			return;
+		}
+
+		const auto wait = interval.load(std::memory_order_relaxed);
+		if (wait != 0) {
+			std::unique_lock guard(drainLock);
+			const auto oldest = ring.Peek();
+			if (oldest && Now() - oldest->timestamp < wait) {
+				guard.unlock();
+				SKSE::GetTaskInterface()->AddTask([this]() { Dispatch(); });
+				return;
+			}
+		}
+
+		// Casts queued from here on schedule their own dispatch.
+		dispatchPending.store(false, std::memory_order_seq_cst);
+
+		SKSE::ModCallbackEvent batchEvent{ "ScrollCastBatch" };
+		batchEvent.numArg = static_cast<float>(queued.load(std::memory_order_acquire));
+		SKSE::GetModCallbackEventSource()->SendEvent(&batchEvent);
+	}
+}
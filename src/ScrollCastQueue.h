@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Concurrent.h"
+
+namespace SCRIBE
+{
+	// Scroll casts queued by the spell cast sink and handed to scripts in batches.
+	// Instead of one mod event per cast, a single "ScrollCastBatch" event (numArg = queued casts) is sent at most
+	// once per frame, and scripts collect the casts with DrainScrollCasts.
+	class ScrollCastQueue
+	{
+	public:
+		static constexpr std::size_t CAPACITY = 1024;
+
+		struct Cast
+		{
+			RE::FormID scroll;
+			RE::FormID caster;
+			std::uint64_t timestamp;  // steady clock, ms
+		};
+
+		static ScrollCastQueue& GetSingleton()
+		{
+			static ScrollCastQueue instance;
+			return instance;
+		}
+
+		// A batch is held back until its oldest cast is this old. 0 = send on the next frame.
+		void SetInterval(std::chrono::milliseconds interval);
+
+		// Any thread, lock-free. Drops the cast (and counts it) when the queue is full.
+		void Push(RE::FormID scroll, RE::FormID caster);
+
+		std::vector<Cast> Drain(std::size_t maxCount);
+		std::uint64_t GetDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+		ScrollCastQueue(ScrollCastQueue const&) = delete;
+		void operator=(ScrollCastQueue const&) = delete;
+
+	private:
+		ScrollCastQueue() = default;
+
+		static std::uint64_t Now();
+		void ScheduleDispatch();
+		void Dispatch();
+
+		MPSCRing<Cast, CAPACITY> ring;
+		std::mutex drainLock;  // serializes the single consumer
+		std::atomic<std::size_t> queued{ 0 };
+		std::atomic<std::uint64_t> dropped{ 0 };
+		std::atomic<bool> dispatchPending{ false };
+		std::atomic<std::uint64_t> interval{ 0 };
+	};
+}
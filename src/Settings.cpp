@@ -0,0 +1,44 @@
+#include "Settings.h"
+#include "Util.h"
+
+namespace SCRIBE
+{
+	namespace CONFIG
+	{
+		namespace
+		{
+			Settings settings;
+		}
+
+		const Settings& GetSettings()
+		{
+			return settings;
+		}
+
+		void LoadSettings(std::uint32_t iniVersion)
+		{
+			auto& ini = Plugin::GetSingleton();
+
+			for (const auto& setting : SETTINGS_SCHEMA) {
+				const std::string key(setting.key);
+
+				if (!ini.HasKey("SETTINGS", key)) {
+					if (setting.introduced > iniVersion)
+						logger::info("Added {} (v{:02X})", setting.key, setting.introduced);
+					else
+						logger::info("Defaulted {}", setting.key);
+
+					if (setting.type == SettingDescriptor::Type::kBool)
+						ini.SetBoolValue("SETTINGS", key, setting.defaultValue != 0, std::string(setting.comment));
+					else
+						ini.SetLongValue("SETTINGS", key, setting.defaultValue, std::string(setting.comment));
+				}
+
+				if (setting.type == SettingDescriptor::Type::kBool)
+					settings.*setting.boolField = ini.GetBoolValue("SETTINGS", key);
+				else
+					settings.*setting.longField = ini.GetLongValue("SETTINGS", key);
+			}
+		}
+	}
+}
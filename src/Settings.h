@@ -0,0 +1,86 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace CONFIG
+	{
+		// [SETTINGS] as plain fields. Filled once at kDataLoaded; hot code reads these instead of the INI.
+		struct Settings
+		{
+			bool modSpellChargingTime = true;
+			bool patchVanillaScrolls = true;
+			bool applyScrollMismatchFix = true;
+			bool patchSoulgems = true;
+			bool generate10xRecipes = false;
+			bool restoreLegacyFusions = true;
+			bool traceNativeCalls = false;
+			bool coalesceScrollCasts = false;
+			bool deduplicateSpellTomes = false;
+			bool deduplicateEquivalentSpells = false;
+			bool fuzzyMatchScrolls = true;
+			bool exportGeneratedPlugin = false;
+			long zeroCostCacheSize = 0;
+			long zeroCostPrewarmCount = 0;
+			long scrollCastBatchInterval = 0;
+		};
+
+		struct SettingDescriptor
+		{
+			enum class Type : std::uint8_t
+			{
+				kBool,
+				kLong
+			};
+
+			std::string_view key;
+			Type type;
+			bool Settings::*boolField;
+			long Settings::*longField;
+			long defaultValue;
+			std::string_view comment;
+			std::uint32_t introduced;  // INI version that added the key
+
+			static constexpr SettingDescriptor Bool(std::string_view key, bool Settings::*field, bool defaultValue, std::string_view comment, std::uint32_t introduced)
+			{
+				return { key, Type::kBool, field, nullptr, defaultValue, comment, introduced };
+			}
+
+			static constexpr SettingDescriptor Long(std::string_view key, long Settings::*field, long defaultValue, std::string_view comment, std::uint32_t introduced)
+			{
+				return { key, Type::kLong, nullptr, field, defaultValue, comment, introduced };
+			}
+		};
+
+		inline constexpr auto SETTINGS_SCHEMA = std::to_array<SettingDescriptor>({
+			SettingDescriptor::Bool("ModSpellChargingTime", &Settings::modSpellChargingTime, true, "# If true, will make concentration spells/scrolls charge up instantly. Might not affect master-tier spells.", 0),
+			SettingDescriptor::Bool("PatchVanillaScrolls", &Settings::patchVanillaScrolls, true, "# If true, will attempt to integrate vanilla/modded scrolls into Scribe's systems.", 0),
+			SettingDescriptor::Bool("ApplyScrollMismatchFix", &Settings::applyScrollMismatchFix, true, "# If true, will match scroll stats to be the same as their origin spell. This is necessary for certain modpacks that come with incorrectly setup scrolls.", 0),
+			SettingDescriptor::Bool("PatchSoulgems", &Settings::patchSoulgems, true, "# If true, will integrate all (non-reusable) soulgems into Scribe's systems.", 0),
+			SettingDescriptor::Bool("Generate10xRecipes", &Settings::generate10xRecipes, false, "# If true, will generate the recipes to craft 10 scrolls at a time. Leave false to declutter the crafting menu.", 0),
+			SettingDescriptor::Long("ZeroCostCacheSize", &Settings::zeroCostCacheSize, 0, "# Number of zero-cost spell copies for scroll casting after which copies prewarmed but never used are rebuilt for other spells instead of creating new ones. 0 = never rebuild. Copies that were used stay cached, one per spell, whatever this is set to.", 4),
+			SettingDescriptor::Bool("RestoreLegacyFusions", &Settings::restoreLegacyFusions, true, "# If true, fusions from the old [FUSION] section are restored for saves made before fusions were stored per save. Each entry is removed once a save has taken it over; this turns itself off when none are left.", 4),
+			SettingDescriptor::Long("ZeroCostPrewarmCount", &Settings::zeroCostPrewarmCount, 0, "# Number of zero-cost spell copies to build in the background after loading, starting with the lowest tiers. 0 = disabled.", 4),
+			SettingDescriptor::Bool("FuzzyMatchScrolls", &Settings::fuzzyMatchScrolls, true, "# If true, vanilla/modded scrolls whose name or effects differ slightly from every spell are still integrated when one spell is a clear, close match.", 4),
+			SettingDescriptor::Bool("DeduplicateSpellTomes", &Settings::deduplicateSpellTomes, false, "# If true, tomes teaching the very same spell share one scroll and one set of recipes. Scrolls that existing saves hold for the other tomes are kept, without recipes.", 4),
+			SettingDescriptor::Bool("DeduplicateEquivalentSpells", &Settings::deduplicateEquivalentSpells, false, "# If true, spells from different tomes that do exactly the same thing (same effects, magnitudes, areas and durations) share one scroll. Implies DeduplicateSpellTomes.", 4),
+			SettingDescriptor::Bool("CoalesceScrollCasts", &Settings::coalesceScrollCasts, false, "# If true, scroll casts are queued and announced with one ScrollCastBatch event per frame instead of one ConcScrollCast/FFScrollCast event per cast. Requires scripts that call DrainScrollCasts.", 4),
+			SettingDescriptor::Long("ScrollCastBatchInterval", &Settings::scrollCastBatchInterval, 0, "# With CoalesceScrollCasts, minimum age in milliseconds of the oldest queued cast before a batch is announced. 0 = every frame.", 4),
+			SettingDescriptor::Bool("ExportGeneratedPlugin", &Settings::exportGeneratedPlugin, false, "# If true, generated scrolls and recipes are written to Data/ScribeGenerated.esp, a light plugin. Once it is enabled in the load order, later boots reuse its forms instead of creating them. It is rewritten whenever the spell tomes change.", 4),
+			SettingDescriptor::Bool("TraceNativeCalls", &Settings::traceNativeCalls, false, "# If true, records every script call to Scribe's native functions into ScrollScribeNG.trace next to the log. Only useful for performance testing.", 4),
+		});
+
+		// Newest INI version any key was introduced in.
+		constexpr std::uint32_t GetSchemaVersion()
+		{
+			std::uint32_t version = 0;
+			for (const auto& setting : SETTINGS_SCHEMA)
+				version = std::max<std::uint32_t>(version, setting.introduced);
+			return version;
+		}
+
+		const Settings& GetSettings();
+
+		// Writes defaults for missing keys (logging the ones newer than iniVersion as added) and reads every field, in one pass.
+		void LoadSettings(std::uint32_t iniVersion);
+	}
+}
@@ -0,0 +1,147 @@
+#include "Stats.h"
+
+namespace SCRIBE
+{
+	namespace STATS
+	{
+		namespace
+		{
+			constexpr std::size_t NATIVE_COUNT = static_cast<std::size_t>(Native::kTotal);
+			constexpr std::size_t CACHE_COUNT = static_cast<std::size_t>(Cache::kTotal);
+
+			using Counter = std::atomic<std::uint64_t>;
+
+			// Single writer, so a relaxed load and store is enough and avoids a locked add.
+			inline void Bump(Counter& counter, std::uint64_t amount = 1)
+			{
+				counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+			}
+
+			// Each native gets its own cache lines so one thread's hot native never shares a line with another's.
+			struct alignas(64) NativeCounters
+			{
+				Counter calls{ 0 };
+				Counter totalNanoseconds{ 0 };
+				std::array<Counter, LATENCY_BUCKETS> buckets{};
+			};
+
+			struct alignas(64) ThreadCounters
+			{
+				std::array<NativeCounters, NATIVE_COUNT> natives;
+				std::array<std::array<Counter, 2>, CACHE_COUNT> caches{};  // [miss, hit]
+			};
+
+			struct Registry
+			{
+				std::mutex lock;
+				std::vector<std::unique_ptr<ThreadCounters>> threads;
+			};
+
+			Registry& GetRegistry()
+			{
+				static Registry registry;
+				return registry;
+			}
+
+			// VM threads live for the whole session, so blocks are never released.
+			ThreadCounters& GetThreadCounters()
+			{
+				thread_local ThreadCounters* counters = [] {
+					auto& registry = GetRegistry();
+					std::scoped_lock guard(registry.lock);
+					return registry.threads.emplace_back(std::make_unique<ThreadCounters>()).get();
+				}();
+				return *counters;
+			}
+
+			std::size_t GetBucket(std::uint64_t nanoseconds)
+			{
+				return std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(nanoseconds)), LATENCY_BUCKETS - 1);
+			}
+		}
+
+		std::uint64_t NativeStats::Percentile(double quantile) const
+		{
+			if (calls == 0)
+				return 0;
+
+			const auto target = static_cast<std::uint64_t>(std::ceil(quantile * static_cast<double>(calls)));
+			std::uint64_t seen = 0;
+			for (std::size_t i = 0; i < LATENCY_BUCKETS; i++) {
+				seen += buckets[i];
+				if (seen >= target)
+					return std::uint64_t(1) << i;
+			}
+			return std::uint64_t(1) << (LATENCY_BUCKETS - 1);
+		}
+
+		void RecordCall(Native native, std::uint64_t nanoseconds)
+		{
+			auto& counters = GetThreadCounters().natives[static_cast<std::size_t>(native)];
+			Bump(counters.calls);
+			Bump(counters.totalNanoseconds, nanoseconds);
+			Bump(counters.buckets[GetBucket(nanoseconds)]);
+		}
+
+		void RecordCache(Cache cache, bool hit)
+		{
+			Bump(GetThreadCounters().caches[static_cast<std::size_t>(cache)][hit]);
+		}
+
+		Snapshot Collect()
+		{
+			Snapshot result{};
+
+			auto& registry = GetRegistry();
+			std::scoped_lock guard(registry.lock);
+			for (const auto& thread : registry.threads) {
+				for (std::size_t n = 0; n < NATIVE_COUNT; n++) {
+					const auto& source = thread->natives[n];
+					auto& target = result.natives[n];
+					target.calls += source.calls.load(std::memory_order_relaxed);
+					target.totalNanoseconds += source.totalNanoseconds.load(std::memory_order_relaxed);
+					for (std::size_t b = 0; b < LATENCY_BUCKETS; b++)
+						target.buckets[b] += source.buckets[b].load(std::memory_order_relaxed);
+				}
+				for (std::size_t c = 0; c < CACHE_COUNT; c++) {
+					result.caches[c].misses += thread->caches[c][0].load(std::memory_order_relaxed);
+					result.caches[c].hits += thread->caches[c][1].load(std::memory_order_relaxed);
+				}
+			}
+			return result;
+		}
+
+		std::vector<std::string> Format(const Snapshot& snapshot)
+		{
+			std::vector<std::string> lines;
+			lines.reserve(NATIVE_COUNT + CACHE_COUNT);
+
+			for (std::size_t n = 0; n < NATIVE_COUNT; n++) {
+				const auto& stats = snapshot.natives[n];
+				if (stats.calls == 0) {
+					lines.push_back(std::format("{}: 0 calls", GetName(static_cast<Native>(n))));
+					continue;
+				}
+				lines.push_back(std::format("{}: {} calls | mean {}ns | p50 <{}ns | p99 <{}ns | max <{}ns",
+					GetName(static_cast<Native>(n)),
+					stats.calls,
+					stats.totalNanoseconds / stats.calls,
+					stats.Percentile(0.5),
+					stats.Percentile(0.99),
+					stats.Percentile(1.0)));
+			}
+
+			for (std::size_t c = 0; c < CACHE_COUNT; c++) {
+				const auto& stats = snapshot.caches[c];
+				const auto total = stats.hits + stats.misses;
+				lines.push_back(std::format("{}: {} hits | {} misses | {:.1f}% hit rate",
+					GetName(static_cast<Cache>(c)),
+					stats.hits,
+					stats.misses,
+					total ? 100.0 * static_cast<double>(stats.hits) / static_cast<double>(total) : 0.0));
+			}
+
+			return lines;
+		}
+	}
+}
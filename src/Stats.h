@@ -0,0 +1,136 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace STATS
+	{
+		enum class Native : std::uint8_t
+		{
+			kFuseAndCreate,
+			kCanFuse,
+			kGetScrollForBook,
+			kGetSpellFromScroll,
+			kGetZeroCostCopy,
+			kGetApproxFullGoldValue,
+			kGetUpgradedSpell,
+			kGetScrollFromSpell,
+			kFindScrolls,
+			kGetApproxFullGoldValues,
+			kGetInventoryGoldValue,
+
+			kTotal
+		};
+
+		enum class Cache : std::uint8_t
+		{
+			kZeroCost,           // ZeroCostPool
+			kFusionComponents,   // FusionComponentsToResultMap
+			kHashToSpellName,    // HashToSpellMap, matched by name hash
+			kHashToSpellEffect,  // HashToSpellMap, matched by effect list hash
+			kFuzzySpellMatch,    // FuzzySpellMatcher, fallback for misses of the two above
+
+			kTotal
+		};
+
+		// Latency buckets are powers of two in nanoseconds: bucket i holds calls that took [2^(i-1), 2^i) ns.
+		constexpr std::size_t LATENCY_BUCKETS = 40;
+
+		struct NativeStats
+		{
+			std::uint64_t calls;
+			std::uint64_t totalNanoseconds;
+			std::array<std::uint64_t, LATENCY_BUCKETS> buckets;
+
+			// Upper bound of the bucket holding the given quantile, in nanoseconds.
+			std::uint64_t Percentile(double quantile) const;
+		};
+
+		struct CacheStats
+		{
+			std::uint64_t hits;
+			std::uint64_t misses;
+		};
+
+		struct Snapshot
+		{
+			std::array<NativeStats, static_cast<std::size_t>(Native::kTotal)> natives;
+			std::array<CacheStats, static_cast<std::size_t>(Cache::kTotal)> caches;
+		};
+
+		// Counters are per thread and only written by their owner; readers merge every thread's block.
+		void RecordCall(Native native, std::uint64_t nanoseconds);
+		void RecordCache(Cache cache, bool hit);
+		Snapshot Collect();
+
+		// One line per native and cache.
+		std::vector<std::string> Format(const Snapshot& snapshot);
+
+		// Names as bound in Papyrus. Inline so the host replay tool can print trace records.
+		constexpr std::string_view GetName(Native native)
+		{
+			switch (native) {
+			case Native::kFuseAndCreate:
+				return "FuseAndCreate"sv;
+			case Native::kCanFuse:
+				return "CanFuse"sv;
+			case Native::kGetScrollForBook:
+				return "GetScrollForBook"sv;
+			case Native::kGetSpellFromScroll:
+				return "GetSpellFromScroll"sv;
+			case Native::kGetZeroCostCopy:
+				return "GetZeroCostCopy"sv;
+			case Native::kGetApproxFullGoldValue:
+				return "GetApproxFullGoldValue"sv;
+			case Native::kGetUpgradedSpell:
+				return "GetUpgradedSpell"sv;
+			case Native::kGetScrollFromSpell:
+				return "GetScrollFromSpell"sv;
+			case Native::kFindScrolls:
+				return "FindScrolls"sv;
+			case Native::kGetApproxFullGoldValues:
+				return "GetApproxFullGoldValues"sv;
+			case Native::kGetInventoryGoldValue:
+				return "GetInventoryGoldValue"sv;
+			default:
+				return "Unknown"sv;
+			}
+		}
+
+		constexpr std::string_view GetName(Cache cache)
+		{
+			switch (cache) {
+			case Cache::kZeroCost:
+				return "ZeroCostPool"sv;
+			case Cache::kFusionComponents:
+				return "FusionComponentsToResultMap"sv;
+			case Cache::kHashToSpellName:
+				return "HashToSpellMap (name)"sv;
+			case Cache::kHashToSpellEffect:
+				return "HashToSpellMap (effects)"sv;
+			case Cache::kFuzzySpellMatch:
+				return "FuzzySpellMatcher"sv;
+			default:
+				return "Unknown"sv;
+			}
+		}
+
+		class ScopedCall
+		{
+		public:
+			explicit ScopedCall(Native native) :
+				native(native), start(std::chrono::steady_clock::now()) {}
+
+			~ScopedCall()
+			{
+				RecordCall(native, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+			}
+
+			ScopedCall(ScopedCall const&) = delete;
+			void operator=(ScopedCall const&) = delete;
+
+		private:
+			Native native;
+			std::chrono::steady_clock::time_point start;
+		};
+	}
+}
@@ -0,0 +1,90 @@
+#include "Trace.h"
+
+namespace SCRIBE
+{
+	namespace TRACE
+	{
+		namespace
+		{
+			constexpr std::size_t FLUSH_THRESHOLD = 64 * 1024;
+
+			template <typename T>
+			void Append(std::vector<char>& buffer, T value)
+			{
+				const auto bytes = std::bit_cast<std::array<char, sizeof(T)>>(value);
+				buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+			}
+		}
+
+		void Recorder::Start(const std::filesystem::path& path)
+		{
+			std::scoped_lock guard(lock);
+			if (active.load(std::memory_order_relaxed))
+				return;
+
+			file.open(path, std::ios::binary | std::ios::trunc);
+			if (!file) {
+				logger::error("Failed to open native trace {}", path.string());
+				return;
+			}
+
+			buffer.reserve(FLUSH_THRESHOLD * 2);
+			buffer.insert(buffer.end(), MAGIC.begin(), MAGIC.end());
+			Append(buffer, VERSION);
+			Append(buffer, std::uint16_t(0));
+
+			epoch = std::chrono::steady_clock::now();
+			active.store(true, std::memory_order_release);
+			logger::info("Recording native calls to {}\n", path.string());
+		}
+
+		std::uint64_t Recorder::Now() const
+		{
+			return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+		}
+
+		void Recorder::Record(std::uint8_t native, std::uint64_t timestamp, std::uint64_t duration, std::span<const std::uint32_t> args, std::uint8_t arrayMask, std::span<const std::uint32_t> payload)
+		{
+			std::scoped_lock guard(lock);
+			if (!active.load(std::memory_order_relaxed))
+				return;  // stopped while the call ran
+			Append(buffer, timestamp);
+			Append(buffer, static_cast<std::uint32_t>(std::min<std::uint64_t>(duration, 0xFFFFFFFF)));
+			Append(buffer, native);
+			Append(buffer, static_cast<std::uint8_t>(args.size()));
+			Append(buffer, arrayMask);
+			for (auto arg : args)
+				Append(buffer, arg);
+			for (auto element : payload)
+				Append(buffer, element);
+
+			if (buffer.size() >= FLUSH_THRESHOLD)
+				FlushLocked();
+		}
+
+		void Recorder::Flush()
+		{
+			if (!IsActive())
+				return;
+			std::scoped_lock guard(lock);
+			FlushLocked();
+			file.flush();
+		}
+
+		void Recorder::Stop()
+		{
+			std::scoped_lock guard(lock);
+			if (!active.load(std::memory_order_relaxed))
+				return;
+			active.store(false, std::memory_order_release);
+			FlushLocked();
+			file.close();
+		}
+
+		void Recorder::FlushLocked()
+		{
+			file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			buffer.clear();
+		}
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "TraceFormat.h"
+
+namespace SCRIBE
+{
+	namespace TRACE
+	{
+		inline std::uint32_t ToTraceArg(const RE::TESForm* form) { return form ? form->GetFormID() : 0x0; }
+
+		template <typename T>
+		requires std::is_integral_v<T>
+		std::uint32_t ToTraceArg(T value)
+		{
+			return static_cast<std::uint32_t>(value);
+		}
+
+		class Recorder
+		{
+		public:
+			static Recorder& GetSingleton()
+			{
+				static Recorder instance;
+				return instance;
+			}
+
+			void Start(const std::filesystem::path& path);
+			void Flush();
+			// Writes what is buffered and closes the trace; later calls are not recorded.
+			void Stop();
+
+			bool IsActive() const { return active.load(std::memory_order_relaxed); }
+			std::uint64_t Now() const;
+			void Record(std::uint8_t native, std::uint64_t timestamp, std::uint64_t duration, std::span<const std::uint32_t> args, std::uint8_t arrayMask, std::span<const std::uint32_t> payload);
+
+			Recorder(Recorder const&) = delete;
+			void operator=(Recorder const&) = delete;
+
+		private:
+			Recorder() = default;
+			~Recorder() { Stop(); }  // quitting sends no message; static destruction writes the tail
+
+			void FlushLocked();
+
+			std::atomic<bool> active{ false };
+			std::chrono::steady_clock::time_point epoch;
+
+			std::mutex lock;
+			std::ofstream file;
+			std::vector<char> buffer;
+		};
+
+		// Records one call on destruction, if tracing is on.
+		class ScopedCall
+		{
+		public:
+			template <typename... Args>
+			explicit ScopedCall(std::uint8_t native, const Args&... args) :
+				native(native)
+			{
+				static_assert(sizeof...(Args) <= MAX_ARGS);
+				auto& recorder = Recorder::GetSingleton();
+				if (!recorder.IsActive())
+					return;
+				argCount = static_cast<std::uint8_t>(sizeof...(Args));
+				std::size_t i = 0;
+				(Capture(i++, args), ...);
+				start = recorder.Now();
+				recording = true;
+			}
+
+			~ScopedCall()
+			{
+				if (!recording)
+					return;
+				auto& recorder = Recorder::GetSingleton();
+				recorder.Record(native, start, recorder.Now() - start, { arguments.data(), argCount }, arrayMask, payload);
+			}
+
+			ScopedCall(ScopedCall const&) = delete;
+			void operator=(ScopedCall const&) = delete;
+
+		private:
+			template <typename T>
+			void Capture(std::size_t index, const T& value)
+			{
+				arguments[index] = ToTraceArg(value);
+			}
+
+			template <typename T>
+			void Capture(std::size_t index, const std::vector<T>& values)
+			{
+				arguments[index] = static_cast<std::uint32_t>(values.size());
+				arrayMask |= static_cast<std::uint8_t>(1u << index);
+				payload.reserve(payload.size() + values.size());
+				for (const auto& value : values)
+					payload.push_back(ToTraceArg(value));
+			}
+
+			std::uint8_t native;
+			std::uint8_t argCount = 0;
+			std::uint8_t arrayMask = 0;
+			bool recording = false;
+			std::uint64_t start = 0;
+			std::array<std::uint32_t, MAX_ARGS> arguments{};
+			std::vector<std::uint32_t> payload;
+		};
+	}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace TRACE
+	{
+		// Binary trace of native calls, little endian, no padding:
+		//   header: char magic[4] = "SSNT", uint16 version, uint16 reserved
+		//   record: uint64 timestamp (ns since recording started), uint32 duration (ns),
+		//           uint8 native (STATS::Native), uint8 argCount, uint8 arrayMask, uint32 args[argCount],
+		//           then for each array argument in order: uint32 elements[args[i]]
+		// Form arguments are stored as FormIDs (0 for None), bools and ints as their value. An array argument
+		// (bit i of arrayMask) stores its length in args[i] and its elements in the payload after the args.
+		// Version 1 had no arrayMask and no payload; arrays were only recorded by length.
+		// Kept free of game types so the host replay tool (tools/Bench) reads traces with the same constants.
+		inline constexpr std::array<char, 4> MAGIC{ 'S', 'S', 'N', 'T' };
+		inline constexpr std::uint16_t VERSION = 2;
+		inline constexpr std::size_t MAX_ARGS = 8;
+	}
+}
@@ -1,18 +1,21 @@
 #include "Util.h"
+#include "FormBuilder.h"
+#include "PerkRanks.h"
+#include "RecipeConditions.h"
+#include "Settings.h"
 
 namespace SCRIBE
 {
 	namespace UTIL
 	{
-		RE::FormID lexical_cast_formid(const std::string& hex_string)
+		RE::FormID lexical_cast_formid(std::string_view hex_string)
 		{
-			if (hex_string.substr(0, 2) != "0x") {
+			if (!hex_string.starts_with("0x")) {
 				throw std::invalid_argument("Input string is not a valid hexadecimal format (should start with '0x').");
 			}
 
-			std::istringstream iss(hex_string.substr(2));
 			uint32_t result;
-			if (!(iss >> std::hex >> result)) {
+			if (auto [ptr, ec] = std::from_chars(hex_string.data() + 2, hex_string.data() + hex_string.size(), result, 16); ec != std::errc()) {
 				throw std::invalid_argument("Failed to convert hexadecimal string to integer.");
 			}
 			return static_cast<RE::FormID>(result);
@@ -24,41 +27,7 @@ namespace SCRIBE
 		}
 		int GetSpellRank(RE::SpellItem* theSpell)
 		{
-			if (theSpell->data.castingPerk) {
-				switch (theSpell->data.castingPerk->formID) {
-				case 0xF2CA6:
-				case 0xF2CA7:
-				case 0xF2CA8:
-				case 0xF2CA9:
-				case 0xF2CAA:
-					return 1;
-				case 0xC44B7:
-				case 0xC44BB:
-				case 0xC44BF:
-				case 0xC44C3:
-				case 0xC44C7:
-					return 2;
-				case 0xC44B8:
-				case 0xC44BC:
-				case 0xC44C0:
-				case 0xC44C4:
-				case 0xC44C8:
-					return 3;
-				case 0xC44B9:
-				case 0xC44BD:
-				case 0xC44C1:
-				case 0xC44C5:
-				case 0xC44C9:
-					return 4;
-				case 0x000C44BA:
-				case 0x000C44BE:
-				case 0x000C44C2:
-				case 0x000C44C6:
-				case 0x000C44CA:
-					return 5;
-				}
-			}
-			return 0;
+			return PerkRankTable::GetSingleton().GetRank(theSpell);
 		}
 		const int GetSpellLevelApprox(RE::SpellItem* const& theSpell)
 		{
@@ -66,68 +35,78 @@ namespace SCRIBE
 				return min(GetSpellRank(theSpell) * 25 - 25, theSpell->effects.front()->baseEffect->GetMinimumSkillLevel());
 			return 0;
 		}
-		RE::TESGlobal* GetFilterGlobalForSpell(RE::SpellItem* theSpell)
+		CATALOG::ScrollFacts GetScrollFacts(RE::TESObjectBOOK* book, RE::SpellItem* theSpell)
 		{
-			const auto& spellLevel = GetSpellLevelApprox(theSpell);
-			auto filterGlob = FORMS::GetSingleton().GlobFilterStrange;
-			if (spellLevel < 25) {
-				filterGlob = FORMS::GetSingleton().GlobFilterNovice;
-			} else if (spellLevel < 50) {
-				filterGlob = FORMS::GetSingleton().GlobFilterApprentice;
-			} else if (spellLevel < 75) {
-				filterGlob = FORMS::GetSingleton().GlobFilterAdept;
-			} else if (spellLevel < 100) {
-				filterGlob = FORMS::GetSingleton().GlobFilterExpert;
-			} else {
-				filterGlob = FORMS::GetSingleton().GlobFilterMaster;
-			}
-			if (GetSpellRank(theSpell) == 0) {
-				filterGlob = FORMS::GetSingleton().GlobFilterStrange;
+			CATALOG::ScrollFacts facts;
+			facts.book = book;
+			facts.spell = theSpell;
+			facts.rank = static_cast<std::int8_t>(GetSpellRank(theSpell));
+			facts.level = static_cast<std::int16_t>(GetSpellLevelApprox(theSpell));
+			facts.tier = CATALOG::GetTierForLevel(facts.level);
+			facts.school = theSpell->GetAssociatedSkill();
+			facts.concentration = IsConcentrationSpell(theSpell);
+			return facts;
+		}
+		RE::TESGlobal* GetFilterGlobal(CATALOG::ScrollID id)
+		{
+			const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+			if (catalog.GetRank(id) == 0)
+				return FORMS::GetSingleton().GlobFilterStrange;
+
+			switch (catalog.GetTier(id)) {
+			case CATALOG::Tier::kNovice:
+				return FORMS::GetSingleton().GlobFilterNovice;
+			case CATALOG::Tier::kApprentice:
+				return FORMS::GetSingleton().GlobFilterApprentice;
+			case CATALOG::Tier::kAdept:
+				return FORMS::GetSingleton().GlobFilterAdept;
+			case CATALOG::Tier::kExpert:
+				return FORMS::GetSingleton().GlobFilterExpert;
+			default:
+				return FORMS::GetSingleton().GlobFilterMaster;
 			}
-			return filterGlob;
 		}
-		void AddTierKeywords(RE::ScrollItem* scrollObj, RE::SpellItem* theSpell)
+		void AddTierKeywords(FormBuilder& builder, CATALOG::ScrollID id)
 		{
-			switch (theSpell->GetAssociatedSkill()) {
+			switch (CATALOG::ScrollCatalog::GetSingleton().GetSchool(id)) {
 			case RE::ActorValue::kAlteration:
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollAlteration);
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollAlteration);
 				break;
 			case RE::ActorValue::kConjuration:
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollConjuration);
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollConjuration);
 				break;
 			case RE::ActorValue::kDestruction:
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollDestruction);
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollDestruction);
 				break;
 			case RE::ActorValue::kIllusion:
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollIllusion);
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollIllusion);
 				break;
 			case RE::ActorValue::kRestoration:
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollRestoration);
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollRestoration);
 				break;
 			}
 		}
-		void AddDisintegrateEffect(RE::ScrollItem* scrollObj)
+		void AddDisintegrateEffect(FormBuilder& builder)
 		{
 			bool isHostile = false;
-			for (auto& eff : scrollObj->effects) {
+			for (auto& eff : builder.GetEffects()) {
 				isHostile = isHostile || eff->IsHostile();
 				if (eff == FORMS::GetSingleton().SpelDisintegrateEffectTemplate->effects.front())
 					return;
 			}
 
-			auto castType = scrollObj->GetCastingType();
+			auto castType = builder.GetForm()->GetCastingType();
 
-			if (SCRIBE::CACHE::SpellScrollBiMap.containsValue(scrollObj)) {
-				auto assocSpell = SCRIBE::CACHE::SpellScrollBiMap.getKey(scrollObj);
-				if (assocSpell->GetCastingType() == RE::MagicSystem::CastingType::kConcentration)
-					castType = assocSpell->GetCastingType();
+			if (auto id = CATALOG::ScrollCatalog::GetSingleton().FindByScroll(builder.GetForm()->As<RE::ScrollItem>()); id != CATALOG::INVALID_SCROLL_ID) {
+				if (CATALOG::ScrollCatalog::GetSingleton().IsConcentration(id))
+					castType = RE::MagicSystem::CastingType::kConcentration;
 			}
 
 			if (isHostile && castType == RE::MagicSystem::CastingType::kFireAndForget) {
 				bool isTargeted = false;
 				bool isArea = false;
 				bool isLocationArea = false;
-				for (auto& eff : scrollObj->effects) {
+				for (auto& eff : builder.GetEffects()) {
 					isTargeted = isTargeted ||
 					             (eff->baseEffect->data.delivery == RE::MagicSystem::Delivery::kTargetActor ||
 									 eff->baseEffect->data.delivery == RE::MagicSystem::Delivery::kAimed ||
@@ -136,33 +115,39 @@ namespace SCRIBE
 					isLocationArea = isLocationArea || eff->baseEffect->data.delivery == RE::MagicSystem::Delivery::kTargetLocation;
 				}
 				if (isTargeted)
-					scrollObj->effects.emplace_back(FORMS::GetSingleton().SpelDisintegrateEffectTemplate->effects.front());
+					builder.AddEffect(FORMS::GetSingleton().SpelDisintegrateEffectTemplate->effects.front());
 				//if (isArea)
-				//	scrollObj->effects.emplace_back(effectDisintegrateArea->effects[0]);
+				//	builder.AddEffect(effectDisintegrateArea->effects[0]);
 				//if (isLocationArea)
-				//	scrollObj->effects.emplace_back(effectDisintegrateLocationArea->effects[0]);
+				//	builder.AddEffect(effectDisintegrateLocationArea->effects[0]);
 			}
 		}
-		void AddRankKeywords(RE::ScrollItem* scrollObj, RE::SpellItem* theSpell)
+		void AddRankKeywords(FormBuilder& builder, CATALOG::ScrollID id)
 		{
-			const auto& spellLevel = GetSpellLevelApprox(theSpell);
-			if (spellLevel < 25) {
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollNovice);
-			} else if (spellLevel < 50) {
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollApprentice);
-			} else if (spellLevel < 75) {
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollAdept);
-			} else if (spellLevel < 100) {
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollExpert);
-			} else {
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollMaster);
+			const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+			switch (catalog.GetTier(id)) {
+			case CATALOG::Tier::kNovice:
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollNovice);
+				break;
+			case CATALOG::Tier::kApprentice:
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollApprentice);
+				break;
+			case CATALOG::Tier::kAdept:
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollAdept);
+				break;
+			case CATALOG::Tier::kExpert:
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollExpert);
+				break;
+			default:
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollMaster);
+				break;
 			}
-			if (GetSpellRank(theSpell) == 0) {
-				scrollObj->AddKeyword(FORMS::GetSingleton().KywdScrollStrange);
+			if (catalog.GetRank(id) == 0) {
+				builder.AddKeyword(FORMS::GetSingleton().KywdScrollStrange);
 			}
 		}
 
-		std::size_t GetEffectListHash(RE::BSTArray<RE::Effect*> effList)
+		std::size_t GetEffectListHash(const RE::BSTArray<RE::Effect*>& effList)
 		{
 			std::size_t effHash = 0UL;
 			for (auto& eff : effList) {
@@ -171,14 +156,37 @@ namespace SCRIBE
 			}
 			return effHash;
 		}
-		std::size_t GetNameHash(std::string name)
+		std::size_t GetNameHash(const std::string& name)
 		{
 			return std::hash<std::string>{}(name);
 		}
 
+		std::string GetEffectSignature(RE::SpellItem* theSpell)
+		{
+			std::string signature;
+			signature.reserve(7 + theSpell->effects.size() * 16);
+
+			const auto append = [&signature](auto value) {
+				const auto bytes = std::bit_cast<std::array<char, sizeof(value)>>(value);
+				signature.append(bytes.data(), bytes.size());
+			};
+
+			append(static_cast<std::uint8_t>(theSpell->GetCastingType()));
+			append(static_cast<std::uint8_t>(theSpell->GetDelivery()));
+			append(static_cast<std::int8_t>(GetSpellRank(theSpell)));
+			append(theSpell->data.castingPerk ? theSpell->data.castingPerk->GetFormID() : RE::FormID(0));
+			for (const auto eff : theSpell->effects) {
+				append(eff && eff->baseEffect ? eff->baseEffect->GetFormID() : RE::FormID(0));
+				append(eff ? eff->effectItem.magnitude : 0.0f);
+				append(eff ? eff->effectItem.area : 0u);
+				append(eff ? eff->effectItem.duration : 0u);
+			}
+			return signature;
+		}
+
 		std::string ExtractSpellName(const std::string& inputString)
 		{
-			const std::regex regexPattern(R"(\bScroll\s+of\s+([^\(\)-]+)\b)");
+			static const std::regex regexPattern(R"(\bScroll\s+of\s+([^\(\)-]+)\b)");
 
 			//const std::regex regexPattern("(?:Scroll of|Conjure|Summon) (?:the )?(\\w+(?: \\w+)*)");
 			std::smatch match;
@@ -189,7 +197,7 @@ namespace SCRIBE
 			}
 		}
 
-		std::vector<RE::BGSConstructibleObject*> GetConstructibleObjectForScroll(CobjGenerationArgs args)
+		std::vector<RE::BGSConstructibleObject*> GetConstructibleObjectForScroll(CATALOG::ScrollID id)
 		{
 			static const auto cobjFactory = RE::IFormFactory::GetConcreteFormFactoryByType<RE::BGSConstructibleObject>();
 			if (!cobjFactory) {
@@ -197,132 +205,60 @@ namespace SCRIBE
 				return {};
 			}
 
-			auto spellRank = GetSpellRank(args.theSpell);
-			auto filterGlob = GetFilterGlobalForSpell(args.theSpell);
+			const auto& catalog = CATALOG::ScrollCatalog::GetSingleton();
+			const auto theSpell = catalog.GetSpell(id);
+			const auto theScroll = catalog.GetScroll(id);
+			const auto baseDust = catalog.GetBaseDust(id);
+			const auto reducedDust = catalog.GetReducedDust(id);
+			const auto spellRank = catalog.GetRank(id);
+			const auto filterGlob = GetFilterGlobal(id);
+
+			// Tomes deduplicated into this scroll teach other spells; knowing any of them unlocks the recipe.
+			std::vector<RE::SpellItem*> knownSpells{ theSpell };
+			std::ranges::copy(catalog.GetAliasSpells(id), std::back_inserter(knownSpells));
 
 			auto constructibleObj = cobjFactory->Create();
 			constructibleObj->benchKeyword = FORMS::GetSingleton().KywdScrollEnchantingStation;
-			constructibleObj->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, args.baseDust, nullptr);
+			constructibleObj->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, baseDust, nullptr);
 			constructibleObj->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscPaperRoll, 1, nullptr);
-			constructibleObj->createdItem = args.theScroll;
-
-			auto nodeSpellLearnedFirst = new RE::TESConditionItem;
-			auto nodeSpellLearnedSecond = new RE::TESConditionItem;
-			auto nodeHasInscriptionLevel = new RE::TESConditionItem;
-			auto nodeFilterOnlyKnown = new RE::TESConditionItem;
-			auto nodeFilterSpellRank = new RE::TESConditionItem;
-			auto nodeHasDustPerk = new RE::TESConditionItem;
-
-			// A || B && A || C && D && E
-			nodeSpellLearnedFirst->next = nodeHasInscriptionLevel;
-			nodeSpellLearnedFirst->data.comparisonValue.f = 1.0f;
-			nodeSpellLearnedFirst->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kHasSpell;
-			nodeSpellLearnedFirst->data.functionData.params[0] = args.theSpell;
-			nodeSpellLearnedFirst->data.flags.isOR = true;
-
-			nodeHasInscriptionLevel->next = nodeSpellLearnedSecond;
-			nodeHasInscriptionLevel->data.comparisonValue.f = max(0, spellRank - 1) * 20.0f;
-			nodeHasInscriptionLevel->data.flags.opCode = RE::CONDITION_ITEM_DATA::OpCode::kGreaterThanOrEqualTo;
-			nodeHasInscriptionLevel->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kGetGlobalValue;
-			nodeHasInscriptionLevel->data.functionData.params[0] = FORMS::GetSingleton().GlobScribeLevel;
-			nodeHasInscriptionLevel->data.flags.isOR = false;
-
-			nodeSpellLearnedSecond->next = nodeFilterOnlyKnown;
-			nodeSpellLearnedSecond->data.comparisonValue.f = 1.0f;
-			nodeSpellLearnedSecond->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kHasSpell;
-			nodeSpellLearnedSecond->data.functionData.params[0] = args.theSpell;
-			nodeSpellLearnedSecond->data.flags.isOR = true;
-
-			nodeFilterOnlyKnown->next = nodeFilterSpellRank;
-			nodeFilterOnlyKnown->data.comparisonValue.f = 0.0f;
-			nodeFilterOnlyKnown->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kGetGlobalValue;
-			nodeFilterOnlyKnown->data.functionData.params[0] = FORMS::GetSingleton().GlobFilterKnown;
-			nodeFilterOnlyKnown->data.flags.isOR = false;
-
-			nodeFilterSpellRank->next = nodeHasDustPerk;
-			nodeFilterSpellRank->data.comparisonValue.f = 1.0f;
-			nodeFilterSpellRank->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kGetGlobalValue;
-			nodeFilterSpellRank->data.functionData.params[0] = filterGlob;
-			nodeFilterSpellRank->data.flags.isOR = false;
-
-			nodeHasDustPerk->next = nullptr;
-			nodeHasDustPerk->data.comparisonValue.f = 0.0f;
-			nodeHasDustPerk->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kHasPerk;
-			nodeHasDustPerk->data.functionData.params[0] = FORMS::GetSingleton().PerkDustDiscount;
-
-			constructibleObj->conditions.head = nodeSpellLearnedFirst;
+			constructibleObj->createdItem = theScroll;
+
+			const auto requiredLevel = max(0, spellRank - 1) * 20.0f;
+			// Optimize keeps every chain equivalent; tools/Tests checks that for every recipe shape.
+			const auto baseChain = CONDITIONS::MakeRecipeChain(knownSpells, requiredLevel, filterGlob, false);
+			const auto perkChain = CONDITIONS::MakeRecipeChain(knownSpells, requiredLevel, filterGlob, true);
+			const auto baseConditions = CONDITIONS::Build(CONDITIONS::Optimize(baseChain.chain), baseChain.conditions);
+			const auto perkConditions = CONDITIONS::Build(CONDITIONS::Optimize(perkChain.chain), perkChain.conditions);
+
+			constructibleObj->conditions.head = baseConditions;
 
 			auto constructibleObjDustPerk = cobjFactory->Create();
 
 			constructibleObjDustPerk->benchKeyword = FORMS::GetSingleton().KywdScrollEnchantingStation;
-			constructibleObjDustPerk->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, args.reducedDust, nullptr);
+			constructibleObjDustPerk->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, reducedDust, nullptr);
 			constructibleObjDustPerk->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscPaperRoll, 1, nullptr);
-			constructibleObjDustPerk->createdItem = args.theScroll;
-
-			auto DDnodeSpellLearnedFirst = new RE::TESConditionItem;
-			auto DDnodeSpellLearnedSecond = new RE::TESConditionItem;
-			auto DDnodeHasInscriptionLevel = new RE::TESConditionItem;
-			auto DDnodeFilterOnlyKnown = new RE::TESConditionItem;
-			auto DDnodeFilterSpellRank = new RE::TESConditionItem;
-			auto DDnodeHasDustPerk = new RE::TESConditionItem;
-
-			// A || B && A || C && D && E
-			DDnodeSpellLearnedFirst->next = DDnodeHasInscriptionLevel;
-			DDnodeSpellLearnedFirst->data.comparisonValue.f = 1.0f;
-			DDnodeSpellLearnedFirst->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kHasSpell;
-			DDnodeSpellLearnedFirst->data.functionData.params[0] = args.theSpell;
-			DDnodeSpellLearnedFirst->data.flags.isOR = true;
-
-			DDnodeHasInscriptionLevel->next = DDnodeSpellLearnedSecond;
-			DDnodeHasInscriptionLevel->data.comparisonValue.f = max(0, spellRank - 1) * 20.0f;
-			DDnodeHasInscriptionLevel->data.flags.opCode = RE::CONDITION_ITEM_DATA::OpCode::kGreaterThanOrEqualTo;
-			DDnodeHasInscriptionLevel->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kGetGlobalValue;
-			DDnodeHasInscriptionLevel->data.functionData.params[0] = FORMS::GetSingleton().GlobScribeLevel;
-			DDnodeHasInscriptionLevel->data.flags.isOR = false;
-
-			DDnodeSpellLearnedSecond->next = DDnodeFilterOnlyKnown;
-			DDnodeSpellLearnedSecond->data.comparisonValue.f = 1.0f;
-			DDnodeSpellLearnedSecond->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kHasSpell;
-			DDnodeSpellLearnedSecond->data.functionData.params[0] = args.theSpell;
-			DDnodeSpellLearnedSecond->data.flags.isOR = true;
-
-			DDnodeFilterOnlyKnown->next = DDnodeFilterSpellRank;
-			DDnodeFilterOnlyKnown->data.comparisonValue.f = 0.0f;
-			DDnodeFilterOnlyKnown->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kGetGlobalValue;
-			DDnodeFilterOnlyKnown->data.functionData.params[0] = FORMS::GetSingleton().GlobFilterKnown;
-			DDnodeFilterOnlyKnown->data.flags.isOR = false;
-
-			DDnodeFilterSpellRank->next = DDnodeHasDustPerk;
-			DDnodeFilterSpellRank->data.comparisonValue.f = 1.0f;
-			DDnodeFilterSpellRank->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kGetGlobalValue;
-			DDnodeFilterSpellRank->data.functionData.params[0] = filterGlob;
-			DDnodeFilterSpellRank->data.flags.isOR = false;
-
-			DDnodeHasDustPerk->next = nullptr;
-			DDnodeHasDustPerk->data.comparisonValue.f = 1.0f;
-			DDnodeHasDustPerk->data.functionData.function = RE::FUNCTION_DATA::FunctionID::kHasPerk;
-			DDnodeHasDustPerk->data.functionData.params[0] = FORMS::GetSingleton().PerkDustDiscount;
-
-			constructibleObjDustPerk->conditions.head = DDnodeSpellLearnedFirst;
-
-			if (SCRIBE::CONFIG::Plugin::GetSingleton().GetBoolValue("SETTINGS", "Generate10xRecipes")) {
+			constructibleObjDustPerk->createdItem = theScroll;
+
+			constructibleObjDustPerk->conditions.head = perkConditions;
+
+			if (SCRIBE::CONFIG::GetSettings().generate10xRecipes) {
 				auto constructibleObj10x = cobjFactory->Create();
 
 				constructibleObj10x->benchKeyword = FORMS::GetSingleton().KywdScrollEnchantingStation;
-				constructibleObj10x->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, args.baseDust * 10, nullptr);
+				constructibleObj10x->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, baseDust * 10, nullptr);
 				constructibleObj10x->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscPaperRoll, 10, nullptr);
-				constructibleObj10x->createdItem = args.theScroll;
+				constructibleObj10x->createdItem = theScroll;
 				constructibleObj10x->data.numConstructed = 10;
-				constructibleObj10x->conditions.head = nodeSpellLearnedFirst;
+				constructibleObj10x->conditions.head = baseConditions;
 
 				auto constructibleObjDustPerk10x = cobjFactory->Create();
 
 				constructibleObjDustPerk10x->benchKeyword = FORMS::GetSingleton().KywdScrollEnchantingStation;
-				constructibleObjDustPerk10x->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, args.reducedDust * 10, nullptr);
+				constructibleObjDustPerk10x->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscArcaneDust, reducedDust * 10, nullptr);
 				constructibleObjDustPerk10x->requiredItems.AddObjectToContainer(FORMS::GetSingleton().MiscPaperRoll, 10, nullptr);
-				constructibleObjDustPerk10x->createdItem = args.theScroll;
+				constructibleObjDustPerk10x->createdItem = theScroll;
 				constructibleObjDustPerk10x->data.numConstructed = 10;
-				constructibleObjDustPerk10x->conditions.head = DDnodeSpellLearnedFirst;
+				constructibleObjDustPerk10x->conditions.head = perkConditions;
 
 				return { constructibleObj, constructibleObj10x, constructibleObjDustPerk, constructibleObjDustPerk10x };
 			}
@@ -338,10 +274,13 @@ namespace SCRIBE
 
 	namespace CACHE
 	{
+		static KeywordSpellList keywordSpellListBuilder;
+		static HashToSpell hashToSpellBuilder;
+
 		void AddNameAndEffectHashedSpell(RE::SpellItem* theSpell)
 		{
-			HashToSpellMap[UTIL::GetEffectListHash(theSpell->effects)] = theSpell;
-			HashToSpellMap[UTIL::GetNameHash(theSpell->GetName())] = theSpell;
+			hashToSpellBuilder[UTIL::GetEffectListHash(theSpell->effects)] = theSpell;
+			hashToSpellBuilder[UTIL::GetNameHash(theSpell->GetName())] = theSpell;
 		}
 
 		void AddKeywordSpellCache(RE::SpellItem* theSpell)
@@ -349,9 +288,15 @@ namespace SCRIBE
 			for (auto& eff : theSpell->effects) {
 				for (size_t i = 0; i < eff->baseEffect->numKeywords; i++) {
 					const auto& kywd = eff->baseEffect->keywords[i];
-					KeywordSpellListMap[kywd].push_back(theSpell);
+					keywordSpellListBuilder[kywd].push_back(theSpell);
 				}
 			}
 		}
+
+		void PublishSpellCaches()
+		{
+			KeywordSpellListMap.Publish(std::exchange(keywordSpellListBuilder, {}));
+			HashToSpellMap.Publish(std::exchange(hashToSpellBuilder, {}));
+		}
 	}
 }
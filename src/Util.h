@@ -1,35 +1,36 @@
 #pragma once
 
 #include "Bimap.h"
+#include "Catalog.h"
+#include "Concurrent.h"
+#include "FormIDAllocator.h"
 #include "SimpleIni.h"
 
 namespace SCRIBE
 {
+	class FormBuilder;
 
 	namespace UTIL
 	{
-		RE::FormID lexical_cast_formid(const std::string& hex_string);
+		RE::FormID lexical_cast_formid(std::string_view hex_string);
 		bool IsConcentrationSpell(RE::SpellItem* theSpell);
 		int GetSpellRank(RE::SpellItem* theSpell);
 		const int GetSpellLevelApprox(RE::SpellItem* const& theSpell);
-		RE::TESGlobal* GetFilterGlobalForSpell(RE::SpellItem* theSpell);
-		void AddTierKeywords(RE::ScrollItem* scrollObj, RE::SpellItem* theSpell);
-		void AddDisintegrateEffect(RE::ScrollItem* scrollObj);
-		void AddRankKeywords(RE::ScrollItem* scrollObj, RE::SpellItem* theSpell);
-
-		std::size_t GetEffectListHash(RE::BSTArray<RE::Effect*> effList);
-		std::size_t GetNameHash(std::string name);
+		CATALOG::ScrollFacts GetScrollFacts(RE::TESObjectBOOK* book, RE::SpellItem* theSpell);
+		RE::TESGlobal* GetFilterGlobal(CATALOG::ScrollID id);
+		void AddTierKeywords(FormBuilder& builder, CATALOG::ScrollID id);
+		void AddDisintegrateEffect(FormBuilder& builder);
+		void AddRankKeywords(FormBuilder& builder, CATALOG::ScrollID id);
+
+		std::size_t GetEffectListHash(const RE::BSTArray<RE::Effect*>& effList);
+		std::size_t GetNameHash(const std::string& name);
+		// Exact byte signature of what a spell does and which tier it belongs to: casting type, delivery, rank,
+		// casting perk and every effect with its magnitude, area and duration.
+		std::string GetEffectSignature(RE::SpellItem* theSpell);
 
 		std::string ExtractSpellName(const std::string& inputString);
 
-		struct CobjGenerationArgs
-		{
-			RE::ScrollItem* theScroll;
-			RE::SpellItem* theSpell;
-			const int baseDust;
-			const int reducedDust;
-		};
-		std::vector<RE::BGSConstructibleObject*> GetConstructibleObjectForScroll(CobjGenerationArgs args);
+		std::vector<RE::BGSConstructibleObject*> GetConstructibleObjectForScroll(CATALOG::ScrollID id);
 	}
 
 	namespace CONFIG
@@ -63,15 +64,16 @@ namespace SCRIBE
 				return Ini.SectionExists(section.c_str());
 			}
 
-			const std::vector<std::pair<std::string, std::string>> GetAllKeyValuePairs(const std::string& section) const {
-				std::vector<std::pair<std::string, std::string>> ret;
+			// Views point into the INI's own storage and stay valid until that key is deleted or overwritten.
+			std::vector<std::pair<std::string_view, std::string_view>> GetAllKeyValuePairs(const std::string& section) const
+			{
+				std::vector<std::pair<std::string_view, std::string_view>> ret;
 				CSimpleIniA::TNamesDepend keys;
 				Ini.GetAllKeys(section.c_str(), keys);
-				for (auto& key : keys) {
-					auto val = Ini.GetValue(section.c_str(), key.pItem);
-					ret.push_back({ key.pItem, val });
-				}
-				
+				ret.reserve(keys.size());
+				for (auto& key : keys)
+					ret.push_back({ key.pItem, Ini.GetValue(section.c_str(), key.pItem, "") });
+
 				return ret;
 			}
 
@@ -84,9 +86,9 @@ namespace SCRIBE
 				Ini.Delete(section.c_str(), key.c_str());
 			}
 
-			std::string GetValue(const std::string& section, const std::string& key)
+			std::string_view GetValue(const std::string& section, const std::string& key) const
 			{
-				return Ini.GetValue(section.c_str(), key.c_str());
+				return Ini.GetValue(section.c_str(), key.c_str(), "");
 			}
 
 			long GetLongValue(const std::string& section, const std::string& key)
@@ -126,18 +128,27 @@ namespace SCRIBE
 
 	namespace CACHE
 	{
-		inline BiMap<RE::TESObjectBOOK*, RE::SpellItem*> BookSpellBiMap;
-		inline BiMap<RE::SpellItem*, RE::ScrollItem*> SpellScrollBiMap;
 		inline BiMap<RE::FormID, RE::FormID> FormIDRelocationBiMap;
-		inline BiMap<std::pair<RE::ScrollItem*, RE::ScrollItem*>, RE::ScrollItem*> FusionComponentsToResultBiMap;
-		inline std::map<RE::SpellItem*, std::vector<RE::BGSConstructibleObject*>> SpellScrollCobjMap;
-		inline std::map<RE::ScrollItem*, RE::SpellItem*> FusionSpellMap;
-		inline std::map<RE::BGSKeyword*, std::vector<RE::SpellItem*>> KeywordSpellListMap;
-		inline std::map<RE::SpellItem*, RE::SpellItem*> ZeroCostMap;
-		inline std::map<ULONG64, RE::SpellItem*> HashToSpellMap;
+		using FusionComponents = std::pair<RE::ScrollItem*, RE::ScrollItem*>;
+		using KeywordSpellList = std::map<RE::BGSKeyword*, std::vector<RE::SpellItem*>>;
+		using HashToSpell = std::map<ULONG64, RE::SpellItem*>;
+
+		// Written at runtime by fusions on any VM thread.
+		inline ShardedMap<FusionComponents, RE::ScrollItem*, PointerPairHash> FusionComponentsToResultMap;
+		inline ShardedMap<RE::ScrollItem*, FusionComponents> FusionResultToComponentsMap;
+		inline ShardedMap<RE::ScrollItem*, RE::SpellItem*> FusionScrollToSpellMap;
+		inline ShardedMap<RE::SpellItem*, RE::ScrollItem*> FusionSpellToScrollMap;
+
+		// Total gold value per enchantment, filled on first valuation.
+		inline ShardedMap<RE::EnchantmentItem*, float> EnchantmentValueMap;
+
+		// Built while generating scrolls, then published once and only read.
+		inline Snapshot<KeywordSpellList> KeywordSpellListMap;
+		inline Snapshot<HashToSpell> HashToSpellMap;
 
 		void AddNameAndEffectHashedSpell(RE::SpellItem* theSpell);
 		void AddKeywordSpellCache(RE::SpellItem* theSpell);
+		void PublishSpellCaches();
 	}
 
 	class FORMS
@@ -150,13 +161,8 @@ namespace SCRIBE
 			return instance;
 		}
 
-		static const RE::FormID FORMID_OFFSET_BASE = 0xFF030000;
-		RE::FormID CurrentOffset;
 		bool UseOffset;
 
-		void SetOffset(RE::FormID offset) {
-			CurrentOffset = offset;
-		}
 		void SetUseOffset(bool use) {
 			UseOffset = use;
 		}
@@ -164,11 +170,6 @@ namespace SCRIBE
 		{
 			return UseOffset;
 		}
-		RE::FormID NextFormID() const
-		{
-			static RE::FormID current = 0;
-			return FORMID_OFFSET_BASE + (++current) + CurrentOffset;
-		}
 
 		RE::TESObjectMISC* MiscPaperRoll = RE::TESForm::LookupByID<RE::TESObjectMISC>(0x33761);
 		RE::TESObjectMISC* MiscArcaneDust = RE::TESDataHandler::GetSingleton()->LookupForm<RE::TESObjectMISC>(0x804, "Scribe.esp"sv);
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace SCRIBE
+{
+	struct PerkRank
+	{
+		std::uint32_t perk;  // FormID in Skyrim.esm
+		std::int8_t rank;
+	};
+
+	// Alteration, Conjuration, Destruction, Illusion, Restoration for each rank; sorted by FormID.
+	// Plain integers only, so the prebake tool can share it.
+	inline constexpr auto VANILLA_PERK_RANKS = std::to_array<PerkRank>({
+		{ 0x000C44B7, 2 }, { 0x000C44B8, 3 }, { 0x000C44B9, 4 }, { 0x000C44BA, 5 },
+		{ 0x000C44BB, 2 }, { 0x000C44BC, 3 }, { 0x000C44BD, 4 }, { 0x000C44BE, 5 },
+		{ 0x000C44BF, 2 }, { 0x000C44C0, 3 }, { 0x000C44C1, 4 }, { 0x000C44C2, 5 },
+		{ 0x000C44C3, 2 }, { 0x000C44C4, 3 }, { 0x000C44C5, 4 }, { 0x000C44C6, 5 },
+		{ 0x000C44C7, 2 }, { 0x000C44C8, 3 }, { 0x000C44C9, 4 }, { 0x000C44CA, 5 },
+		{ 0x000F2CA6, 1 }, { 0x000F2CA7, 1 }, { 0x000F2CA8, 1 }, { 0x000F2CA9, 1 }, { 0x000F2CAA, 1 },
+	});
+
+	static_assert(std::ranges::is_sorted(VANILLA_PERK_RANKS, {}, &PerkRank::perk));
+}
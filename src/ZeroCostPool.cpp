@@ -0,0 +1,132 @@
+#include "ZeroCostPool.h"
+#include "Core.hpp"
+#include "FormBuilder.h"
+#include "Stats.h"
+
+namespace SCRIBE
+{
+	void ZeroCostPool::SetCapacity(std::size_t newCapacity)
+	{
+		std::scoped_lock guard(lock);
+		capacity = newCapacity;
+		slots.reserve(capacity);
+		index.reserve(capacity);
+	}
+
+	RE::SpellItem* ZeroCostPool::Get(RE::SpellItem* spell)
+	{
+		if (spell == nullptr)
+			return nullptr;
+
+		std::scoped_lock guard(lock);
+		if (auto it = index.find(spell); it != index.end()) {
+			auto& slot = slots[it->second];
+			if (slot.idle) {
+				slot.idle = false;
+				std::erase(idle, it->second);
+			}
+			hits.fetch_add(1, std::memory_order_relaxed);
+			STATS::RecordCache(STATS::Cache::kZeroCost, true);
+			return slot.copy;
+		}
+
+		misses.fetch_add(1, std::memory_order_relaxed);
+		STATS::RecordCache(STATS::Cache::kZeroCost, false);
+		return Insert(spell, true);
+	}
+
+	void ZeroCostPool::Prewarm(std::vector<RE::SpellItem*> spells)
+	{
+		constexpr std::size_t chunkSize = 16;
+
+		const auto taskInterface = SKSE::GetTaskInterface();
+		if (!taskInterface || spells.empty())
+			return;
+
+		// Forms are built on the main thread a few at a time so prewarming never stalls a single frame for long.
+		auto queue = std::make_shared<std::vector<RE::SpellItem*>>(std::move(spells));
+		for (std::size_t begin = 0; begin < queue->size(); begin += chunkSize) {
+			taskInterface->AddTask([this, queue, begin]() {
+				std::scoped_lock guard(lock);
+				const auto end = std::min<std::size_t>(begin + chunkSize, queue->size());
+				for (auto i = begin; i < end; i++) {
+					if (capacity != 0 && slots.size() >= capacity)
+						return;
+					if (!index.contains((*queue)[i]))
+						Insert((*queue)[i], false);
+				}
+			});
+		}
+	}
+
+	ZeroCostPool::Stats ZeroCostPool::GetStats() const
+	{
+		std::scoped_lock guard(lock);
+		return {
+			hits.load(std::memory_order_relaxed),
+			misses.load(std::memory_order_relaxed),
+			recycled.load(std::memory_order_relaxed),
+			slots.size(),
+			capacity
+		};
+	}
+
+	RE::SpellItem* ZeroCostPool::Insert(RE::SpellItem* spell, bool handOut)
+	{
+		// A full pool recycles the newest idle copy: prewarming goes lowest tiers first, so it is the least likely
+		// to be asked for. Without idle copies the pool grows by one form per spell, as an uncapped cache would.
+		if (capacity != 0 && slots.size() >= capacity && !idle.empty()) {
+			const auto victim = idle.back();
+			idle.pop_back();
+			auto& slot = slots[victim];
+			index.erase(slot.source);
+			Build(slot.copy, spell);
+			slot.source = spell;
+			slot.idle = !handOut;
+			index.insert_or_assign(spell, victim);
+			if (slot.idle)
+				idle.push_back(victim);
+			recycled.fetch_add(1, std::memory_order_relaxed);
+			return slot.copy;
+		}
+
+		auto zeroCostSpell = Create();
+		if (!zeroCostSpell)
+			return nullptr;
+		Build(zeroCostSpell, spell);
+		index.insert_or_assign(spell, slots.size());
+		if (!handOut)
+			idle.push_back(slots.size());
+		slots.push_back({ spell, zeroCostSpell, !handOut });
+		return zeroCostSpell;
+	}
+
+	RE::SpellItem* ZeroCostPool::Create()
+	{
+		static auto spellFactory = RE::IFormFactory::GetConcreteFormFactoryByType<RE::SpellItem>();
+		if (!spellFactory) {
+			logger::error("Failed to fetch IFormFactory: SPEL!");
+			return nullptr;
+		}
+		return spellFactory->Create();
+	}
+
+	void ZeroCostPool::Build(RE::SpellItem* zeroCostSpell, RE::SpellItem* spell)
+	{
+		zeroCostSpell->fullName = spell->GetFullName();
+		zeroCostSpell->data.castDuration = spell->data.castDuration;
+		zeroCostSpell->SetDelivery(spell->GetDelivery());
+		zeroCostSpell->SetCastingType(spell->GetCastingType());
+		zeroCostSpell->SetAutoCalc(false);
+		zeroCostSpell->data.flags.set(RE::SpellItem::SpellFlag::kCostOverride);
+		zeroCostSpell->data.costOverride = 0;
+
+		// Rebuilt copies start over from the new spell's effects and its scroll's keywords.
+		FormBuilder builder(zeroCostSpell);
+		builder.ClearEffects();
+		builder.AddEffects(spell->effects);
+		builder.ClearKeywords();
+		builder.AddKeywords(GetScrollFromSpell(nullptr, spell));
+		builder.Commit();
+	}
+}
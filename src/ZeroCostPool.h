@@ -0,0 +1,60 @@
+#pragma once
+
+namespace SCRIBE
+{
+	// Cache of zero-cost spell copies handed out by GetZeroCostCopy, one copy per spell.
+	// A copy that was handed out may be equipped or mid-cast at any time, so it stays cached and is never rebuilt.
+	// Only copies built ahead of use (Prewarm) that nobody asked for yet are idle: once the pool holds `capacity`
+	// copies, a miss rebuilds an idle copy in place instead of creating another form.
+	class ZeroCostPool
+	{
+	public:
+		struct Stats
+		{
+			std::uint64_t hits;
+			std::uint64_t misses;
+			std::uint64_t recycled;
+			std::size_t size;
+			std::size_t capacity;
+		};
+
+		static ZeroCostPool& GetSingleton()
+		{
+			static ZeroCostPool instance;
+			return instance;
+		}
+
+		// Copies beyond which misses recycle idle copies; 0 = never recycle.
+		void SetCapacity(std::size_t capacity);
+		RE::SpellItem* Get(RE::SpellItem* spell);
+		void Prewarm(std::vector<RE::SpellItem*> spells);
+		Stats GetStats() const;
+
+		ZeroCostPool(ZeroCostPool const&) = delete;
+		void operator=(ZeroCostPool const&) = delete;
+
+	private:
+		struct Slot
+		{
+			RE::SpellItem* source;
+			RE::SpellItem* copy;
+			bool idle;
+		};
+
+		ZeroCostPool() = default;
+
+		RE::SpellItem* Insert(RE::SpellItem* spell, bool handOut);
+		static RE::SpellItem* Create();
+		static void Build(RE::SpellItem* copy, RE::SpellItem* spell);
+
+		mutable std::mutex lock;
+		std::vector<Slot> slots;
+		std::unordered_map<RE::SpellItem*, std::size_t> index;
+		std::vector<std::size_t> idle;  // prewarmed slots never handed out, in the order they were built
+		std::size_t capacity = 0;
+
+		std::atomic<std::uint64_t> hits{ 0 };
+		std::atomic<std::uint64_t> misses{ 0 };
+		std::atomic<std::uint64_t> recycled{ 0 };
+	};
+}
@@ -0,0 +1,80 @@
+#include "Bench.h"
+
+namespace
+{
+	std::atomic<std::uint64_t> allocationCount{ 0 };
+
+	void* Allocate(std::size_t size)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		if (auto memory = std::malloc(size ? size : 1))
+			return memory;
+		throw std::bad_alloc();
+	}
+
+	void* AllocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+		if (auto memory = _aligned_malloc(size ? size : 1, align))
+			return memory;
+#else
+		if (auto memory = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align))
+			return memory;
+#endif
+		throw std::bad_alloc();
+	}
+
+	void FreeAligned(void* memory)
+	{
+#ifdef _WIN32
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	}
+}
+
+// The array and nothrow forms forward to these by default.
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { FreeAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { FreeAligned(memory); }
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		std::uint64_t GetAllocationCount()
+		{
+			return allocationCount.load(std::memory_order_relaxed);
+		}
+
+		void Runner::Report(const Result& result) const
+		{
+			std::array<char, 256> line{};
+			std::snprintf(line.data(), line.size(), R"({"name": "%s", "calls": %llu, "ns_per_call": %.2f, "p50_ns": %.2f, "p99_ns": %.2f, "allocs_per_call": %.3f)",
+				result.name.c_str(), static_cast<unsigned long long>(result.calls), result.nsPerCall, result.p50, result.p99, result.allocsPerCall);
+			std::cout << line.data();
+			for (const auto& [counter, value] : result.counters) {
+				std::snprintf(line.data(), line.size(), R"(, "%s": %.3f)", counter.c_str(), value);
+				std::cout << line.data();
+			}
+			std::cout << "}\n"
+					  << std::flush;
+		}
+
+		double Runner::Percentile(std::vector<double>& values, double fraction)
+		{
+			if (values.empty())
+				return 0.0;
+			const auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(values.size())));
+			const auto index = std::min<std::size_t>(rank > 0 ? rank - 1 : 0, values.size() - 1);
+			std::ranges::nth_element(values, values.begin() + static_cast<std::ptrdiff_t>(index));
+			return values[index];
+		}
+	}
+}
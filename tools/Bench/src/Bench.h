@@ -0,0 +1,172 @@
+#pragma once
+
+// Every measurement prints one JSON object per line:
+//   {"name": "...", "calls": N, "ns_per_call": x, "p50_ns": x, "p99_ns": x, "allocs_per_call": x, ...counters}
+// Latency percentiles are over samples; a sample times a batch of calls and counts as its mean per call.
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		// Heap allocations on every thread so far, counted by the replaced global operator new.
+		std::uint64_t GetAllocationCount();
+
+		// "<base>/<value><unit>", such as "concurrent/stress/Snapshot/load/8threads".
+		inline std::string MakeName(std::string_view base, std::size_t value, std::string_view unit)
+		{
+			std::string name(base);
+			name += '/';
+			name += std::to_string(value);
+			name += unit;
+			return name;
+		}
+
+		// Written to by measured code so the optimizer cannot drop results nobody reads.
+		inline volatile std::uint64_t sink = 0;
+
+		struct Result
+		{
+			std::string name;
+			std::uint64_t calls = 0;
+			double nsPerCall = 0.0;
+			double p50 = 0.0;
+			double p99 = 0.0;
+			double allocsPerCall = 0.0;
+			std::vector<std::pair<std::string, double>> counters;
+		};
+
+		class Runner
+		{
+		public:
+			Runner(std::string_view filter, double scale) :
+				filter(filter), scale(scale) {}
+
+			bool Wants(std::string_view name) const { return name.find(filter) != std::string_view::npos; }
+
+			// Sample count after --scale, never below one.
+			std::size_t Scale(std::size_t count) const { return std::max<std::size_t>(static_cast<std::size_t>(static_cast<double>(count) * scale), 1); }
+
+			// One untimed warm-up sample, then Scale(samples) samples of batch calls each.
+			template <typename Func>
+			Result Measure(std::string_view name, std::size_t samples, std::size_t batch, Func&& call)
+			{
+				using Clock = std::chrono::steady_clock;
+
+				for (std::size_t i = 0; i < batch; i++)
+					call();
+
+				samples = Scale(samples);
+				std::vector<double> perCall;
+				perCall.reserve(samples);
+				const auto allocationsBefore = GetAllocationCount();
+				for (std::size_t s = 0; s < samples; s++) {
+					const auto start = Clock::now();
+					for (std::size_t i = 0; i < batch; i++)
+						call();
+					const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+					perCall.push_back(elapsed.count() / static_cast<double>(batch));
+				}
+				// perCall was reserved up front, so it adds nothing to the count.
+				const auto allocations = GetAllocationCount() - allocationsBefore;
+
+				Result result;
+				result.name = name;
+				result.calls = static_cast<std::uint64_t>(samples * batch);
+				result.allocsPerCall = static_cast<double>(allocations) / static_cast<double>(result.calls);
+				double total = 0.0;
+				for (const auto sample : perCall)
+					total += sample;
+				result.nsPerCall = total / static_cast<double>(samples);
+				result.p50 = Percentile(perCall, 0.50);
+				result.p99 = Percentile(perCall, 0.99);
+				return result;
+			}
+
+			// Measure on threadCount threads at once, started together. Latencies are per thread; the "threads" and
+			// "mops_per_s" counters give the thread count and the combined throughput over the wall time.
+			template <typename Func>
+			Result MeasureThreads(std::string_view name, std::size_t threadCount, std::size_t samples, std::size_t batch, Func&& call)
+			{
+				using Clock = std::chrono::steady_clock;
+
+				samples = Scale(samples);
+				std::vector<std::vector<double>> perCall(threadCount);
+				for (auto& list : perCall)
+					list.reserve(samples);
+
+				// Wall time runs from the first thread's start to the last thread's end.
+				std::vector<std::pair<Clock::time_point, Clock::time_point>> spans(threadCount);
+				std::latch ready(static_cast<std::ptrdiff_t>(threadCount) + 1);
+				std::vector<std::thread> threads;
+				threads.reserve(threadCount);
+				for (std::size_t t = 0; t < threadCount; t++) {
+					threads.emplace_back([&, t] {
+						ready.arrive_and_wait();
+						spans[t].first = Clock::now();
+						for (std::size_t s = 0; s < samples; s++) {
+							const auto start = Clock::now();
+							for (std::size_t i = 0; i < batch; i++)
+								call(t);
+							const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+							perCall[t].push_back(elapsed.count() / static_cast<double>(batch));
+						}
+						spans[t].second = Clock::now();
+					});
+				}
+
+				const auto allocationsBefore = GetAllocationCount();
+				ready.arrive_and_wait();
+				for (auto& thread : threads)
+					thread.join();
+				const auto allocations = GetAllocationCount() - allocationsBefore;
+				const std::chrono::duration<double, std::nano> wall = std::ranges::max(spans, {}, &decltype(spans)::value_type::second).second - std::ranges::min(spans, {}, &decltype(spans)::value_type::first).first;
+
+				std::vector<double> all;
+				all.reserve(threadCount * samples);
+				for (const auto& list : perCall)
+					all.insert(all.end(), list.begin(), list.end());
+
+				Result result;
+				result.name = name;
+				result.calls = static_cast<std::uint64_t>(threadCount * samples * batch);
+				result.allocsPerCall = static_cast<double>(allocations) / static_cast<double>(result.calls);
+				double total = 0.0;
+				for (const auto sample : all)
+					total += sample;
+				result.nsPerCall = total / static_cast<double>(all.size());
+				result.p50 = Percentile(all, 0.50);
+				result.p99 = Percentile(all, 0.99);
+				result.counters.emplace_back("threads", static_cast<double>(threadCount));
+				result.counters.emplace_back("mops_per_s", static_cast<double>(result.calls) / wall.count() * 1000.0);
+				return result;
+			}
+
+			// Measure and Report in one, if the name passes the filter.
+			template <typename Func>
+			void Run(std::string_view name, std::size_t samples, std::size_t batch, Func&& call)
+			{
+				if (Wants(name))
+					Report(Measure(name, samples, batch, std::forward<Func>(call)));
+			}
+
+			void Report(const Result& result) const;
+
+			// Nearest-rank percentile; reorders values.
+			static double Percentile(std::vector<double>& values, double fraction);
+
+		private:
+			std::string filter;
+			double scale;
+		};
+
+		// One per source file; each names its measurements "<area>/<case>".
+		void RunConcurrent(Runner& runner);
+		void RunConditions(Runner& runner);
+		void RunEvents(Runner& runner);
+		void RunFormBuilder(Runner& runner);
+		void RunFusion(Runner& runner);
+		void RunKernel(Runner& runner);
+		void RunPluginWriter(Runner& runner);
+		void RunQuery(Runner& runner);
+		void RunValuation(Runner& runner);
+	}
+}
@@ -0,0 +1,151 @@
+#include "Bench.h"
+#include "Concurrent.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			struct Form
+			{
+				std::uint32_t formID;
+			};
+
+			// Per-thread key cursor, on its own cache line.
+			struct alignas(64) Cursor
+			{
+				std::uint64_t state;
+
+				std::size_t Next(std::size_t bound)
+				{
+					state ^= state << 13;
+					state ^= state >> 7;
+					state ^= state << 17;
+					return static_cast<std::size_t>(state % bound);
+				}
+			};
+
+			// Scaling over 1 to 8 Papyrus VM stand-in threads hitting one cache at once: 1 in 20 calls writes.
+			// The single-lock map is what the caches would be with one shared_mutex instead of shards.
+			void RunStress(Runner& runner, const std::vector<Form>& forms)
+			{
+				constexpr std::size_t BATCH = 256;
+				constexpr std::size_t WRITE_EVERY = 20;
+				constexpr std::size_t RING_CAPACITY = 1 << 20;  // 8 threads * 400 samples * 256 calls fit
+				const auto keys = forms.size();
+
+				ShardedMap<const Form*, std::uint32_t> sharded;
+				std::unordered_map<const Form*, std::uint32_t> plain;
+				std::shared_mutex plainLock;
+				std::unordered_map<const Form*, std::uint32_t> published;
+				for (const auto& form : forms) {
+					sharded.insertOrAssign(&form, form.formID);
+					plain.emplace(&form, form.formID);
+					published.emplace(&form, form.formID);
+				}
+				Snapshot<std::unordered_map<const Form*, std::uint32_t>> snapshot;
+				snapshot.Publish(std::move(published));
+
+				for (const std::size_t threads : { std::size_t(1), std::size_t(2), std::size_t(4), std::size_t(8) }) {
+					const auto named = [&](std::string_view base) { return MakeName(base, threads, "threads"); };
+					std::vector<Cursor> cursors(threads);
+					for (std::size_t t = 0; t < threads; t++)
+						cursors[t].state = 0x9E3779B97F4A7C15ull * (t + 1);
+					const auto run = [&](const std::string& name, auto&& call) {
+						if (runner.Wants(name))
+							runner.Report(runner.MeasureThreads(name, threads, 400, BATCH, call));
+					};
+
+					run(named("concurrent/stress/ShardedMap/readMostly"), [&](std::size_t t) {
+						const auto index = cursors[t].Next(keys);
+						if (index % WRITE_EVERY == 0)
+							sharded.insertOrAssign(&forms[index], forms[index].formID);
+						else
+							sink = sink + sharded.find(&forms[index]).value_or(0);
+					});
+
+					run(named("concurrent/stress/singleLockMap/readMostly"), [&](std::size_t t) {
+						const auto index = cursors[t].Next(keys);
+						if (index % WRITE_EVERY == 0) {
+							std::unique_lock guard(plainLock);
+							plain.insert_or_assign(&forms[index], forms[index].formID);
+						} else {
+							std::shared_lock guard(plainLock);
+							if (auto it = plain.find(&forms[index]); it != plain.end())
+								sink = sink + it->second;
+						}
+					});
+
+					run(named("concurrent/stress/Snapshot/load"), [&](std::size_t t) {
+						const auto map = snapshot.Load();
+						if (auto it = map->find(&forms[cursors[t].Next(keys)]); it != map->end())
+							sink = sink + it->second;
+					});
+
+					// Producers racing on the tail. The ring holds every push, so none fails and no consumer competes
+					// for the core; pushPop above covers the consumer side.
+					const auto ringName = named("concurrent/stress/MPSCRing/push");
+					if (runner.Wants(ringName)) {
+						auto ring = std::make_unique<MPSCRing<std::uint64_t, RING_CAPACITY>>();
+						std::atomic<std::uint64_t> full{ 0 };
+						auto result = runner.MeasureThreads(ringName, threads, 400, BATCH, [&](std::size_t t) {
+							if (!ring->TryPush(t))
+								full.fetch_add(1, std::memory_order_relaxed);
+						});
+						result.counters.emplace_back("full_rate", static_cast<double>(full.load()) / static_cast<double>(result.calls));
+						runner.Report(result);
+					}
+				}
+			}
+		}
+
+		// Uncontended costs of the runtime caches; keys are form pointers in game, addresses of stand-ins here.
+		void RunConcurrent(Runner& runner)
+		{
+			constexpr std::size_t KEYS = 16384;
+			constexpr std::size_t BATCH = 1024;
+
+			std::vector<Form> forms(KEYS), strangers(KEYS);
+			std::vector<const Form*> order(KEYS);
+			for (std::size_t i = 0; i < KEYS; i++) {
+				forms[i].formID = static_cast<std::uint32_t>(0x01000800 + i);
+				order[i] = &forms[i];
+			}
+			std::ranges::shuffle(order, std::mt19937(37));
+
+			ShardedMap<const Form*, std::uint32_t> map;
+			for (const auto& form : forms)
+				map.insertOrAssign(&form, form.formID);
+
+			std::size_t next = 0;
+			const auto nextKey = [&] { return order[next++ % KEYS]; };
+
+			runner.Run("concurrent/ShardedMap/find", 2000, BATCH, [&] {
+				sink = sink + map.find(nextKey()).value_or(0);
+			});
+			runner.Run("concurrent/ShardedMap/findMiss", 2000, BATCH, [&] {
+				sink = sink + map.find(&strangers[next++ % KEYS]).value_or(0);
+			});
+			runner.Run("concurrent/ShardedMap/insertOrGet", 2000, BATCH, [&] {
+				const auto key = nextKey();
+				sink = sink + map.insertOrGet(key, key->formID);
+			});
+			runner.Run("concurrent/ShardedMap/insertOrAssign", 2000, BATCH, [&] {
+				const auto key = nextKey();
+				map.insertOrAssign(key, key->formID);
+			});
+
+			auto ring = std::make_unique<MPSCRing<std::uint64_t, 1024>>();
+			std::uint64_t value = 0;
+			runner.Run("concurrent/MPSCRing/pushPop", 2000, BATCH, [&] {
+				ring->TryPush(value++);
+				std::uint64_t popped = 0;
+				ring->TryPop(popped);
+				sink = sink + popped;
+			});
+
+			RunStress(runner, forms);
+		}
+	}
+}
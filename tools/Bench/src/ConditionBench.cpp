@@ -0,0 +1,36 @@
+#include "Bench.h"
+#include "ConditionChain.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		// Recipe chains as BuildRecipes makes them: one spell, a few aliases, and the cap.
+		void RunConditions(Runner& runner)
+		{
+			for (const std::size_t spells : { std::size_t(1), std::size_t(4), CONDITIONS::MAX_RECIPE_SPELLS }) {
+				const auto shape = CONDITIONS::MakeRecipeShape(spells);
+				const auto optimized = CONDITIONS::Optimize(shape);
+				const auto named = [&](std::string_view base) { return MakeName(base, spells, "spells"); };
+
+				runner.Run(named("conditions/Optimize"), 20000, 1, [&] {
+					sink = sink + CONDITIONS::Optimize(shape).items.size();
+				});
+				runner.Run(named("conditions/IsEquivalent"), spells < 8 ? 20000 : 2000, 1, [&] {
+					sink = sink + CONDITIONS::IsEquivalent(shape, optimized);
+				});
+
+				const auto evaluationsName = named("conditions/Evaluate");
+				if (runner.Wants(evaluationsName)) {
+					std::uint32_t truth = 0;
+					auto result = runner.Measure(evaluationsName, 2000, 1024, [&] {
+						sink = sink + CONDITIONS::Evaluate(optimized, truth++);
+					});
+					result.counters.emplace_back("expected_evaluations", CONDITIONS::ExpectedEvaluations(shape));
+					result.counters.emplace_back("expected_evaluations_optimized", CONDITIONS::ExpectedEvaluations(optimized));
+					runner.Report(result);
+				}
+			}
+		}
+	}
+}
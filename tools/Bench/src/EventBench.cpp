@@ -0,0 +1,135 @@
+#include "Bench.h"
+#include "Concurrent.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			constexpr std::size_t LISTENERS = 4;  // scripts registered for the scroll cast events
+
+			// Stand-in for SKSE's mod callback source: the Papyrus VM queues one call per registered script,
+			// carrying its own copy of the event, and runs the queue on its next update.
+			struct ModEvent
+			{
+				std::string eventName;
+				std::string strArg;
+				float numArg;
+				std::uint32_t sender;  // a form pointer in game
+			};
+
+			class EventSource
+			{
+			public:
+				template <typename Handler>
+				void Send(const ModEvent& event, Handler handler)
+				{
+					for (auto& queue : queues)
+						queue.emplace_back([event, handler] { handler(event); });
+				}
+
+				void RunQueued()
+				{
+					for (auto& queue : queues) {
+						for (const auto& call : queue)
+							call();
+						queue.clear();
+					}
+				}
+
+			private:
+				std::array<std::vector<std::function<void()>>, LISTENERS> queues;
+			};
+
+			struct Cast
+			{
+				std::uint32_t scroll;
+				std::uint32_t caster;
+				std::uint64_t timestamp;
+			};
+
+			// ScrollCastQueue without the game: the ring, the queued count and the once-per-frame dispatch flag.
+			class CastQueue
+			{
+			public:
+				void Push(const Cast& cast)
+				{
+					if (!ring.TryPush(cast))
+						return;
+					queued.fetch_add(1, std::memory_order_release);
+					dispatchPending.exchange(true, std::memory_order_acq_rel);
+				}
+
+				bool TakeDispatch() { return dispatchPending.exchange(false, std::memory_order_acq_rel); }
+				std::size_t GetQueued() const { return queued.load(std::memory_order_acquire); }
+
+				std::vector<Cast> Drain(std::size_t maxCount)
+				{
+					std::vector<Cast> batch;
+					batch.reserve(std::min<std::size_t>(maxCount, queued.load(std::memory_order_acquire)));
+					{
+						std::scoped_lock guard(drainLock);
+						Cast cast;
+						while (batch.size() < maxCount && ring.TryPop(cast))
+							batch.push_back(cast);
+					}
+					queued.fetch_sub(batch.size(), std::memory_order_acq_rel);
+					return batch;
+				}
+
+			private:
+				MPSCRing<Cast, 1024> ring;
+				std::mutex drainLock;
+				std::atomic<std::size_t> queued{ 0 };
+				std::atomic<bool> dispatchPending{ false };
+			};
+		}
+
+		// CoalesceScrollCasts off (one ConcScrollCast/FFScrollCast event per cast) against on (one ScrollCastBatch
+		// event per frame, drained by each script), for bursts of casts within one frame.
+		void RunEvents(Runner& runner)
+		{
+			auto queue = std::make_unique<CastQueue>();
+			EventSource source;
+			std::uint64_t handled = 0;
+
+			for (const std::size_t burst : { std::size_t(1), std::size_t(8), std::size_t(64) }) {
+				const auto report = [&](std::string_view base, auto&& frame) {
+					const auto name = MakeName(base, burst, "casts");
+					if (!runner.Wants(name))
+						return;
+					auto result = runner.Measure(name, 5000, 1, frame);
+					result.counters.emplace_back("casts_per_frame", static_cast<double>(burst));
+					result.counters.emplace_back("ns_per_cast", result.nsPerCall / static_cast<double>(burst));
+					result.counters.emplace_back("allocs_per_cast", result.allocsPerCall / static_cast<double>(burst));
+					runner.Report(result);
+				};
+
+				report("events/perCast", [&] {
+					std::array<char, 16> caster{};
+					for (std::size_t i = 0; i < burst; i++) {
+						std::snprintf(caster.data(), caster.size(), "%x", 0x14u);  // the spell cast sink formats the caster's FormID
+						source.Send({ "FFScrollCast", caster.data(), 0.0f, static_cast<std::uint32_t>(0x01000800 + i) }, [&](const ModEvent& event) {
+							handled += event.sender;
+						});
+					}
+					source.RunQueued();
+				});
+
+				report("events/batched", [&] {
+					for (std::size_t i = 0; i < burst; i++)
+						queue->Push({ static_cast<std::uint32_t>(0x01000800 + i), 0x14, i });
+					if (queue->TakeDispatch()) {
+						source.Send({ "ScrollCastBatch", "", static_cast<float>(queue->GetQueued()), 0 }, [&](const ModEvent&) {
+							for (const auto& cast : queue->Drain(128))
+								handled += cast.scroll;
+						});
+					}
+					source.RunQueued();
+				});
+			}
+			sink = sink + handled;
+		}
+	}
+}
@@ -0,0 +1,204 @@
+#include "Bench.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			struct Keyword
+			{
+				std::uint32_t formID;
+			};
+
+			struct Effect
+			{
+				float magnitude;
+			};
+
+			// Stand-in for a ScrollItem's storage as CommonLibSSE manages it: the keyword array is exactly
+			// numKeywords long and BGSKeywordForm::AddKeyword replaces it with a copy one longer; the effect
+			// array is a BSTArray, which starts at 4 elements and doubles.
+			struct Form
+			{
+				Form() = default;
+				Form(const Form&) = delete;
+				~Form()
+				{
+					std::free(keywords);
+					std::free(effects);
+				}
+
+				void AddKeyword(Keyword* keyword)
+				{
+					for (std::uint32_t i = 0; i < numKeywords; i++)
+						if (keywords[i] == keyword)
+							return;
+					auto grown = static_cast<Keyword**>(std::calloc(numKeywords + 1, sizeof(Keyword*)));
+					std::copy_n(keywords, numKeywords, grown);
+					grown[numKeywords++] = keyword;
+					std::free(keywords);
+					keywords = grown;
+					CountAllocation();
+				}
+
+				void SetKeywords(std::span<Keyword* const> list)
+				{
+					auto exact = list.empty() ? nullptr : static_cast<Keyword**>(std::calloc(list.size(), sizeof(Keyword*)));
+					std::ranges::copy(list, exact);
+					std::free(keywords);
+					keywords = exact;
+					numKeywords = static_cast<std::uint32_t>(list.size());
+					if (exact)
+						CountAllocation();
+				}
+
+				void ReserveEffects(std::uint32_t count)
+				{
+					if (count <= effectCapacity)
+						return;
+					auto grown = static_cast<Effect**>(std::malloc(count * sizeof(Effect*)));
+					std::copy_n(effects, numEffects, grown);
+					std::free(effects);
+					effects = grown;
+					effectCapacity = count;
+					CountAllocation();
+				}
+
+				void PushEffect(Effect* effect)
+				{
+					if (numEffects == effectCapacity)
+						ReserveEffects(effectCapacity == 0 ? 4 : effectCapacity * 2);
+					effects[numEffects++] = effect;
+				}
+
+				// The game heap is not operator new, so its allocations are counted here.
+				static void CountAllocation() { ++engineAllocations; }
+				static inline std::uint64_t engineAllocations = 0;
+
+				Keyword** keywords = nullptr;
+				std::uint32_t numKeywords = 0;
+				Effect** effects = nullptr;
+				std::uint32_t numEffects = 0;
+				std::uint32_t effectCapacity = 0;
+			};
+
+			// FormBuilder over the stand-in, as it works on a MagicItem.
+			class Builder
+			{
+			public:
+				explicit Builder(Form& form) :
+					form(form)
+				{
+					keywords.reserve(form.numKeywords + 8);
+					keywords.assign(form.keywords, form.keywords + form.numKeywords);
+					effects.reserve(form.numEffects + 4);
+					effects.assign(form.effects, form.effects + form.numEffects);
+				}
+
+				void AddKeyword(Keyword* keyword)
+				{
+					if (std::ranges::find(keywords, keyword) == keywords.end())
+						keywords.push_back(keyword);
+				}
+
+				void AddKeywords(const Form& source)
+				{
+					for (std::uint32_t i = 0; i < source.numKeywords; i++)
+						AddKeyword(source.keywords[i]);
+				}
+
+				void AddEffects(const Form& source)
+				{
+					effects.insert(effects.end(), source.effects, source.effects + source.numEffects);
+				}
+
+				void AddEffect(Effect* effect) { effects.push_back(effect); }
+
+				void Commit()
+				{
+					form.SetKeywords(keywords);
+					form.numEffects = 0;
+					form.ReserveEffects(static_cast<std::uint32_t>(effects.size()));
+					for (auto effect : effects)
+						form.PushEffect(effect);
+				}
+
+			private:
+				Form& form;
+				std::vector<Keyword*> keywords;
+				std::vector<Effect*> effects;
+			};
+		}
+
+		// A generated scroll (seven keywords added one by one, the spell's two effects plus disintegrate) and a fusion
+		// (both parents' keywords and effects) built piece by piece, then through FormBuilder.
+		// engine_allocs_per_call counts game-heap allocations of the stand-in form; allocs_per_call counts operator new.
+		void RunFormBuilder(Runner& runner)
+		{
+			std::array<Keyword, 12> keywords{};
+			std::array<Effect, 5> effects{};
+			Effect& disintegrate = effects.back();
+
+			Form spell;
+			for (std::size_t i = 0; i < 2; i++)
+				spell.PushEffect(&effects[i]);
+			Form parentOne, parentTwo;
+			for (std::size_t i = 0; i < 5; i++) {
+				parentOne.AddKeyword(&keywords[i]);
+				parentTwo.AddKeyword(&keywords[i + 3]);  // three shared with parentOne
+			}
+			parentOne.PushEffect(&effects[0]);
+			parentOne.PushEffect(&disintegrate);
+			parentTwo.PushEffect(&effects[2]);
+			parentTwo.PushEffect(&effects[3]);
+
+			const auto measure = [&](std::string_view name, auto&& build) {
+				if (!runner.Wants(name))
+					return;
+				const auto engineBefore = Form::engineAllocations;
+				auto result = runner.Measure(name, 20000, 1, [&] {
+					Form form;
+					build(form);
+					sink = sink + form.numKeywords + form.numEffects;
+				});
+				// Measure's warm-up call is the one extra.
+				result.counters.emplace_back("engine_allocs_per_call", static_cast<double>(Form::engineAllocations - engineBefore) / static_cast<double>(result.calls + 1));
+				runner.Report(result);
+			};
+
+			measure("formBuilder/generated/pieceByPiece", [&](Form& form) {
+				for (std::size_t i = 0; i < 7; i++)
+					form.AddKeyword(&keywords[i]);
+				for (std::uint32_t i = 0; i < spell.numEffects; i++)
+					form.PushEffect(spell.effects[i]);
+				form.PushEffect(&disintegrate);
+			});
+			measure("formBuilder/generated/builder", [&](Form& form) {
+				Builder builder(form);
+				for (std::size_t i = 0; i < 7; i++)
+					builder.AddKeyword(&keywords[i]);
+				builder.AddEffects(spell);
+				builder.AddEffect(&disintegrate);
+				builder.Commit();
+			});
+
+			measure("formBuilder/fusion/pieceByPiece", [&](Form& form) {
+				for (const Form* parent : { &parentOne, &parentTwo }) {
+					for (std::uint32_t i = 0; i < parent->numEffects; i++)
+						form.PushEffect(parent->effects[i]);
+					for (std::uint32_t i = 0; i < parent->numKeywords; i++)
+						form.AddKeyword(parent->keywords[i]);
+				}
+			});
+			measure("formBuilder/fusion/builder", [&](Form& form) {
+				Builder builder(form);
+				builder.AddEffects(parentOne);
+				builder.AddEffects(parentTwo);
+				builder.AddKeywords(parentOne);
+				builder.AddKeywords(parentTwo);
+				builder.Commit();
+			});
+		}
+	}
+}
@@ -0,0 +1,244 @@
+#include "Bench.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			constexpr std::size_t HISTORY = 10000;     // fusions recorded over every playthrough
+			constexpr std::size_t VANILLA = 400;       // scrolls a fusion can start from
+			constexpr std::size_t REFERENCED = 20;     // fusions one save actually holds
+			constexpr std::uint32_t FIRST_PRODUCT = 0xFF000800;
+
+			using FormKey = std::uint64_t;
+
+			// A [FUSION] line as Core writes it: "0xPRODUCT = Plugin~0xLocal+Plugin~0xLocal". Ingredients that are
+			// fusions themselves are written as bare runtime FormIDs.
+			std::vector<std::pair<std::string, std::string>> MakeHistory()
+			{
+				std::mt19937 random(35);
+				std::vector<std::pair<std::string, std::string>> lines;
+				lines.reserve(HISTORY);
+				std::array<char, 64> buffer{};
+				const auto ingredient = [&](std::size_t index) {
+					// One in five ingredients is an earlier fusion.
+					if (index > 0 && random() % 5 == 0)
+						std::snprintf(buffer.data(), buffer.size(), "0x%08X", FIRST_PRODUCT + static_cast<std::uint32_t>(random() % index));
+					else
+						std::snprintf(buffer.data(), buffer.size(), "%s~0x%08X", random() % 3 == 0 ? "Apocalypse - Magic of Skyrim.esp" : "Skyrim.esm", static_cast<std::uint32_t>(0x0010F000 + random() % VANILLA));
+					return std::string(buffer.data());
+				};
+				for (std::size_t i = 0; i < HISTORY; i++) {
+					std::snprintf(buffer.data(), buffer.size(), "0x%08X", FIRST_PRODUCT + static_cast<std::uint32_t>(i));
+					std::string key(buffer.data());
+					auto value = ingredient(i);
+					value += '+';
+					value += ingredient(i);
+					lines.emplace_back(std::move(key), std::move(value));
+				}
+				return lines;
+			}
+
+			std::uint32_t ParseHex(std::string_view text)
+			{
+				std::uint32_t value = 0;
+				if (!text.starts_with("0x") || std::from_chars(text.data() + 2, text.data() + text.size(), value, 16).ec != std::errc())
+					return 0;
+				return value;
+			}
+
+			// PluginNames and the load order, reduced to what FusionRegistry::Add needs.
+			struct LoadOrder
+			{
+				std::uint32_t Intern(std::string_view name)
+				{
+					if (auto it = byName.find(name); it != byName.end())
+						return it->second;
+					names.emplace_back(name);
+					return byName.emplace(names.back(), static_cast<std::uint32_t>(names.size())).first->second;
+				}
+
+				std::uint32_t Resolve(FormKey key) const
+				{
+					const auto plugin = static_cast<std::uint32_t>(key >> 32);
+					const auto local = static_cast<std::uint32_t>(key);
+					return plugin == 0 ? local : (plugin << 24) | local;
+				}
+
+				std::deque<std::string> names;
+				std::unordered_map<std::string_view, std::uint32_t> byName;
+			};
+
+			struct Ingredient
+			{
+				FormKey key;
+				std::uint32_t resolved;
+			};
+
+			struct Record
+			{
+				Ingredient left;
+				Ingredient right;
+				bool legacy;
+			};
+
+			Ingredient ParseIngredient(LoadOrder& order, std::string_view part)
+			{
+				const auto tilde = part.find('~');
+				if (tilde == std::string_view::npos)
+					return { ParseHex(part), 0 };
+				return { (static_cast<FormKey>(order.Intern(part.substr(0, tilde))) << 32) | ParseHex(part.substr(tilde + 1)), 0 };
+			}
+
+			// FusionRegistry's pending table.
+			struct Registry
+			{
+				std::unordered_map<std::uint32_t, Record> pending;
+				std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> byIngredients;
+			};
+
+			// FusionRegistry::LoadLegacy: every line becomes a Record with its ingredients resolved, nothing more.
+			void LoadLegacy(const std::vector<std::pair<std::string, std::string>>& lines, LoadOrder& order, Registry& registry)
+			{
+				for (const auto& [key, value] : lines) {
+					const auto product = ParseHex(key);
+					const std::string_view text(value);
+					const auto plus = text.find('+');
+					if (product == 0 || plus == std::string_view::npos)
+						continue;
+
+					Record record{ ParseIngredient(order, text.substr(0, plus)), ParseIngredient(order, text.substr(plus + 1)), true };
+					record.left.resolved = order.Resolve(record.left.key);
+					record.right.resolved = order.Resolve(record.right.key);
+					registry.byIngredients.insert_or_assign({ record.left.resolved, record.right.resolved }, product);
+					registry.pending.insert_or_assign(product, std::move(record));
+				}
+			}
+
+			// What FuseAndCreateFunc leaves behind per fusion: the scroll with its name, keywords and effects, and for
+			// concentration fusions a second spell form.
+			struct Scroll
+			{
+				std::string fullName;
+				std::vector<std::uint32_t> keywords;
+				std::vector<std::uint32_t> effects;
+				std::unique_ptr<Scroll> concentrationSpell;
+			};
+
+			struct World
+			{
+				World()
+				{
+					static constexpr std::array<std::string_view, 8> SPELLS{ "Fireball", "Ice Storm", "Chain Lightning", "Fury",
+						"Calm", "Paralyze", "Conjure Flame Atronach", "Fast Healing" };
+					for (std::size_t i = 0; i < VANILLA; i++) {
+						auto scroll = std::make_unique<Scroll>();
+						scroll->fullName = "Scroll of ";
+						scroll->fullName += SPELLS[i % SPELLS.size()];
+						scroll->keywords = { 0x1EA6E, 0x1CEAD, static_cast<std::uint32_t>(0x0800 + i % 7) };
+						scroll->effects = { static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(i + 1) };
+						vanilla.push_back(std::move(scroll));
+					}
+				}
+
+				const Scroll* Lookup(std::uint32_t formID) const
+				{
+					if (formID >= FIRST_PRODUCT) {
+						auto it = fused.find(formID);
+						return it == fused.end() ? nullptr : it->second.get();
+					}
+					return vanilla[(formID & 0x00FFFFFF) - 0x0010F000].get();
+				}
+
+				std::vector<std::unique_ptr<Scroll>> vanilla;
+				std::unordered_map<std::uint32_t, std::unique_ptr<Scroll>> fused;
+			};
+
+			std::string ExtractSpellName(const std::string& input)
+			{
+				static const std::regex pattern(R"(\bScroll\s+of\s+([^\(\)-]+)\b)");
+				std::smatch match;
+				if (std::regex_search(input, match, pattern))
+					return match[1];
+				return "<No Spell Name Found>";
+			}
+
+			std::unique_ptr<Scroll> Fuse(const Scroll& one, const Scroll& two)
+			{
+				auto scroll = std::make_unique<Scroll>();
+				scroll->effects = one.effects;
+				scroll->effects.insert(scroll->effects.end(), two.effects.begin(), two.effects.end());
+				scroll->keywords = one.keywords;
+				for (const auto keyword : two.keywords)
+					if (std::ranges::find(scroll->keywords, keyword) == scroll->keywords.end())
+						scroll->keywords.push_back(keyword);
+				scroll->keywords.push_back(0x82C);
+				scroll->fullName = "Fused Scroll of " + ExtractSpellName(one.fullName) + " & " + ExtractSpellName(two.fullName);
+				if (scroll->effects.front() % 4 == 0) {
+					scroll->fullName += " - Concentration";
+					scroll->concentrationSpell = std::make_unique<Scroll>();
+					scroll->concentrationSpell->effects = scroll->effects;
+				}
+				return scroll;
+			}
+
+			// Materialize: build the product, and first any fused ingredient it depends on.
+			const Scroll* Materialize(const Registry& registry, World& world, std::uint32_t product)
+			{
+				if (auto existing = world.Lookup(product))
+					return existing;
+				auto it = registry.pending.find(product);
+				if (it == registry.pending.end())
+					return nullptr;
+				auto left = Materialize(registry, world, it->second.left.resolved);
+				auto right = Materialize(registry, world, it->second.right.resolved);
+				if (left == nullptr || right == nullptr)
+					return nullptr;
+				return world.fused.emplace(product, Fuse(*left, *right)).first->second.get();
+			}
+		}
+
+		// Startup with 10k historical fusions: parsing them into the pending table (what kDataLoaded now does), against
+		// also building every fused scroll as LoadFused did. lazy+save adds materializing the few fusions one save holds.
+		// Scrolls are plain structs here, so eager understates the game's cost; the form count is the "forms" counter.
+		void RunFusion(Runner& runner)
+		{
+			const auto lines = MakeHistory();
+			std::mt19937 random(350);
+			std::vector<std::uint32_t> referenced;
+			for (std::size_t i = 0; i < REFERENCED; i++)
+				referenced.push_back(FIRST_PRODUCT + static_cast<std::uint32_t>(random() % HISTORY));
+
+			const auto measure = [&](std::string_view name, std::size_t samples, auto&& startup) {
+				if (!runner.Wants(name))
+					return;
+				std::size_t forms = 0;
+				auto result = runner.Measure(name, samples, 1, [&] {
+					LoadOrder order;
+					Registry registry;
+					World world;
+					LoadLegacy(lines, order, registry);
+					startup(registry, world);
+					forms = world.fused.size();
+					for (const auto& [product, scroll] : world.fused)
+						forms += scroll->concentrationSpell ? 1 : 0;
+					sink = sink + registry.pending.size();
+				});
+				result.counters.emplace_back("fusions", static_cast<double>(HISTORY));
+				result.counters.emplace_back("forms", static_cast<double>(forms));
+				runner.Report(result);
+			};
+
+			measure("fusion/startup/lazy", 20, [](Registry&, World&) {});
+			measure("fusion/startup/lazy+save", 20, [&](Registry& registry, World& world) {
+				for (const auto product : referenced)
+					Materialize(registry, world, product);
+			});
+			measure("fusion/startup/eager", 5, [](Registry& registry, World& world) {
+				for (std::uint32_t i = 0; i < HISTORY; i++)
+					Materialize(registry, world, FIRST_PRODUCT + i);
+			});
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#include "Bench.h"
+#include "DustKernel.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		// Pass 2 of GenerateDynamicScrolls over a modded load order's worth of tomes.
+		void RunKernel(Runner& runner)
+		{
+			constexpr std::size_t TOMES = 4096;
+
+			std::mt19937 random(32);
+			std::vector<std::int32_t> rank(TOMES), level(TOMES);
+			std::vector<float> costliest(TOMES), costOverride(TOMES);
+			std::vector<std::uint8_t> concentration(TOMES);
+			for (std::size_t i = 0; i < TOMES; i++) {
+				rank[i] = static_cast<std::int32_t>(random() % 6);
+				level[i] = static_cast<std::int32_t>(random() % 111);
+				costliest[i] = static_cast<float>(random() % 90000) / 100.0f;
+				costOverride[i] = random() % 10 == 0 ? static_cast<float>(random() % 700) : 0.0f;
+				concentration[i] = random() % 5 == 0;
+			}
+
+			std::vector<std::int32_t> baseDust(TOMES), reducedDust(TOMES);
+			std::vector<std::uint8_t> tier(TOMES), filterIndex(TOMES);
+			const KERNEL::DustInputs in{ rank, level, costliest, costOverride, concentration };
+			const KERNEL::DustOutputs out{ baseDust, reducedDust, tier, filterIndex };
+
+			const auto measure = [&](std::string_view name, void (*pass)(const KERNEL::DustInputs&, const KERNEL::DustOutputs&)) {
+				if (!runner.Wants(name))
+					return;
+				auto result = runner.Measure(name, 2000, 1, [&] {
+					pass(in, out);
+					sink = sink + static_cast<std::uint64_t>(baseDust[TOMES / 2]);
+				});
+				result.counters.emplace_back("tomes", static_cast<double>(TOMES));
+				result.counters.emplace_back("ns_per_tome", result.nsPerCall / TOMES);
+				runner.Report(result);
+			};
+			measure("kernel/ClassifyBatch", KERNEL::ClassifyBatch);
+			measure("kernel/ClassifyScalar", KERNEL::ClassifyScalar);
+		}
+	}
+}
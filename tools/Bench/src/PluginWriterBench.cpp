@@ -0,0 +1,85 @@
+#include "Bench.h"
+#include "PluginWriter.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			using ESP::MakeSignature;
+			using ESP::PluginWriter;
+
+			// The subrecords PluginExport writes per scroll and per recipe, with stand-in values.
+			void WritePlugin(PluginWriter& writer, std::uint32_t scrolls, std::uint32_t recipesPerScroll)
+			{
+				const std::vector<std::string> masters{ "Skyrim.esm", "ScrollScribeNG.esp" };
+				writer.WriteHeader(PluginWriter::FLAG_MASTER | PluginWriter::FLAG_LIGHT, masters, 0x800 + scrolls * (1 + recipesPerScroll), "ScrollScribeNG");
+
+				std::array<char, 32> editorID{};
+				writer.BeginGroup(MakeSignature("SCRL"));
+				for (std::uint32_t i = 0; i < scrolls; i++) {
+					writer.BeginRecord(MakeSignature("SCRL"), 0x02000800 + i);
+					std::snprintf(editorID.data(), editorID.size(), "_scrGenScroll%03X", i);
+					writer.AddString(MakeSignature("EDID"), editorID.data());
+					writer.AddFields(MakeSignature("OBND"), std::array<std::int16_t, 6>{});
+					writer.AddString(MakeSignature("FULL"), "Scroll of Incinerate");
+					const std::array<std::uint32_t, 3> keywords{ 0x0001EA71, 0x0001CEAD, 0x000A0E56 };
+					writer.AddFields(MakeSignature("KSIZ"), static_cast<std::uint32_t>(keywords.size()));
+					writer.AddSubrecord(MakeSignature("KWDA"), std::as_bytes(std::span(keywords)));
+					writer.AddFields(MakeSignature("MDOB"), std::uint32_t(0x0001C6BD));
+					writer.AddFields(MakeSignature("ETYP"), std::uint32_t(0x00013F44));
+					writer.AddString(MakeSignature("MODL"), "Clutter\\Common\\Scroll05.nif");
+					writer.AddFields(MakeSignature("DATA"), std::uint32_t(74), 0.5f);
+					writer.AddFields(MakeSignature("SPIT"), std::uint32_t(0), std::uint32_t(0), std::uint32_t(0), 0.0f, std::uint32_t(1), std::uint32_t(2), 0.0f, 0.0f, std::uint32_t(0));
+					for (std::uint32_t e = 0; e < 2; e++) {
+						writer.AddFields(MakeSignature("EFID"), std::uint32_t(0x00013CA9 + e));
+						writer.AddFields(MakeSignature("EFIT"), 40.0f, std::uint32_t(0), std::uint32_t(0));
+					}
+					writer.EndRecord();
+				}
+				writer.EndGroup();
+
+				writer.BeginGroup(MakeSignature("COBJ"));
+				for (std::uint32_t i = 0; i < scrolls * recipesPerScroll; i++) {
+					writer.BeginRecord(MakeSignature("COBJ"), 0x02000800 + scrolls + i);
+					std::snprintf(editorID.data(), editorID.size(), "_scrGenRecipe%03X", i);
+					writer.AddString(MakeSignature("EDID"), editorID.data());
+					writer.AddFields(MakeSignature("COCT"), std::uint32_t(2));
+					writer.AddFields(MakeSignature("CNTO"), std::uint32_t(0x01000D62), std::int32_t(74));
+					writer.AddFields(MakeSignature("CNTO"), std::uint32_t(0x01000D63), std::int32_t(1));
+					for (std::uint32_t c = 0; c < 6; c++)
+						writer.AddFields(MakeSignature("CTDA"), std::uint8_t(c < 2 ? 0x01 : 0x00), std::array<std::uint8_t, 3>{}, 1.0f, std::uint16_t(74), std::uint16_t(0), std::uint32_t(0x01000D70 + c), std::uint32_t(0), std::uint32_t(0), std::uint32_t(0), std::int32_t(-1));
+					writer.AddFields(MakeSignature("CNAM"), std::uint32_t(0x02000800 + i / recipesPerScroll));
+					writer.AddFields(MakeSignature("BNAM"), std::uint32_t(0x01000D80));
+					writer.AddFields(MakeSignature("NAM1"), std::uint16_t(1));
+					writer.EndRecord();
+				}
+				writer.EndGroup();
+				writer.Finish();
+			}
+		}
+
+		// Export of a large load order: 1000 scrolls with two recipes each.
+		void RunPluginWriter(Runner& runner)
+		{
+			constexpr std::uint32_t SCROLLS = 1000;
+			constexpr std::uint32_t RECIPES = 2;
+
+			const auto name = "pluginWriter/export1000"sv;
+			if (!runner.Wants(name))
+				return;
+
+			std::size_t bytes = 0;
+			auto result = runner.Measure(name, 200, 1, [&] {
+				PluginWriter writer;
+				WritePlugin(writer, SCROLLS, RECIPES);
+				bytes = writer.GetData().size();
+				sink = sink + bytes;
+			});
+			result.counters.emplace_back("bytes", static_cast<double>(bytes));
+			result.counters.emplace_back("ns_per_record", result.nsPerCall / (SCROLLS * (1 + RECIPES)));
+			runner.Report(result);
+		}
+	}
+}
@@ -0,0 +1,83 @@
+#include "Bench.h"
+#include "Postings.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			using QUERY::Postings;
+
+			// The posting lists ScrollIndex::Build keeps, over synthetic scrolls.
+			struct Index
+			{
+				Postings all;
+				std::array<Postings, 6> bySchool;
+				std::array<Postings, 5> byTier;
+				Postings fireAndForget;
+				Postings concentration;
+				std::vector<Postings> byKeyword;
+			};
+
+			Index MakeIndex(std::uint32_t scrolls, std::size_t keywords)
+			{
+				std::mt19937 random(34);
+				Index index;
+				index.byKeyword.resize(keywords);
+				for (std::uint32_t id = 0; id < scrolls; id++) {
+					index.all.push_back(id);
+					index.bySchool[random() % 6].push_back(id);
+					index.byTier[std::min<std::uint32_t>(random() % 7, 4)].push_back(id);  // low tiers are the most common
+					(random() % 4 == 0 ? index.concentration : index.fireAndForget).push_back(id);
+					for (std::size_t k = 0; k < 2; k++)
+						index.byKeyword[random() % keywords].push_back(id);
+				}
+				for (auto& list : index.byKeyword)
+					list.erase(std::unique(list.begin(), list.end()), list.end());
+				return index;
+			}
+		}
+
+		// The list choices ScrollIndex::Find makes for typical FindScrolls filters, then its merge and intersection.
+		void RunQuery(Runner& runner)
+		{
+			constexpr std::uint32_t SCROLLS = 20000;
+			constexpr std::size_t PAGE = 20;
+			const auto index = MakeIndex(SCROLLS, 64);
+
+			const auto measure = [&](std::string_view name, auto&& makeLists) {
+				runner.Run(name, 20000, 1, [&] {
+					Postings tierUnion;
+					std::vector<const Postings*> lists;
+					makeLists(lists, tierUnion);
+					sink = sink + QUERY::IntersectPostings(lists, 0, PAGE).size();
+				});
+			};
+
+			measure("query/all", [&](auto& lists, auto&) { lists.push_back(&index.all); });
+			measure("query/school", [&](auto& lists, auto&) { lists.push_back(&index.bySchool[2]); });
+			measure("query/school+casting", [&](auto& lists, auto&) {
+				lists.push_back(&index.bySchool[2]);
+				lists.push_back(&index.concentration);
+			});
+			measure("query/school+tierRange", [&](auto& lists, auto& tierUnion) {
+				lists.push_back(&index.bySchool[2]);
+				tierUnion = QUERY::MergePostings(std::span(index.byTier).subspan(1, 3));
+				lists.push_back(&tierUnion);
+			});
+			measure("query/keyword+school+casting+tier", [&](auto& lists, auto&) {
+				lists.push_back(&index.byKeyword[7]);
+				lists.push_back(&index.bySchool[2]);
+				lists.push_back(&index.fireAndForget);
+				lists.push_back(&index.byTier[0]);
+			});
+
+			// Paging deep into a large result copies only the page, but still intersects everything before it.
+			runner.Run("query/school+casting/page50", 20000, 1, [&] {
+				std::vector<const Postings*> lists{ &index.bySchool[0], &index.fireAndForget };
+				sink = sink + QUERY::IntersectPostings(lists, 50 * PAGE, PAGE).size();
+			});
+		}
+	}
+}
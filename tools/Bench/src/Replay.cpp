@@ -0,0 +1,395 @@
+#include "Bench.h"
+#include "Postings.h"
+#include "Stats.h"
+#include "TraceReader.h"
+#include "Valuation.h"
+
+// Replays a native call trace (TraceNativeCalls in the plugin's INI) against stand-in forms.
+//
+//   ScrollScribeReplay trace [--print] [--paced] [--repeat count]
+//
+// --print lists the recorded calls instead. Replay runs at full speed unless --paced, which keeps the recorded
+// gaps between calls. Gold valuation and FindScrolls are re-driven; the other natives need game forms and are
+// counted as skipped. Every FormID in the trace gets a stand-in derived from the ID, so replays are repeatable.
+// Output is one JSON object per native (see Bench.h) plus "replay/total", with the in-game latencies as counters.
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			using STATS::Native;
+
+			constexpr std::size_t ENCHANTMENTS = 150;
+			constexpr std::uint32_t SCROLLS = 2000;
+			constexpr std::int32_t ANY = -1;
+
+			void Print(const TRACE::Call& call)
+			{
+				std::printf("%14.3f ms %10u ns  %.*s(", static_cast<double>(call.timestamp) / 1e6, call.duration,
+					static_cast<int>(STATS::GetName(static_cast<Native>(call.native)).size()), STATS::GetName(static_cast<Native>(call.native)).data());
+				std::size_t array = 0;
+				for (std::size_t i = 0; i < call.args.size(); i++) {
+					if (i > 0)
+						std::printf(", ");
+					if ((call.arrayMask & (1u << i)) == 0) {
+						std::printf("0x%08X", call.args[i]);
+						continue;
+					}
+					std::printf("[");
+					for (std::size_t e = 0; e < call.arrays[array].size(); e++)
+						std::printf(e == 0 ? "0x%08X" : ", 0x%08X", call.arrays[array][e]);
+					std::printf("]");
+					array++;
+				}
+				std::printf(")\n");
+			}
+
+			// The forms and the scroll index the replayed natives read, made up from the IDs the trace mentions.
+			class World
+			{
+			public:
+				explicit World(const TRACE::Trace& trace)
+				{
+					std::mt19937 random(41);
+					for (std::size_t i = 0; i < ENCHANTMENTS; i++) {
+						auto enchantment = std::make_unique<Enchantment>();
+						for (std::size_t e = 0; e < 1 + random() % 3; e++)
+							enchantment->effects.push_back({ 0.5f + static_cast<float>(random() % 40) / 10.0f, static_cast<float>(5 + random() % 50), static_cast<std::uint32_t>(random() % 60) });
+						enchantments.push_back(std::move(enchantment));
+					}
+
+					for (std::uint32_t id = 0; id < SCROLLS; id++) {
+						all.push_back(id);
+						bySchool[random() % bySchool.size()].push_back(id);
+						byTier[std::min<std::uint32_t>(random() % 7, 4)].push_back(id);
+						(random() % 4 == 0 ? concentration : fireAndForget).push_back(id);
+					}
+
+					// Built up front so the replay times the natives, not the stand-ins.
+					for (const auto& call : trace.calls) {
+						switch (static_cast<Native>(call.native)) {
+						case Native::kGetApproxFullGoldValue:
+							if (!call.args.empty())
+								AddForm(call.args[0]);
+							break;
+						case Native::kGetApproxFullGoldValues:
+							for (const auto& array : call.arrays)
+								for (const auto formID : array)
+									AddForm(formID);
+							break;
+						case Native::kGetInventoryGoldValue:
+							if (!call.args.empty())
+								AddContainer(call.args[0]);
+							break;
+						case Native::kFindScrolls:
+							if (call.args.size() > 4)
+								AddKeyword(call.args[4]);
+							break;
+						default:
+							break;
+						}
+					}
+				}
+
+				// False for natives (or version 1 array calls) that cannot be re-driven here.
+				bool Call(const TRACE::Call& call)
+				{
+					switch (static_cast<Native>(call.native)) {
+					case Native::kGetApproxFullGoldValue:
+						if (call.args.empty())
+							return false;
+						sink = sink + static_cast<std::uint64_t>(Value(call.args[0]));
+						return true;
+					case Native::kGetApproxFullGoldValues:
+						{
+							if (call.arrays.empty())
+								return false;
+							std::vector<std::int32_t> result;
+							result.reserve(call.arrays[0].size());
+							for (const auto formID : call.arrays[0])
+								result.push_back(Value(formID));
+							sink = sink + result.size();
+							return true;
+						}
+					case Native::kGetInventoryGoldValue:
+						if (call.args.empty())
+							return false;
+						sink = sink + static_cast<std::uint64_t>(InventoryValue(call.args[0]));
+						return true;
+					case Native::kFindScrolls:
+						if (call.args.size() < 7)
+							return false;
+						sink = sink + FindScrolls(call.args).size();
+						return true;
+					default:
+						return false;
+					}
+				}
+
+			private:
+				void AddForm(std::uint32_t formID)
+				{
+					if (formID == 0x0 || forms.contains(formID))
+						return;
+					std::mt19937 random(formID);
+					std::unique_ptr<Form> form;
+					Enchantment* enchantment = random() % 3 != 0 ? enchantments[random() % ENCHANTMENTS].get() : nullptr;
+					switch (random() % 3) {
+					case 0:
+						form = std::make_unique<Form>();
+						form->formType = FormType::kMisc;
+						break;
+					case 1:
+						{
+							auto weapon = std::make_unique<Weapon>();
+							weapon->formType = FormType::kWeapon;
+							weapon->formEnchanting = enchantment;
+							form = std::move(weapon);
+							break;
+						}
+					default:
+						{
+							auto armor = std::make_unique<Armor>();
+							armor->formType = FormType::kArmor;
+							armor->formEnchanting = enchantment;
+							form = std::move(armor);
+							break;
+						}
+					}
+					form->goldValue = static_cast<std::int32_t>(10 + random() % 2000);
+					forms.emplace(formID, std::move(form));
+				}
+
+				// A container holds 20 to 300 kinds of item, with IDs of its own.
+				void AddContainer(std::uint32_t formID)
+				{
+					if (formID == 0x0 || containers.contains(formID))
+						return;
+					std::mt19937 random(formID);
+					std::vector<std::pair<std::uint32_t, std::int32_t>> inventory(20 + random() % 281);
+					for (auto& [item, count] : inventory) {
+						item = 0xFE000000 | (random() & 0x00FFFFFF);
+						count = static_cast<std::int32_t>(1 + random() % 5);
+						AddForm(item);
+					}
+					containers.emplace(formID, std::move(inventory));
+				}
+
+				void AddKeyword(std::uint32_t formID)
+				{
+					if (formID == 0x0 || byKeyword.contains(formID))
+						return;
+					std::mt19937 random(formID);
+					auto& list = byKeyword[formID];
+					for (std::uint32_t id = 0; id < SCROLLS; id++)
+						if (random() % 16 == 0)
+							list.push_back(id);
+				}
+
+				std::int32_t Value(std::uint32_t formID)
+				{
+					auto it = forms.find(formID);
+					return it == forms.end() ? 0 : GetApproxFullGoldValue(it->second.get(), values);
+				}
+
+				std::int32_t InventoryValue(std::uint32_t formID)
+				{
+					auto it = containers.find(formID);
+					if (it == containers.end())
+						return 0;
+					std::int64_t total = 0;
+					for (const auto& [item, count] : it->second)
+						total += static_cast<std::int64_t>(Value(item)) * count;
+					return static_cast<std::int32_t>(std::clamp<std::int64_t>(total, 0, std::numeric_limits<std::int32_t>::max()));
+				}
+
+				// ScrollIndex::Find over the stand-in index; args are school, minTier, maxTier, castingType, keyword,
+				// offset and count as FindScrolls receives them.
+				QUERY::Postings FindScrolls(std::span<const std::uint32_t> args)
+				{
+					constexpr std::int32_t maxTierIndex = static_cast<std::int32_t>(std::tuple_size_v<decltype(byTier)>) - 1;
+					const auto school = static_cast<std::int32_t>(args[0]);
+					const auto castingType = static_cast<std::int32_t>(args[3]);
+
+					std::vector<const QUERY::Postings*> lists;
+					QUERY::Postings tierUnion;
+					if (school != ANY) {
+						if (school < 0 || school >= static_cast<std::int32_t>(bySchool.size()))
+							return {};
+						lists.push_back(&bySchool[school]);
+					}
+					if (castingType != ANY) {
+						if (castingType != 1 && castingType != 2)  // RE::MagicSystem::CastingType: fire and forget, concentration
+							return {};
+						lists.push_back(castingType == 1 ? &fireAndForget : &concentration);
+					}
+					if (args[4] != 0x0) {
+						auto it = byKeyword.find(args[4]);
+						if (it == byKeyword.end())
+							return {};
+						lists.push_back(&it->second);
+					}
+
+					const auto minTier = std::max<std::int32_t>(static_cast<std::int32_t>(args[1]) == ANY ? 0 : static_cast<std::int32_t>(args[1]), 0);
+					const auto maxTier = std::min<std::int32_t>(static_cast<std::int32_t>(args[2]) == ANY ? maxTierIndex : static_cast<std::int32_t>(args[2]), maxTierIndex);
+					if (minTier > maxTier)
+						return {};
+					if (minTier > 0 || maxTier < maxTierIndex) {
+						if (minTier == maxTier) {
+							lists.push_back(&byTier[minTier]);
+						} else {
+							tierUnion = QUERY::MergePostings(std::span(byTier).subspan(minTier, maxTier - minTier + 1));
+							lists.push_back(&tierUnion);
+						}
+					}
+					if (lists.empty())
+						lists.push_back(&all);
+
+					const auto offset = std::max<std::int32_t>(static_cast<std::int32_t>(args[5]), 0);
+					const auto count = std::max<std::int32_t>(static_cast<std::int32_t>(args[6]), 0);
+					return QUERY::IntersectPostings(lists, static_cast<std::size_t>(offset), static_cast<std::size_t>(count));
+				}
+
+				std::vector<std::unique_ptr<Enchantment>> enchantments;
+				std::unordered_map<std::uint32_t, std::unique_ptr<Form>> forms;
+				std::unordered_map<std::uint32_t, std::vector<std::pair<std::uint32_t, std::int32_t>>> containers;
+				ValueMap values;
+
+				QUERY::Postings all;
+				std::array<QUERY::Postings, 5> bySchool;
+				std::array<QUERY::Postings, 5> byTier;
+				QUERY::Postings fireAndForget;
+				QUERY::Postings concentration;
+				std::unordered_map<std::uint32_t, QUERY::Postings> byKeyword;
+			};
+
+			struct NativeTimes
+			{
+				std::vector<double> replayed;
+				std::vector<double> recorded;
+				std::uint64_t allocations = 0;
+				std::uint64_t skipped = 0;
+			};
+
+			int Replay(const TRACE::Trace& trace, bool paced, std::size_t repeat)
+			{
+				using Clock = std::chrono::steady_clock;
+
+				World world(trace);
+				std::array<NativeTimes, static_cast<std::size_t>(Native::kTotal) + 1> times;  // the last one collects unknown natives
+				const auto firstTimestamp = trace.calls.empty() ? 0 : trace.calls.front().timestamp;
+
+				const auto wallStart = Clock::now();
+				for (std::size_t r = 0; r < repeat; r++) {
+					const auto passStart = Clock::now();
+					for (const auto& call : trace.calls) {
+						if (paced)
+							std::this_thread::sleep_until(passStart + std::chrono::nanoseconds(call.timestamp - firstTimestamp));
+
+						auto& native = times[std::min<std::size_t>(call.native, static_cast<std::size_t>(Native::kTotal))];
+						const auto allocationsBefore = GetAllocationCount();
+						const auto start = Clock::now();
+						const bool replayed = world.Call(call);
+						const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+						if (!replayed) {
+							native.skipped++;
+							continue;
+						}
+						native.allocations += GetAllocationCount() - allocationsBefore;
+						native.replayed.push_back(elapsed.count());
+						native.recorded.push_back(static_cast<double>(call.duration));
+					}
+				}
+				const std::chrono::duration<double> wall = Clock::now() - wallStart;
+
+				const Runner runner("", 1.0);
+				std::vector<double> allReplayed;
+				std::uint64_t allocations = 0;
+				std::uint64_t skipped = 0;
+				for (std::size_t n = 0; n < times.size(); n++) {
+					auto& native = times[n];
+					skipped += native.skipped;
+					if (native.replayed.empty())
+						continue;
+					allReplayed.insert(allReplayed.end(), native.replayed.begin(), native.replayed.end());
+					allocations += native.allocations;
+
+					Result result;
+					result.name = "replay/";
+					result.name += STATS::GetName(static_cast<Native>(n));
+					result.calls = native.replayed.size();
+					result.nsPerCall = std::accumulate(native.replayed.begin(), native.replayed.end(), 0.0) / static_cast<double>(result.calls);
+					result.allocsPerCall = static_cast<double>(native.allocations) / static_cast<double>(result.calls);
+					result.p50 = Runner::Percentile(native.replayed, 0.50);
+					result.p99 = Runner::Percentile(native.replayed, 0.99);
+					// In game the duration includes the VM wrapper and the real forms, so compare shapes, not values.
+					result.counters.emplace_back("recorded_p50_ns", Runner::Percentile(native.recorded, 0.50));
+					result.counters.emplace_back("recorded_p99_ns", Runner::Percentile(native.recorded, 0.99));
+					runner.Report(result);
+				}
+
+				Result total;
+				total.name = "replay/total";
+				total.calls = allReplayed.size();
+				if (!allReplayed.empty()) {
+					total.nsPerCall = std::accumulate(allReplayed.begin(), allReplayed.end(), 0.0) / static_cast<double>(total.calls);
+					total.allocsPerCall = static_cast<double>(allocations) / static_cast<double>(total.calls);
+					total.p50 = Runner::Percentile(allReplayed, 0.50);
+					total.p99 = Runner::Percentile(allReplayed, 0.99);
+				}
+				total.counters.emplace_back("skipped", static_cast<double>(skipped));
+				total.counters.emplace_back("paced", paced ? 1.0 : 0.0);
+				total.counters.emplace_back("wall_s", wall.count());
+				total.counters.emplace_back("calls_per_s", static_cast<double>(total.calls) / wall.count());
+				runner.Report(total);
+				return 0;
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace SCRIBE;
+
+	std::filesystem::path path;
+	bool print = false;
+	bool paced = false;
+	std::size_t repeat = 1;
+	bool usage = false;
+	for (int i = 1; i < argc && !usage; i++) {
+		const std::string_view arg(argv[i]);
+		if (arg == "--print")
+			print = true;
+		else if (arg == "--paced")
+			paced = true;
+		else if (arg == "--repeat" && i + 1 < argc)
+			repeat = std::strtoul(argv[++i], nullptr, 10);
+		else if (path.empty() && !arg.starts_with("--"))
+			path = arg;
+		else
+			usage = true;
+	}
+	if (usage || path.empty() || repeat == 0) {
+		std::cerr << "Usage: ScrollScribeReplay trace [--print] [--paced] [--repeat count]\n";
+		return 1;
+	}
+
+	std::string error;
+	const auto trace = TRACE::ReadTrace(path, error);
+	if (!trace) {
+		std::cerr << path.string() << ": " << error << '\n';
+		return 1;
+	}
+	if (!error.empty())
+		std::cerr << path.string() << ": " << error << "; using the " << trace->calls.size() << " calls before it\n";
+
+	if (print) {
+		std::printf("version %u, %zu calls\n", trace->version, trace->calls.size());
+		for (const auto& call : trace->calls)
+			BENCH::Print(call);
+		return 0;
+	}
+	return BENCH::Replay(*trace, paced, repeat);
+}
@@ -0,0 +1,96 @@
+#include "TraceReader.h"
+
+namespace SCRIBE
+{
+	namespace TRACE
+	{
+		namespace
+		{
+			static_assert(std::endian::native == std::endian::little, "traces are little endian");
+
+			class Cursor
+			{
+			public:
+				explicit Cursor(std::span<const char> bytes) :
+					bytes(bytes) {}
+
+				template <typename T>
+				bool Read(T& value)
+				{
+					if (bytes.size() - position < sizeof(T))
+						return false;
+					std::memcpy(&value, bytes.data() + position, sizeof(T));
+					position += sizeof(T);
+					return true;
+				}
+
+				bool AtEnd() const { return position == bytes.size(); }
+				std::size_t GetRemaining() const { return bytes.size() - position; }
+				std::size_t GetPosition() const { return position; }
+
+			private:
+				std::span<const char> bytes;
+				std::size_t position = 0;
+			};
+		}
+
+		std::optional<Trace> ReadTrace(const std::filesystem::path& path, std::string& error)
+		{
+			std::ifstream file(path, std::ios::binary);
+			if (!file) {
+				error = "cannot open " + path.string();
+				return std::nullopt;
+			}
+			const std::vector<char> bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+
+			Cursor cursor(bytes);
+			std::array<char, 4> magic{};
+			std::uint16_t reserved = 0;
+			Trace trace{};
+			if (!cursor.Read(magic) || magic != MAGIC || !cursor.Read(trace.version) || !cursor.Read(reserved)) {
+				error = "not a native call trace";
+				return std::nullopt;
+			}
+			if (trace.version == 0 || trace.version > VERSION) {
+				error = "unsupported trace version " + std::to_string(trace.version);
+				return std::nullopt;
+			}
+
+			while (!cursor.AtEnd()) {
+				const auto start = cursor.GetPosition();
+				Call call{};
+				std::uint8_t argCount = 0;
+				bool complete = cursor.Read(call.timestamp) && cursor.Read(call.duration) && cursor.Read(call.native) && cursor.Read(argCount);
+				if (complete && trace.version >= 2)
+					complete = cursor.Read(call.arrayMask);
+				if (complete && argCount > MAX_ARGS) {
+					error = "record at byte " + std::to_string(start) + " has " + std::to_string(argCount) + " arguments";
+					return std::nullopt;
+				}
+
+				call.args.resize(argCount);
+				for (std::size_t i = 0; complete && i < argCount; i++)
+					complete = cursor.Read(call.args[i]);
+				for (std::size_t i = 0; complete && i < argCount; i++) {
+					if ((call.arrayMask & (1u << i)) == 0)
+						continue;
+					if (call.args[i] > cursor.GetRemaining() / sizeof(std::uint32_t)) {
+						complete = false;
+						break;
+					}
+					auto& elements = call.arrays.emplace_back(call.args[i]);
+					for (std::size_t e = 0; complete && e < elements.size(); e++)
+						complete = cursor.Read(elements[e]);
+				}
+
+				// The game may have quit mid-write; everything before the cut is still usable.
+				if (!complete) {
+					error = "trace ends inside the record at byte " + std::to_string(start);
+					break;
+				}
+				trace.calls.push_back(std::move(call));
+			}
+			return trace;
+		}
+	}
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "TraceFormat.h"
+
+namespace SCRIBE
+{
+	namespace TRACE
+	{
+		// One recorded native call; array arguments are already split out of the payload.
+		struct Call
+		{
+			std::uint64_t timestamp;  // ns since recording started
+			std::uint32_t duration;   // ns the call took in game
+			std::uint8_t native;      // STATS::Native
+			std::vector<std::uint32_t> args;
+			std::uint8_t arrayMask;
+			std::vector<std::vector<std::uint32_t>> arrays;  // one per set bit of arrayMask, in argument order
+		};
+
+		struct Trace
+		{
+			std::uint16_t version;
+			std::vector<Call> calls;
+		};
+
+		// Reads a version 1 or 2 trace. A malformed file returns nothing; a trace cut off mid-record (the game quit
+		// while writing) returns the calls before the cut. Either way error says what was wrong.
+		std::optional<Trace> ReadTrace(const std::filesystem::path& path, std::string& error);
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Concurrent.h"
+
+// Stand-ins for what GetApproxFullGoldValue reads, shared by the valuation benchmark and the trace replayer.
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		struct EffectItem
+		{
+			float baseCost;
+			float magnitude;
+			std::uint32_t duration;
+		};
+
+		// Stand-in for EnchantmentItem: CalculateTotalGoldValue walks the effects with the game's cost formula.
+		struct Enchantment
+		{
+			float CalculateTotalGoldValue() const
+			{
+				float total = 0.0f;
+				for (const auto& effect : effects)
+					total += effect.baseCost * std::pow(std::max<float>(effect.magnitude, 1.0f), 1.1f) * std::pow(std::max<float>(static_cast<float>(effect.duration) / 10.0f, 1.0f), 1.1f);
+				return total;
+			}
+
+			std::string fullName;
+			std::vector<EffectItem> effects;
+		};
+
+		enum class FormType : std::uint8_t
+		{
+			kMisc,
+			kWeapon,
+			kArmor
+		};
+
+		// Stand-in for TESForm and the two enchantable types, polymorphic so As<> is a real dynamic cast.
+		struct Form
+		{
+			virtual ~Form() = default;
+
+			template <typename T>
+			T* As() { return dynamic_cast<T*>(this); }
+
+			FormType formType;
+			std::int32_t goldValue;
+			std::string fullName;
+		};
+
+		struct Weapon : Form
+		{
+			Enchantment* formEnchanting;
+		};
+
+		struct Armor : Form
+		{
+			Enchantment* formEnchanting;
+		};
+
+		using ValueMap = ShardedMap<const Enchantment*, float>;
+
+		inline float GetEnchantmentGoldValue(ValueMap& values, const Enchantment* enchantment)
+		{
+			if (auto value = values.find(enchantment))
+				return *value;
+			return values.insertOrGet(enchantment, enchantment->CalculateTotalGoldValue());
+		}
+
+		// GetApproxFullGoldValueFunc: a switch on the form type, memoized enchantments, no logging.
+		inline std::int32_t GetApproxFullGoldValue(Form* form, ValueMap& values)
+		{
+			switch (form->formType) {
+			case FormType::kWeapon:
+				{
+					auto weapon = static_cast<Weapon*>(form);
+					if (weapon->formEnchanting == nullptr)
+						return weapon->goldValue;
+					return weapon->goldValue + static_cast<std::int32_t>(0.4 * GetEnchantmentGoldValue(values, weapon->formEnchanting));
+				}
+			case FormType::kArmor:
+				{
+					auto armor = static_cast<Armor*>(form);
+					if (armor->formEnchanting == nullptr)
+						return armor->goldValue;
+					return (armor->goldValue + static_cast<std::int32_t>(0.85 * GetEnchantmentGoldValue(values, armor->formEnchanting))) / 2;
+				}
+			default:
+				return form->goldValue;
+			}
+		}
+	}
+}
@@ -0,0 +1,152 @@
+#include "Bench.h"
+#include "Valuation.h"
+
+namespace SCRIBE
+{
+	namespace BENCH
+	{
+		namespace
+		{
+			constexpr std::size_t ITEMS = 1000;        // a large merchant inventory
+			constexpr std::size_t ENCHANTMENTS = 150;  // distinct enchantments among them
+
+			// The plugin log: each line is formatted and written through a file.
+			class Log
+			{
+			public:
+				Log() :
+					file(std::fopen("/dev/null", "w")) {}
+				~Log()
+				{
+					if (file)
+						std::fclose(file);
+				}
+
+				template <typename... Args>
+				void Info(const char* format, Args... args)
+				{
+					std::array<char, 256> line{};
+					const auto length = std::snprintf(line.data(), line.size(), format, args...);
+					if (file && length > 0)
+						std::fwrite(line.data(), 1, std::min<std::size_t>(static_cast<std::size_t>(length), line.size() - 1), file);
+				}
+
+			private:
+				std::FILE* file;
+			};
+
+			// GetApproxFullGoldValue before: two casts, the enchantment recomputed every call, two log lines.
+			std::int32_t ValueBefore(Form* form, Log& log)
+			{
+				if (auto weapon = form->As<Weapon>(); weapon != nullptr) {
+					log.Info("%s is weapon\n", form->fullName.c_str());
+					if (weapon->formEnchanting == nullptr)
+						return weapon->goldValue;
+					log.Info("%s has enchantment: %s\n", form->fullName.c_str(), weapon->formEnchanting->fullName.c_str());
+					return weapon->goldValue + static_cast<std::int32_t>(0.4 * weapon->formEnchanting->CalculateTotalGoldValue());
+				}
+				if (auto armor = form->As<Armor>(); armor != nullptr) {
+					log.Info("%s is armor\n", form->fullName.c_str());
+					if (armor->formEnchanting == nullptr)
+						return armor->goldValue;
+					log.Info("%s has enchantment: %s\n", form->fullName.c_str(), armor->formEnchanting->fullName.c_str());
+					return (armor->goldValue + static_cast<std::int32_t>(0.85 * armor->formEnchanting->CalculateTotalGoldValue())) / 2;
+				}
+				return form->goldValue;
+			}
+
+			struct Inventory
+			{
+				std::vector<std::unique_ptr<Enchantment>> enchantments;
+				std::vector<std::unique_ptr<Form>> items;
+			};
+
+			// A third each of misc items, weapons and armor; two in three weapons and armor pieces are enchanted.
+			Inventory MakeInventory()
+			{
+				std::mt19937 random(42);
+				Inventory inventory;
+				for (std::size_t i = 0; i < ENCHANTMENTS; i++) {
+					auto enchantment = std::make_unique<Enchantment>();
+					enchantment->fullName = "Enchantment " + std::to_string(i);
+					for (std::size_t e = 0; e < 1 + random() % 3; e++)
+						enchantment->effects.push_back({ 0.5f + static_cast<float>(random() % 40) / 10.0f, static_cast<float>(5 + random() % 50), static_cast<std::uint32_t>(random() % 60) });
+					inventory.enchantments.push_back(std::move(enchantment));
+				}
+				for (std::size_t i = 0; i < ITEMS; i++) {
+					std::unique_ptr<Form> item;
+					Enchantment* enchantment = random() % 3 != 0 ? inventory.enchantments[random() % ENCHANTMENTS].get() : nullptr;
+					switch (i % 3) {
+					case 0:
+						item = std::make_unique<Form>();
+						item->formType = FormType::kMisc;
+						break;
+					case 1:
+						{
+							auto weapon = std::make_unique<Weapon>();
+							weapon->formType = FormType::kWeapon;
+							weapon->formEnchanting = enchantment;
+							item = std::move(weapon);
+							break;
+						}
+					default:
+						{
+							auto armor = std::make_unique<Armor>();
+							armor->formType = FormType::kArmor;
+							armor->formEnchanting = enchantment;
+							item = std::move(armor);
+							break;
+						}
+					}
+					item->goldValue = static_cast<std::int32_t>(10 + random() % 2000);
+					item->fullName = "Item " + std::to_string(i);
+					inventory.items.push_back(std::move(item));
+				}
+				return inventory;
+			}
+		}
+
+		// Valuing a 1000-item inventory: one GetApproxFullGoldValue-style call per item as before, against the
+		// GetApproxFullGoldValues pass with the enchantment memo warm (as it stays in game) and cold (its first use).
+		// The Papyrus call overhead a script pays per native call is not modelled, so perItem understates the gap.
+		void RunValuation(Runner& runner)
+		{
+			const auto inventory = MakeInventory();
+
+			const auto measure = [&](std::string_view name, auto&& value) {
+				if (!runner.Wants(name))
+					return;
+				auto result = runner.Measure(name, 200, 1, value);
+				result.counters.emplace_back("items", static_cast<double>(ITEMS));
+				result.counters.emplace_back("ns_per_item", result.nsPerCall / static_cast<double>(ITEMS));
+				runner.Report(result);
+			};
+
+			Log log;
+			measure(MakeName("valuation/perItem", ITEMS, "items"), [&] {
+				std::int64_t total = 0;
+				for (const auto& item : inventory.items)
+					total += ValueBefore(item.get(), log);
+				sink = sink + static_cast<std::uint64_t>(total);
+			});
+
+			ValueMap warm;
+			measure(MakeName("valuation/batch/warm", ITEMS, "items"), [&] {
+				std::vector<std::int32_t> values;
+				values.reserve(inventory.items.size());
+				for (const auto& item : inventory.items)
+					values.push_back(GetApproxFullGoldValue(item.get(), warm));
+				sink = sink + values.size();
+			});
+
+			measure(MakeName("valuation/batch/cold", ITEMS, "items"), [&] {
+				ValueMap cold;
+				std::vector<std::int32_t> values;
+				values.reserve(inventory.items.size());
+				for (const auto& item : inventory.items)
+					values.push_back(GetApproxFullGoldValue(item.get(), cold));
+				sink = sink + values.size();
+			});
+		}
+	}
+}
@@ -0,0 +1,43 @@
+#include "Bench.h"
+
+// Micro-benchmarks of the plugin's hot paths that do not touch game types, on synthetic data.
+//
+//   ScrollScribeBench [--filter text] [--scale factor]
+//
+// Only measurements whose name contains the filter run; --scale multiplies every sample count.
+// Output is one JSON object per line (see Bench.h), so runs can be diffed or loaded as JSON Lines.
+
+int main(int argc, char* argv[])
+{
+	using namespace SCRIBE;
+
+	std::string filter;
+	double scale = 1.0;
+	for (int i = 1; i < argc; i++) {
+		const std::string_view arg(argv[i]);
+		if (arg == "--filter" && i + 1 < argc)
+			filter = argv[++i];
+		else if (arg == "--scale" && i + 1 < argc)
+			scale = std::strtod(argv[++i], nullptr);
+		else {
+			std::cerr << "Usage: ScrollScribeBench [--filter text] [--scale factor]\n";
+			return 1;
+		}
+	}
+	if (!(scale > 0.0)) {
+		std::cerr << "--scale must be positive\n";
+		return 1;
+	}
+
+	BENCH::Runner runner(filter, scale);
+	BENCH::RunKernel(runner);
+	BENCH::RunQuery(runner);
+	BENCH::RunConcurrent(runner);
+	BENCH::RunEvents(runner);
+	BENCH::RunConditions(runner);
+	BENCH::RunFormBuilder(runner);
+	BENCH::RunFusion(runner);
+	BENCH::RunPluginWriter(runner);
+	BENCH::RunValuation(runner);
+	return 0;
+}
@@ -0,0 +1,52 @@
+# Writes the native call traces the replay tests read. Run from this directory after changing it; the output is committed.
+#
+# sample.trace  version 2, every kind of argument: forms, ints, None, an array; natives the replayer re-drives and skips
+# cut.trace     sample.trace with its last record cut short, as when the game quits mid-write
+import struct
+
+MAGIC = b'SSNT'
+VERSION = 2
+
+# STATS::Native
+FUSE_AND_CREATE = 0
+CAN_FUSE = 1
+GET_ZERO_COST_COPY = 4
+GET_APPROX_FULL_GOLD_VALUE = 5
+FIND_SCROLLS = 8
+GET_APPROX_FULL_GOLD_VALUES = 9
+GET_INVENTORY_GOLD_VALUE = 10
+
+ANY = 0xFFFFFFFF  # -1 as the recorder stores it
+
+
+# args holds None where an array goes; arrays fills those slots in order.
+def record(timestamp, duration, native, args, arrays=()):
+    mask = sum(1 << i for i, arg in enumerate(args) if arg is None)
+    remaining = iter(arrays)
+    flat = [len(next(remaining)) if arg is None else arg for arg in args]
+    data = struct.pack('<QIBBB', timestamp, duration, native, len(args), mask)
+    data += struct.pack('<%dI' % len(flat), *flat)
+    for array in arrays:
+        data += struct.pack('<%dI' % len(array), *array)
+    return data
+
+
+calls = [
+    record(1_000_000, 5_200, GET_APPROX_FULL_GOLD_VALUE, [0x00012EB7]),
+    record(2_500_000, 1_900, GET_APPROX_FULL_GOLD_VALUE, [0x00012EB7]),
+    record(3_000_000, 2_100, GET_APPROX_FULL_GOLD_VALUE, [0x00000000]),
+    record(4_000_000, 48_000, GET_APPROX_FULL_GOLD_VALUES, [None], [[0x00012EB7, 0x0001397E, 0x00013982, 0x00000000]]),
+    record(6_000_000, 310_000, GET_INVENTORY_GOLD_VALUE, [0x00019DA4]),
+    record(7_000_000, 9_000, FIND_SCROLLS, [2, ANY, ANY, 1, 0x00000000, 0, 20]),
+    record(7_500_000, 11_000, FIND_SCROLLS, [ANY, 1, 3, ANY, 0x0001EA6E, 20, 20]),
+    record(8_000_000, 3_000, CAN_FUSE, [0x0010F000, 0x0010F001, 1]),
+    record(9_000_000, 95_000, FUSE_AND_CREATE, [0x0010F000, 0x0010F001]),
+    record(10_000_000, 800, GET_ZERO_COST_COPY, [0x00012FCD]),
+    record(12_000_000, 1_700, GET_APPROX_FULL_GOLD_VALUE, [0x0001397E]),
+]
+
+trace = MAGIC + struct.pack('<HH', VERSION, 0) + b''.join(calls)
+with open('sample.trace', 'wb') as f:
+    f.write(trace)
+with open('cut.trace', 'wb') as f:
+    f.write(trace[:-3])
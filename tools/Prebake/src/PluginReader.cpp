@@ -0,0 +1,96 @@
+#include "PluginReader.h"
+
+#include <zlib.h>
+
+#ifndef _WIN32
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace SCRIBE
+{
+	namespace PREBAKE
+	{
+		MappedFile::MappedFile(const std::filesystem::path& path)
+		{
+#ifdef _WIN32
+			std::ifstream in(path, std::ios::binary | std::ios::ate);
+			if (!in)
+				return;
+			buffer.resize(static_cast<std::size_t>(in.tellg()));
+			in.seekg(0);
+			if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+				return;
+			data = buffer.data();
+			size = buffer.size();
+			opened = true;
+#else
+			const int fd = ::open(path.c_str(), O_RDONLY);
+			if (fd < 0)
+				return;
+
+			struct stat info{};
+			if (::fstat(fd, &info) == 0) {
+				size = static_cast<std::size_t>(info.st_size);
+				if (size == 0) {
+					opened = true;
+				} else if (auto mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); mapping != MAP_FAILED) {
+					::madvise(mapping, size, MADV_SEQUENTIAL);
+					data = static_cast<const std::byte*>(mapping);
+					opened = true;
+				}
+			}
+			::close(fd);
+#endif
+		}
+
+		MappedFile::~MappedFile()
+		{
+#ifndef _WIN32
+			if (data)
+				::munmap(const_cast<std::byte*>(data), size);
+#endif
+		}
+
+		PluginReader::PluginReader(const std::filesystem::path& path) :
+			file(path), name(path.filename().string())
+		{
+			const auto data = file.GetData();
+			if (!file.IsOpen() || data.size() < HEADER_SIZE || std::memcmp(data.data(), "TES4", 4) != 0)
+				return;
+
+			const auto headerDataSize = ReadField<std::uint32_t>(data, 4);
+			const auto headerFlags = ReadField<std::uint32_t>(data, 8);
+			headerSize = HEADER_SIZE + headerDataSize;
+			if (headerSize > data.size())
+				return;
+
+			const Record header{ MakeSignature("TES4"), headerFlags, 0, data.subspan(HEADER_SIZE, headerDataSize) };
+			valid = header.ForEachSubrecord([this](const Subrecord& sub) {
+				if (sub.type != MakeSignature("MAST"))
+					return;
+				std::string master(reinterpret_cast<const char*>(sub.data.data()), sub.data.size());
+				if (auto end = master.find('\0'); end != std::string::npos)
+					master.resize(end);
+				masters.push_back(std::move(master));
+			});
+		}
+
+		bool PluginReader::Inflate(std::span<const std::byte> compressed)
+		{
+			if (compressed.size() < 4)
+				return false;
+
+			const auto inflatedSize = ReadField<std::uint32_t>(compressed, 0);
+			inflated.resize(inflatedSize);
+
+			auto destLength = static_cast<uLongf>(inflatedSize);
+			const auto result = ::uncompress(
+				reinterpret_cast<Bytef*>(inflated.data()), &destLength,
+				reinterpret_cast<const Bytef*>(compressed.data() + 4), static_cast<uLong>(compressed.size() - 4));
+			return result == Z_OK && destLength == inflatedSize;
+		}
+	}
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+namespace SCRIBE
+{
+	namespace PREBAKE
+	{
+		using Signature = std::array<char, 4>;
+
+		constexpr Signature MakeSignature(const char (&text)[5])
+		{
+			return { text[0], text[1], text[2], text[3] };
+		}
+
+		// Bounds-checked little endian read; zero if the field lies outside the data.
+		template <typename T>
+		T ReadField(std::span<const std::byte> data, std::size_t offset)
+		{
+			T value{};
+			if (offset + sizeof(T) <= data.size())
+				std::memcpy(&value, data.data() + offset, sizeof(T));
+			return value;
+		}
+
+		struct Subrecord
+		{
+			Signature type;
+			std::span<const std::byte> data;
+		};
+
+		struct Record
+		{
+			Signature type;
+			std::uint32_t flags;
+			std::uint32_t formID;  // as stored in the file: the high byte indexes the plugin's masters
+			std::span<const std::byte> data;  // already decompressed
+
+			static constexpr std::uint32_t DELETED = 0x20;
+			static constexpr std::uint32_t COMPRESSED = 0x40000;
+
+			// Calls func(const Subrecord&) in file order; XXXX size overrides are resolved. False if the data is malformed.
+			template <typename Func>
+			bool ForEachSubrecord(Func&& func) const
+			{
+				std::size_t offset = 0;
+				std::uint32_t sizeOverride = 0;
+				while (offset + 6 <= data.size()) {
+					Subrecord sub;
+					std::memcpy(sub.type.data(), data.data() + offset, 4);
+					std::size_t size = ReadField<std::uint16_t>(data, offset + 4);
+					offset += 6;
+					if (sizeOverride)
+						size = std::exchange(sizeOverride, 0);
+					if (offset + size > data.size())
+						return false;
+					sub.data = data.subspan(offset, size);
+					offset += size;
+
+					if (sub.type == MakeSignature("XXXX")) {
+						sizeOverride = ReadField<std::uint32_t>(sub.data, 0);
+						continue;
+					}
+					func(sub);
+				}
+				return offset == data.size();
+			}
+		};
+
+		// Read-only view of a whole file, memory mapped where the platform allows it.
+		class MappedFile
+		{
+		public:
+			explicit MappedFile(const std::filesystem::path& path);
+			~MappedFile();
+
+			MappedFile(MappedFile const&) = delete;
+			void operator=(MappedFile const&) = delete;
+
+			bool IsOpen() const { return opened; }
+			std::span<const std::byte> GetData() const { return { data, size }; }
+
+		private:
+			const std::byte* data = nullptr;
+			std::size_t size = 0;
+			bool opened = false;
+#ifdef _WIN32
+			std::vector<std::byte> buffer;
+#endif
+		};
+
+		// Streams the records of one .esm/.esp/.esl. Only top-level groups of the requested types are entered;
+		// every other group is skipped by its size without being read.
+		class PluginReader
+		{
+		public:
+			explicit PluginReader(const std::filesystem::path& path);
+
+			bool IsValid() const { return valid; }
+			const std::string& GetName() const { return name; }
+			const std::vector<std::string>& GetMasters() const { return masters; }
+
+			// Calls func(const Record&) for every record of the given types. Compressed records are inflated into a
+			// buffer that is reused, so a record's data is only valid during its callback. False if the file is malformed.
+			template <typename Func>
+			bool ForEachRecord(std::span<const Signature> types, Func&& func)
+			{
+				return ForEachRecordIn(file.GetData().subspan(headerSize), types, func);
+			}
+
+		private:
+			static constexpr std::size_t HEADER_SIZE = 24;  // records and groups alike
+
+			template <typename Func>
+			bool ForEachRecordIn(std::span<const std::byte> data, std::span<const Signature> types, Func& func)
+			{
+				std::size_t offset = 0;
+				while (offset + HEADER_SIZE <= data.size()) {
+					Signature type;
+					std::memcpy(type.data(), data.data() + offset, 4);
+					const auto size = ReadField<std::uint32_t>(data, offset + 4);
+
+					if (type == MakeSignature("GRUP")) {
+						if (size < HEADER_SIZE || offset + size > data.size())
+							return false;
+						Signature label;
+						std::memcpy(label.data(), data.data() + offset + 8, 4);
+						const auto groupType = ReadField<std::int32_t>(data, offset + 12);
+						if (groupType != 0 || std::ranges::find(types, label) != types.end()) {
+							if (!ForEachRecordIn(data.subspan(offset + HEADER_SIZE, size - HEADER_SIZE), types, func))
+								return false;
+						}
+						offset += size;
+						continue;
+					}
+
+					if (offset + HEADER_SIZE + size > data.size())
+						return false;
+					if (std::ranges::find(types, type) != types.end()) {
+						Record record{ type, ReadField<std::uint32_t>(data, offset + 8), ReadField<std::uint32_t>(data, offset + 12), data.subspan(offset + HEADER_SIZE, size) };
+						if (record.flags & Record::COMPRESSED) {
+							if (!Inflate(record.data))
+								return false;
+							record.data = inflated;
+						}
+						func(record);
+					}
+					offset += HEADER_SIZE + size;
+				}
+				return offset == data.size();
+			}
+
+			bool Inflate(std::span<const std::byte> compressed);
+
+			MappedFile file;
+			std::string name;
+			std::vector<std::string> masters;
+			std::size_t headerSize = 0;
+			bool valid = false;
+
+			std::vector<std::byte> inflated;
+		};
+	}
+}
@@ -0,0 +1,399 @@
+#include "CatalogFile.h"
+#include "DustKernel.h"
+#include "PluginReader.h"
+#include "VanillaPerkRanks.h"
+
+// Reads spell tomes, spells and magic effects straight from plugin files and writes the catalog that
+// GenerateDynamicScrolls would build in game, with the same filters, ranks, levels and dust kernel.
+//
+//   ScrollScribePrebake [--ini ScrollScribeNG.ini] [--out ScrollScribeNG.catalog] [--list] Skyrim.esm Update.esm ...
+//
+// Plugins must be given in load order. [CASTINGPERKS] and DeduplicateSpellTomes are read from the INI, if given.
+// Spells that are only equivalent are never merged here; with DeduplicateEquivalentSpells the game rebuilds instead.
+
+namespace SCRIBE
+{
+	namespace PREBAKE
+	{
+		namespace
+		{
+			// Interned plugin index in the high half, local FormID in the low half; index 0 means no plugin.
+			using Key = std::uint64_t;
+
+			constexpr std::uint32_t BOOK_TEACHES_SPELL = 0x04;
+			constexpr std::uint32_t CAST_CONSTANT_EFFECT = 0;
+			constexpr std::uint32_t CAST_CONCENTRATION = 2;
+
+			// "plugin~0x0000ABCD". Formatted by hand: the tool must build with standard libraries that lack <format>.
+			std::string FormatKey(std::string_view plugin, std::uint32_t localID)
+			{
+				std::array<char, 16> hex{};
+				std::snprintf(hex.data(), hex.size(), "~0x%08X", localID);
+				return std::string(plugin) + hex.data();
+			}
+
+			struct Effect
+			{
+				Key baseEffect = 0;
+				float magnitude = 0.0f;
+				std::uint32_t area = 0;
+				std::uint32_t duration = 0;
+			};
+
+			struct Spell
+			{
+				std::int32_t cost = 0;
+				std::uint32_t castingType = 0;
+				Key castingPerk = 0;
+				std::vector<Effect> effects;
+			};
+
+			struct MagicEffect
+			{
+				float baseCost = 0.0f;
+				std::int32_t skill = -1;
+				std::int32_t minimumSkillLevel = 0;
+			};
+
+			class LoadOrder
+			{
+			public:
+				LoadOrder() { plugins.emplace_back(); }
+
+				std::uint32_t Intern(std::string_view name)
+				{
+					auto lower = ToLower(name);
+					if (auto it = byName.find(lower); it != byName.end())
+						return it->second;
+					const auto index = static_cast<std::uint32_t>(plugins.size());
+					plugins.emplace_back(name);
+					byName.emplace(std::move(lower), index);
+					return index;
+				}
+
+				// The high byte of a FormID in a file indexes that file's masters; past them, it is the file itself.
+				Key Resolve(const PluginReader& reader, std::uint32_t self, std::uint32_t formID)
+				{
+					if (formID == 0)
+						return 0;
+					const auto& masters = reader.GetMasters();
+					const auto master = formID >> 24;
+					const auto plugin = master < masters.size() ? Intern(masters[master]) : self;
+					return MakeKey(plugin, formID & 0x00FFFFFF);
+				}
+
+				static Key MakeKey(std::uint32_t plugin, std::uint32_t localFormID) { return (static_cast<Key>(plugin) << 32) | localFormID; }
+				static std::uint32_t GetPlugin(Key key) { return static_cast<std::uint32_t>(key >> 32); }
+				static std::uint32_t GetLocalFormID(Key key) { return static_cast<std::uint32_t>(key); }
+
+				const std::vector<std::string>& GetPlugins() const { return plugins; }
+
+			private:
+				static std::string ToLower(std::string_view text)
+				{
+					std::string result(text);
+					std::ranges::transform(result, result.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+					return result;
+				}
+
+				std::vector<std::string> plugins;
+				std::unordered_map<std::string, std::uint32_t> byName;
+			};
+
+			// Spell cost of one effect, as the engine computes it when loading the spell.
+			float GetEffectCost(const MagicEffect& baseEffect, const Effect& effect)
+			{
+				const auto magnitude = std::max<float>(effect.magnitude, 1.0f);
+				const auto duration = static_cast<float>(std::max<std::uint32_t>(effect.duration, 10)) / 10.0f;
+				return baseEffect.baseCost * std::pow(magnitude * duration, 1.1f);
+			}
+
+			struct IniSettings
+			{
+				std::unordered_map<Key, std::int8_t> perkRanks;
+				bool deduplicateSpellTomes = false;
+			};
+
+			// Same spellings SimpleIni accepts for a true bool.
+			bool ParseBool(std::string_view value)
+			{
+				const auto word = value.substr(0, value.find_first_of(" \t"));
+				return word == "1"sv || word == "true"sv || word == "True"sv || word == "TRUE"sv || word == "yes"sv || word == "on"sv;
+			}
+
+			// [CASTINGPERKS] entries as "Plugin.esp~0xLocalID = rank"; [SETTINGS] for the tome deduplication flags.
+			void LoadIni(const std::filesystem::path& iniPath, LoadOrder& order, IniSettings& settings)
+			{
+				std::ifstream ini(iniPath);
+				if (!ini) {
+					std::cerr << "Could not open " << iniPath.string() << '\n';
+					return;
+				}
+
+				std::string_view section;
+				for (std::string line; std::getline(ini, line);) {
+					std::string_view text(line);
+					text = text.substr(0, text.find_first_of(";#"));
+					text.remove_prefix(std::min(text.find_first_not_of(" \t\r"), text.size()));
+					text.remove_suffix(text.size() - std::min(text.find_last_not_of(" \t\r") + 1, text.size()));
+					if (text.empty())
+						continue;
+					if (text.front() == '[') {
+						section = text == "[CASTINGPERKS]"sv ? "CASTINGPERKS"sv : text == "[SETTINGS]"sv ? "SETTINGS"sv : ""sv;
+						continue;
+					}
+
+					const auto tildePos = text.find('~');
+					const auto equalsPos = text.find('=');
+					if (section == "SETTINGS"sv && equalsPos != std::string_view::npos) {
+						auto key = text.substr(0, equalsPos);
+						key = key.substr(0, key.find_last_not_of(" \t") + 1);
+						auto value = text.substr(equalsPos + 1);
+						value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+						if (key == "DeduplicateSpellTomes"sv || key == "DeduplicateEquivalentSpells"sv)
+							settings.deduplicateSpellTomes = settings.deduplicateSpellTomes || ParseBool(value);
+						continue;
+					}
+					if (section != "CASTINGPERKS"sv || tildePos == std::string_view::npos || equalsPos == std::string_view::npos || tildePos > equalsPos)
+						continue;
+
+					auto local = text.substr(tildePos + 1, equalsPos - tildePos - 1);
+					local = local.substr(0, local.find_last_not_of(" \t") + 1);
+					if (local.starts_with("0x"))
+						local.remove_prefix(2);
+					auto value = text.substr(equalsPos + 1);
+					value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+
+					std::uint32_t localFormID = 0;
+					int rank = 0;
+					if (std::from_chars(local.data(), local.data() + local.size(), localFormID, 16).ec != std::errc()
+						|| std::from_chars(value.data(), value.data() + value.size(), rank).ec != std::errc())
+						continue;
+
+					const auto plugin = order.Intern(text.substr(0, tildePos));
+					settings.perkRanks.insert_or_assign(LoadOrder::MakeKey(plugin, localFormID & 0x00FFFFFF), static_cast<std::int8_t>(std::clamp(rank, 0, 5)));
+				}
+			}
+
+			int Run(int argc, char* argv[])
+			{
+				std::filesystem::path outPath(FILE_NAME);
+				std::optional<std::filesystem::path> iniPath;
+				bool list = false;
+				std::vector<std::filesystem::path> pluginPaths;
+
+				for (int i = 1; i < argc; i++) {
+					const std::string_view arg(argv[i]);
+					if (arg == "--out" && i + 1 < argc)
+						outPath = argv[++i];
+					else if (arg == "--ini" && i + 1 < argc)
+						iniPath = argv[++i];
+					else if (arg == "--list")
+						list = true;
+					else
+						pluginPaths.emplace_back(arg);
+				}
+
+				if (pluginPaths.empty()) {
+					std::cerr << "Usage: ScrollScribePrebake [--ini ScrollScribeNG.ini] [--out ScrollScribeNG.catalog] [--list] <plugins in load order>...\n";
+					return 1;
+				}
+
+				LoadOrder order;
+				std::unordered_map<Key, Key> books;  // tome -> taught spell
+				std::vector<Key> bookOrder;          // order in which tomes were first defined, like the game's form array
+				std::unordered_set<Key> seenBooks;
+				std::unordered_map<Key, Spell> spells;
+				std::unordered_map<Key, MagicEffect> magicEffects;
+
+				constexpr auto RECORD_TYPES = std::to_array({ MakeSignature("BOOK"), MakeSignature("SPEL"), MakeSignature("MGEF") });
+
+				for (const auto& path : pluginPaths) {
+					PluginReader reader(path);
+					if (!reader.IsValid()) {
+						std::cerr << path.string() << " is not a readable plugin\n";
+						return 1;
+					}
+
+					const auto self = order.Intern(reader.GetName());
+					const auto resolve = [&](std::uint32_t formID) { return order.Resolve(reader, self, formID); };
+
+					const bool ok = reader.ForEachRecord(RECORD_TYPES, [&](const Record& record) {
+						const auto key = resolve(record.formID);
+						const bool deleted = record.flags & Record::DELETED;
+
+						if (record.type == MakeSignature("BOOK")) {
+							if (seenBooks.insert(key).second)
+								bookOrder.push_back(key);
+							Key spell = 0;
+							record.ForEachSubrecord([&](const Subrecord& sub) {
+								if (sub.type == MakeSignature("DATA") && (ReadField<std::uint8_t>(sub.data, 0) & BOOK_TEACHES_SPELL))
+									spell = resolve(ReadField<std::uint32_t>(sub.data, 4));
+							});
+							if (deleted || spell == 0)
+								books.erase(key);
+							else
+								books.insert_or_assign(key, spell);
+
+						} else if (record.type == MakeSignature("SPEL")) {
+							if (deleted) {
+								spells.erase(key);
+								return;
+							}
+							Spell spell;
+							record.ForEachSubrecord([&](const Subrecord& sub) {
+								if (sub.type == MakeSignature("SPIT")) {
+									spell.cost = ReadField<std::int32_t>(sub.data, 0);
+									spell.castingType = ReadField<std::uint32_t>(sub.data, 16);
+									spell.castingPerk = resolve(ReadField<std::uint32_t>(sub.data, 32));
+								} else if (sub.type == MakeSignature("EFID")) {
+									spell.effects.push_back({ resolve(ReadField<std::uint32_t>(sub.data, 0)) });
+								} else if (sub.type == MakeSignature("EFIT") && !spell.effects.empty()) {
+									auto& effect = spell.effects.back();
+									effect.magnitude = ReadField<float>(sub.data, 0);
+									effect.area = ReadField<std::uint32_t>(sub.data, 4);
+									effect.duration = ReadField<std::uint32_t>(sub.data, 8);
+								}
+							});
+							spells.insert_or_assign(key, std::move(spell));
+
+						} else if (record.type == MakeSignature("MGEF")) {
+							if (deleted) {
+								magicEffects.erase(key);
+								return;
+							}
+							MagicEffect effect;
+							record.ForEachSubrecord([&](const Subrecord& sub) {
+								if (sub.type == MakeSignature("DATA")) {
+									effect.baseCost = ReadField<float>(sub.data, 4);
+									effect.skill = ReadField<std::int32_t>(sub.data, 12);
+									effect.minimumSkillLevel = ReadField<std::int32_t>(sub.data, 40);
+								}
+							});
+							magicEffects.insert_or_assign(key, effect);
+						}
+					});
+
+					if (!ok) {
+						std::cerr << path.string() << " is malformed\n";
+						return 1;
+					}
+				}
+
+				IniSettings settings;
+				auto& perkRanks = settings.perkRanks;
+				const auto skyrim = order.Intern("Skyrim.esm");
+				for (const auto& entry : VANILLA_PERK_RANKS)
+					perkRanks.insert_or_assign(LoadOrder::MakeKey(skyrim, entry.perk & 0x00FFFFFF), entry.rank);
+				if (iniPath)
+					LoadIni(*iniPath, order, settings);
+
+				// Same filters as pass 1 of GenerateDynamicScrolls; with DeduplicateSpellTomes, a spell taught by
+				// several tomes gets one scroll.
+				struct Tome
+				{
+					Key book;
+					Key spell;
+					std::int32_t school;
+				};
+				std::vector<Tome> tomes;
+				std::vector<std::int32_t> inRank, inLevel;
+				std::vector<float> inCostliest, inOverride;
+				std::vector<std::uint8_t> inConcentration;
+				std::unordered_set<Key> seenSpells;
+				std::size_t duplicateSpells = 0;
+
+				for (const auto bookKey : bookOrder) {
+					auto bookIt = books.find(bookKey);
+					if (bookIt == books.end())
+						continue;
+					auto spellIt = spells.find(bookIt->second);
+					if (spellIt == spells.end())
+						continue;
+
+					const auto& spell = spellIt->second;
+					if (spell.castingType == CAST_CONSTANT_EFFECT || spell.cost <= 5 || spell.effects.empty())
+						continue;
+
+					auto firstEffect = magicEffects.find(spell.effects.front().baseEffect);
+					if (firstEffect == magicEffects.end())
+						continue;
+
+					if (!seenSpells.insert(spellIt->first).second && settings.deduplicateSpellTomes) {
+						++duplicateSpells;
+						continue;
+					}
+
+					float costliest = -1.0f;
+					std::int32_t school = -1;
+					for (const auto& effect : spell.effects) {
+						if (auto it = magicEffects.find(effect.baseEffect); it != magicEffects.end()) {
+							if (const auto cost = GetEffectCost(it->second, effect); cost > costliest) {
+								costliest = cost;
+								school = it->second.skill;
+							}
+						}
+					}
+
+					auto perkIt = perkRanks.find(spell.castingPerk);
+					const std::int32_t rank = perkIt != perkRanks.end() ? perkIt->second : 0;
+
+					tomes.push_back({ bookKey, spellIt->first, school });
+					inRank.push_back(rank);
+					inLevel.push_back(std::min<std::int32_t>(rank * 25 - 25, firstEffect->second.minimumSkillLevel));
+					inCostliest.push_back(costliest);
+					inOverride.push_back(static_cast<float>(spell.cost));
+					inConcentration.push_back(spell.castingType == CAST_CONCENTRATION ? 1 : 0);
+				}
+
+				const auto tomeCount = tomes.size();
+				std::vector<std::int32_t> outBaseDust(tomeCount), outReducedDust(tomeCount);
+				std::vector<std::uint8_t> outTier(tomeCount), outFilter(tomeCount);
+				KERNEL::ClassifyBatch({ inRank, inLevel, inCostliest, inOverride, inConcentration }, { outBaseDust, outReducedDust, outTier, outFilter });
+
+				Catalog catalog;
+				catalog.plugins = order.GetPlugins();
+				catalog.entries.reserve(tomeCount);
+				for (std::size_t i = 0; i < tomeCount; i++) {
+					Entry entry;
+					entry.bookPlugin = LoadOrder::GetPlugin(tomes[i].book);
+					entry.bookLocalID = LoadOrder::GetLocalFormID(tomes[i].book);
+					entry.spellPlugin = LoadOrder::GetPlugin(tomes[i].spell);
+					entry.spellLocalID = LoadOrder::GetLocalFormID(tomes[i].spell);
+					entry.baseDust = outBaseDust[i];
+					entry.reducedDust = outReducedDust[i];
+					entry.school = tomes[i].school;
+					entry.level = static_cast<std::int16_t>(inLevel[i]);
+					entry.rank = static_cast<std::int8_t>(inRank[i]);
+					entry.tier = outTier[i];
+					entry.concentration = inConcentration[i] != 0;
+					catalog.entries.push_back(entry);
+
+					if (list) {
+						std::cout << FormatKey(catalog.plugins[entry.bookPlugin], entry.bookLocalID)
+								  << " SPEL " << FormatKey(catalog.plugins[entry.spellPlugin], entry.spellLocalID)
+								  << " | rank " << int(entry.rank) << " | level " << entry.level << " | tier " << int(entry.tier)
+								  << " | dust " << entry.baseDust << '/' << entry.reducedDust
+								  << (entry.concentration ? " | concentration" : "") << '\n';
+					}
+				}
+
+				std::ofstream out(outPath, std::ios::binary);
+				if (!out || !Write(catalog, out)) {
+					std::cerr << "Could not write " << outPath.string() << '\n';
+					return 1;
+				}
+
+				std::cout << "Read " << pluginPaths.size() << " plugins: " << books.size() << " spell tomes, " << spells.size() << " spells, "
+						  << magicEffects.size() << " magic effects. Wrote " << tomeCount << " scrolls (" << duplicateSpells
+						  << " tomes share a spell) to " << outPath.string() << '\n';
+				return 0;
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	return SCRIBE::PREBAKE::Run(argc, argv);
+}
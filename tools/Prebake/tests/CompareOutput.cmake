@@ -0,0 +1,20 @@
+# Runs TOOL with ARGS ('|'-separated) in the current directory and fails unless its output equals EXPECTED.
+#   cmake -DTOOL=... "-DARGS=--list|A.esm" -DEXPECTED=expected.txt -P CompareOutput.cmake
+
+string(REPLACE "|" ";" args "${ARGS}")
+execute_process(
+	COMMAND "${TOOL}" ${args}
+	OUTPUT_VARIABLE actual
+	ERROR_VARIABLE errors
+	RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+	message(FATAL_ERROR "${TOOL} exited with ${result}:\n${errors}")
+endif()
+
+file(READ "${EXPECTED}" expected)
+string(REPLACE "\r" "" actual "${actual}")
+string(REPLACE "\r" "" expected "${expected}")
+if(NOT actual STREQUAL expected)
+	message(FATAL_ERROR "Output differs from ${EXPECTED}:\n${actual}")
+endif()
@@ -0,0 +1,83 @@
+# Writes the synthetic plugins the fixture tests read. Run from this directory after changing it; the output is committed.
+#
+# Test.esm  (masters Skyrim.esm)          two magic effects, three spells, six tomes, and a WEAP group the tool skips
+# Patch.esp (masters Skyrim.esm, Test.esm) overrides a spell's cost, adds a tome of its own and deletes a Test.esm tome
+import struct
+import zlib
+
+COMPRESSED = 0x40000
+DELETED = 0x20
+MASTER = 0x1
+
+
+def sub(signature, data):
+    return signature.encode() + struct.pack('<H', len(data)) + data
+
+
+def rec(signature, form_id, data, flags=0):
+    if flags & COMPRESSED:
+        data = struct.pack('<I', len(data)) + zlib.compress(data)
+    return signature.encode() + struct.pack('<IIIIHH', len(data), flags, form_id, 0, 44, 0) + data
+
+
+def grp(label, records):
+    body = b''.join(records)
+    return b'GRUP' + struct.pack('<I', 24 + len(body)) + label.encode() + struct.pack('<iHHI', 0, 0, 0, 0) + body
+
+
+def tes4(masters, flags=0):
+    data = sub('HEDR', struct.pack('<fII', 1.7, 0, 0x800))
+    for master in masters:
+        data += sub('MAST', master.encode() + b'\0') + sub('DATA', struct.pack('<Q', 0))
+    return rec('TES4', 0, data, flags)
+
+
+def mgef(form_id, base_cost, skill, minimum_level):
+    data = struct.pack('<IfIiiHHIfIII', 0, base_cost, 0, skill, -1, 0, 0, 0, 1.0, 0, 0, minimum_level) + b'\0' * (152 - 44)
+    return rec('MGEF', form_id, sub('EDID', b'eff\0') + sub('DATA', data))
+
+
+def spel(form_id, cost, casting_type, perk, effects, flags=0):
+    data = sub('EDID', b'sp\0') + sub('SPIT', struct.pack('<IIIfIIffI', cost, 1, 0, 0.0, casting_type, 1, 0.0, 0.0, perk))
+    for effect, magnitude, area, duration in effects:
+        data += sub('EFID', struct.pack('<I', effect)) + sub('EFIT', struct.pack('<fII', magnitude, area, duration))
+    return rec('SPEL', form_id, data, flags)
+
+
+def book(form_id, spell, flags=0):
+    teaches = 0x04 if spell else 0
+    return rec('BOOK', form_id, sub('EDID', b'bk\0') + sub('DATA', struct.pack('<BBHIIf', teaches, 0, 0, spell, 10, 1.0)), flags)
+
+
+ALTERATION = 18
+DESTRUCTION = 20
+NOVICE_DESTRUCTION = 0x000F2CA7  # rank 1 in the vanilla table
+EXPERT_DESTRUCTION = 0x000C44C1  # rank 4
+FIRE_AND_FORGET = 1
+CONCENTRATION = 2
+
+plugin = tes4(['Skyrim.esm'], MASTER)
+plugin += grp('MGEF', [mgef(0x01000800, 1.0, DESTRUCTION, 0), mgef(0x01000801, 2.0, DESTRUCTION, 50), mgef(0x01000802, 1.5, ALTERATION, 25)])
+plugin += grp('WEAP', [rec('WEAP', 0x01000900, b'not-subrecords')])
+plugin += grp('SPEL', [
+    spel(0x01000810, 20, FIRE_AND_FORGET, NOVICE_DESTRUCTION, [(0x01000800, 10.0, 0, 0)]),
+    spel(0x01000811, 100, CONCENTRATION, EXPERT_DESTRUCTION, [(0x01000801, 5.0, 0, 1)], COMPRESSED),
+    spel(0x01000812, 3, FIRE_AND_FORGET, NOVICE_DESTRUCTION, [(0x01000800, 1.0, 0, 0)]),  # too cheap for a scroll
+    spel(0x01000813, 60, FIRE_AND_FORGET, 0, [(0x01000802, 20.0, 0, 30)]),
+])
+plugin += grp('BOOK', [
+    book(0x01000820, 0x01000810),
+    book(0x01000821, 0x01000810),  # second tome of the same spell
+    book(0x01000822, 0x01000811),
+    book(0x01000823, 0),  # teaches nothing
+    book(0x01000824, 0x01000812),
+    book(0x01000825, 0x01000813),  # deleted by Patch.esp
+])
+with open('Test.esm', 'wb') as file:
+    file.write(plugin)
+
+plugin = tes4(['Skyrim.esm', 'Test.esm'])
+plugin += grp('SPEL', [spel(0x01000810, 40, FIRE_AND_FORGET, NOVICE_DESTRUCTION, [(0x01000800, 10.0, 0, 0)])])
+plugin += grp('BOOK', [book(0x02000800, 0x01000811), rec('BOOK', 0x01000825, sub('EDID', b'bk\0'), DELETED)])
+with open('Patch.esp', 'wb') as file:
+    file.write(plugin)
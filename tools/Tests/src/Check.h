@@ -0,0 +1,21 @@
+#pragma once
+
+// Failed checks are printed and counted; each test's main returns the count, so CTest fails on any.
+namespace SCRIBE
+{
+	namespace TESTS
+	{
+		inline int failures = 0;
+
+		inline bool Check(bool passed, std::string_view expression, std::string_view file, int line)
+		{
+			if (!passed) {
+				std::cerr << file << '(' << line << "): CHECK(" << expression << ") failed\n";
+				++failures;
+			}
+			return passed;
+		}
+	}
+}
+
+#define CHECK(expression) ::SCRIBE::TESTS::Check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
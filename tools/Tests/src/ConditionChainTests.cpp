@@ -0,0 +1,105 @@
+#include "Check.h"
+#include "ConditionChain.h"
+
+namespace SCRIBE
+{
+	namespace TESTS
+	{
+		namespace
+		{
+			using namespace CONDITIONS;
+
+			std::uint32_t Bit(std::size_t predicate) { return 1u << predicate; }
+
+			// Every recipe shape the game can build, from a tome without aliases up to the spell cap.
+			void TestOptimizedRecipesAreEquivalent()
+			{
+				for (std::size_t spells = 0; spells <= MAX_RECIPE_SPELLS; spells++) {
+					const auto shape = MakeRecipeShape(spells);
+					const auto optimized = Optimize(shape);
+
+					CHECK(shape.predicates.size() == kFirstSpell + spells);
+					CHECK(optimized.items.size() == shape.items.size());
+					CHECK(IsEquivalent(shape, optimized));
+					CHECK(ExpectedEvaluations(optimized) <= ExpectedEvaluations(shape) + 1e-9);
+				}
+			}
+
+			void TestRecipeShape()
+			{
+				CHECK(MakeRecipeShape(MAX_RECIPE_SPELLS + 5).predicates.size() == kFirstSpell + MAX_RECIPE_SPELLS);
+
+				const auto shape = MakeRecipeShape(2);
+				const auto spells = Bit(kFirstSpell) | Bit(kFirstSpell + 1);
+				const auto always = Bit(kFilterRank) | Bit(kDustPerk);
+
+				CHECK(Evaluate(shape, always | Bit(kScribeLevel) | Bit(kFilterKnown)));
+				CHECK(Evaluate(shape, always | Bit(kFirstSpell + 1)));  // knowing any spell bypasses level and filter
+				CHECK(!Evaluate(shape, always | Bit(kScribeLevel)));    // known-spell filter still applies
+				CHECK(!Evaluate(shape, spells | Bit(kDustPerk)));       // rank filter off
+				CHECK(!Evaluate(shape, spells | Bit(kFilterRank)));     // other recipe's perk state
+			}
+
+			void TestEvaluationCount()
+			{
+				const auto shape = MakeRecipeShape(1);
+				std::size_t evaluations = 0;
+				// The first clause fails on both of its items and short-circuits the rest.
+				CHECK(!Evaluate(shape, 0, &evaluations));
+				CHECK(evaluations == 2);
+
+				evaluations = 0;
+				CHECK(Evaluate(shape, Bit(kFirstSpell) | Bit(kFilterRank) | Bit(kDustPerk), &evaluations));
+				CHECK(evaluations == 4);
+			}
+
+			void TestInequivalenceIsDetected()
+			{
+				auto shape = MakeRecipeShape(1);
+				auto broken = shape;
+				broken.items.front().isOR = false;
+				CHECK(!IsEquivalent(shape, broken));
+
+				auto fewer = shape;
+				fewer.predicates.pop_back();
+				CHECK(!IsEquivalent(shape, fewer));
+			}
+
+			// Arbitrary chains, not only recipe shapes, keep their meaning through Optimize.
+			void TestOptimizeRandomChains()
+			{
+				std::uint32_t state = 0x2545F491u;
+				const auto next = [&] {
+					state ^= state << 13;
+					state ^= state >> 17;
+					state ^= state << 5;
+					return state;
+				};
+
+				for (int round = 0; round < 500; round++) {
+					Chain chain;
+					const auto predicates = 1 + next() % 10;
+					for (std::uint32_t i = 0; i < predicates; i++)
+						chain.predicates.push_back({ 1.0f + static_cast<float>(next() % 16), static_cast<float>(next() % 101) / 100.0f });
+					const auto items = 1 + next() % 14;
+					for (std::uint32_t i = 0; i < items; i++)
+						chain.items.push_back({ next() % predicates, next() % 3 == 0 });
+					chain.items.back().isOR = false;
+
+					CHECK(IsEquivalent(chain, Optimize(chain)));
+				}
+			}
+		}
+	}
+}
+
+int main()
+{
+	using namespace SCRIBE;
+	TESTS::TestOptimizedRecipesAreEquivalent();
+	TESTS::TestRecipeShape();
+	TESTS::TestEvaluationCount();
+	TESTS::TestInequivalenceIsDetected();
+	TESTS::TestOptimizeRandomChains();
+	return TESTS::failures;
+}
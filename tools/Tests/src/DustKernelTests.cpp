@@ -0,0 +1,151 @@
+#include "Check.h"
+#include "DustKernel.h"
+
+// Golden values for the dust kernel, worked out by hand from the formulas GenerateDynamicScrolls has always used:
+// base = max((max(rank * 5, level) + int(max(min(costliest, 500), override))) / 4, 5), doubled for concentration,
+// reduced = max(base * 66 / 100, 5). Both passes must reproduce every row.
+
+namespace SCRIBE
+{
+	namespace TESTS
+	{
+		namespace
+		{
+			struct Golden
+			{
+				std::int32_t rank;
+				std::int32_t level;
+				float costliest;
+				float costOverride;
+				std::uint8_t concentration;
+				std::int32_t baseDust;
+				std::int32_t reducedDust;
+				std::uint8_t tier;
+				std::uint8_t filterIndex;
+			};
+
+			constexpr Golden GOLDEN[] = {
+				{ 1, 0, 10.0f, 0.0f, 0, 5, 5, 0, 0 },              // both floors
+				{ 1, 0, 20.0f, 0.0f, 0, 6, 5, 0, 0 },              // reduced floor only
+				{ 1, 24, 40.0f, 0.0f, 0, 16, 10, 0, 0 },           // last Novice level
+				{ 2, 25, 40.0f, 0.0f, 0, 16, 10, 1, 1 },           // first Apprentice level
+				{ 2, 49, 60.0f, 0.0f, 0, 27, 17, 1, 1 },
+				{ 3, 50, 60.0f, 0.0f, 0, 27, 17, 2, 2 },
+				{ 3, 74, 100.0f, 0.0f, 0, 43, 28, 2, 2 },
+				{ 4, 75, 100.0f, 0.0f, 0, 43, 28, 3, 3 },
+				{ 4, 99, 200.0f, 0.0f, 0, 74, 48, 3, 3 },
+				{ 5, 100, 200.0f, 0.0f, 0, 75, 49, 4, 4 },         // Master
+				{ 5, 130, 200.0f, 0.0f, 0, 82, 54, 4, 4 },         // past Master stays Master
+				{ 4, 10, 20.0f, 0.0f, 0, 10, 6, 0, 0 },            // rank outweighs level
+				{ 0, 30, 40.0f, 0.0f, 0, 17, 11, 1, 5 },           // rank 0 goes to the strange filter
+				{ 0, 0, 10.9f, 0.0f, 0, 5, 5, 0, 5 },              // cost is truncated
+				{ 5, 100, 900.0f, 0.0f, 0, 150, 99, 4, 4 },        // costliest effect capped at 500
+				{ 5, 100, 900.0f, 700.0f, 0, 200, 132, 4, 4 },     // override above 500 is not capped
+				{ 1, 0, 10.0f, 60.0f, 0, 16, 10, 0, 0 },           // override above a cheap effect
+				{ 4, 50, 100.0f, 0.0f, 1, 74, 48, 2, 2 },          // concentration doubles base dust
+				{ 1, 0, 5.0f, 0.0f, 1, 10, 6, 0, 0 },              // doubled after the floor
+				{ 0, 100, 900.0f, 700.0f, 1, 400, 264, 4, 5 },
+			};
+
+			using Pass = void (*)(const KERNEL::DustInputs&, const KERNEL::DustOutputs&);
+
+			struct Outputs
+			{
+				explicit Outputs(std::size_t count) :
+					baseDust(count), reducedDust(count), tier(count), filterIndex(count) {}
+
+				KERNEL::DustOutputs Spans() { return { baseDust, reducedDust, tier, filterIndex }; }
+
+				std::vector<std::int32_t> baseDust, reducedDust;
+				std::vector<std::uint8_t> tier, filterIndex;
+			};
+
+			void TestGolden(Pass pass, std::string_view name)
+			{
+				std::vector<std::int32_t> rank, level;
+				std::vector<float> costliest, costOverride;
+				std::vector<std::uint8_t> concentration;
+				for (const auto& row : GOLDEN) {
+					rank.push_back(row.rank);
+					level.push_back(row.level);
+					costliest.push_back(row.costliest);
+					costOverride.push_back(row.costOverride);
+					concentration.push_back(row.concentration);
+				}
+
+				Outputs out(std::size(GOLDEN));
+				pass({ rank, level, costliest, costOverride, concentration }, out.Spans());
+				for (std::size_t i = 0; i < std::size(GOLDEN); i++) {
+					const auto& row = GOLDEN[i];
+					const bool matches = CHECK(out.baseDust[i] == row.baseDust && out.reducedDust[i] == row.reducedDust && out.tier[i] == row.tier && out.filterIndex[i] == row.filterIndex);
+					if (!matches) {
+						std::cerr << "  " << name << " row " << i << ": " << out.baseDust[i] << '/' << out.reducedDust[i] << " tier " << int(out.tier[i])
+								  << " filter " << int(out.filterIndex[i]) << ", expected " << row.baseDust << '/' << row.reducedDust
+								  << " tier " << int(row.tier) << " filter " << int(row.filterIndex) << '\n';
+					}
+				}
+			}
+
+			// Every rank and level from 0 to past Master, with costs around the cap, through both passes at once,
+			// so the batch loop also runs over lengths that are not a multiple of any vector width.
+			void TestBatchMatchesScalar()
+			{
+				constexpr float COSTS[] = { 0.0f, 3.5f, 19.0f, 120.25f, 499.9f, 500.0f, 500.1f, 2000.0f };
+				constexpr float OVERRIDES[] = { 0.0f, 37.0f, 650.0f };
+
+				std::vector<std::int32_t> rank, level;
+				std::vector<float> costliest, costOverride;
+				std::vector<std::uint8_t> concentration;
+				for (std::int32_t r = 0; r <= 5; r++)
+					for (std::int32_t l = 0; l <= 110; l++)
+						for (const auto cost : COSTS)
+							for (const auto over : OVERRIDES)
+								for (std::uint8_t conc = 0; conc <= 1; conc++) {
+									rank.push_back(r);
+									level.push_back(l);
+									costliest.push_back(cost);
+									costOverride.push_back(over);
+									concentration.push_back(conc);
+								}
+				rank.push_back(3);
+				level.push_back(63);
+				costliest.push_back(77.0f);
+				costOverride.push_back(0.0f);
+				concentration.push_back(0);
+
+				const KERNEL::DustInputs in{ rank, level, costliest, costOverride, concentration };
+				Outputs batch(rank.size()), scalar(rank.size());
+				KERNEL::ClassifyBatch(in, batch.Spans());
+				KERNEL::ClassifyScalar(in, scalar.Spans());
+
+				std::size_t mismatches = 0;
+				for (std::size_t i = 0; i < rank.size(); i++) {
+					if (batch.baseDust[i] != scalar.baseDust[i] || batch.reducedDust[i] != scalar.reducedDust[i] || batch.tier[i] != scalar.tier[i] || batch.filterIndex[i] != scalar.filterIndex[i])
+						++mismatches;
+				}
+				CHECK(mismatches == 0);
+			}
+
+			void TestTierIndex()
+			{
+				CHECK(KERNEL::GetTierIndex(-1) == 0);
+				CHECK(KERNEL::GetTierIndex(24) == 0);
+				CHECK(KERNEL::GetTierIndex(25) == 1);
+				CHECK(KERNEL::GetTierIndex(50) == 2);
+				CHECK(KERNEL::GetTierIndex(75) == 3);
+				CHECK(KERNEL::GetTierIndex(99) == 3);
+				CHECK(KERNEL::GetTierIndex(100) == 4);
+			}
+		}
+	}
+}
+
+int main()
+{
+	using namespace SCRIBE;
+	TESTS::TestGolden(KERNEL::ClassifyBatch, "ClassifyBatch");
+	TESTS::TestGolden(KERNEL::ClassifyScalar, "ClassifyScalar");
+	TESTS::TestBatchMatchesScalar();
+	TESTS::TestTierIndex();
+	return TESTS::failures;
+}
@@ -0,0 +1,172 @@
+#include "Check.h"
+#include "PluginReader.h"
+#include "PluginWriter.h"
+
+namespace SCRIBE
+{
+	namespace TESTS
+	{
+		namespace
+		{
+			using ESP::MakeSignature;
+			using ESP::PluginWriter;
+
+			constexpr std::uint32_t SCROLL_ID = 0x01000800;
+			constexpr std::uint32_t RECIPE_ID = 0x01000801;
+			constexpr std::size_t LONG_SIZE = 0x10000 + 4;  // too long for a 16 bit subrecord size
+
+			// Expected bytes, spelled out field by field.
+			class Bytes
+			{
+			public:
+				Bytes& Text(std::string_view text)
+				{
+					for (const auto c : text)
+						data.push_back(static_cast<std::byte>(c));
+					return *this;
+				}
+
+				template <typename T>
+				Bytes& Field(T value)
+				{
+					const auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+					data.insert(data.end(), bytes.begin(), bytes.end());
+					return *this;
+				}
+
+				Bytes& U16(std::uint16_t value) { return Field(value); }
+				Bytes& U32(std::uint32_t value) { return Field(value); }
+
+				// Record header: type, data size, flags, FormID, timestamp and version control, form version, unknown.
+				Bytes& Record(std::string_view type, std::uint32_t size, std::uint32_t flags, std::uint32_t formID)
+				{
+					return Text(type).U32(size).U32(flags).U32(formID).U32(0).U16(44).U16(0);
+				}
+
+				// Top-level group header: size including itself, label, group type 0, timestamp, version control.
+				Bytes& Group(std::string_view label, std::uint32_t size) { return Text("GRUP").U32(size).Text(label).U32(0).U16(0).U16(0).U32(0); }
+
+				std::vector<std::byte> data;
+			};
+
+			std::vector<std::byte> MakeLongText()
+			{
+				std::vector<std::byte> text(LONG_SIZE);
+				for (std::size_t i = 0; i < text.size(); i++)
+					text[i] = static_cast<std::byte>('a' + i % 26);
+				text.back() = std::byte{ 0 };
+				return text;
+			}
+
+			PluginWriter WritePlugin()
+			{
+				const std::vector<std::string> masters{ "Skyrim.esm" };
+
+				PluginWriter writer;
+				writer.WriteHeader(PluginWriter::FLAG_MASTER | PluginWriter::FLAG_LIGHT, masters, 0x802, "Scribe");
+
+				writer.BeginGroup(MakeSignature("SCRL"));
+				writer.BeginRecord(MakeSignature("SCRL"), SCROLL_ID);
+				writer.AddString(MakeSignature("FULL"), "Fire");
+				writer.AddFields(MakeSignature("DATA"), std::uint32_t(25), 0.5f);
+				writer.AddSubrecord(MakeSignature("DESC"), MakeLongText());
+				writer.EndRecord();
+				writer.EndGroup();
+
+				writer.BeginGroup(MakeSignature("COBJ"));
+				writer.BeginRecord(MakeSignature("COBJ"), RECIPE_ID);
+				writer.AddFields(MakeSignature("CNAM"), SCROLL_ID);
+				writer.AddFields(MakeSignature("NAM1"), std::uint16_t(1));
+				writer.EndRecord();
+				writer.EndGroup();
+
+				writer.Finish();
+				return writer;
+			}
+
+			void TestBytes()
+			{
+				const auto writer = WritePlugin();
+				CHECK(writer.GetObjectCount() == 4);  // two groups and two records; the header does not count
+
+				Bytes expected;
+				expected.Record("TES4", 62, 0x201, 0);
+				expected.Text("HEDR").U16(12).Field(1.7f).U32(4).U32(0x802);
+				expected.Text("CNAM").U16(7).Text("Scribe").Field(std::uint8_t(0));
+				expected.Text("MAST").U16(11).Text("Skyrim.esm").Field(std::uint8_t(0));
+				expected.Text("DATA").U16(8).Field(std::uint64_t(0));
+
+				expected.Group("SCRL", 24 + 24 + 65581);
+				expected.Record("SCRL", 65581, 0, SCROLL_ID);
+				expected.Text("FULL").U16(5).Text("Fire").Field(std::uint8_t(0));
+				expected.Text("DATA").U16(8).U32(25).Field(0.5f);
+				expected.Text("XXXX").U16(4).U32(LONG_SIZE);
+				expected.Text("DESC").U16(0);
+				const auto longText = MakeLongText();
+				expected.data.insert(expected.data.end(), longText.begin(), longText.end());
+
+				expected.Group("COBJ", 24 + 24 + 18);
+				expected.Record("COBJ", 18, 0, RECIPE_ID);
+				expected.Text("CNAM").U16(4).U32(SCROLL_ID);
+				expected.Text("NAM1").U16(2).U16(1);
+
+				const auto& actual = writer.GetData();
+				CHECK(actual.size() == expected.data.size());
+				if (!CHECK(actual == expected.data)) {
+					const auto [differs, _] = std::ranges::mismatch(actual, expected.data);
+					std::cerr << "  first difference at byte " << (differs - actual.begin()) << '\n';
+				}
+			}
+
+			void TestReadBack()
+			{
+				const auto path = std::filesystem::temp_directory_path() / "ScrollScribePluginWriterTest.esp";
+				CHECK(WritePlugin().Save(path));
+
+				PREBAKE::PluginReader reader(path);
+				CHECK(reader.IsValid());
+				CHECK(reader.GetMasters() == std::vector<std::string>{ "Skyrim.esm" });
+
+				std::size_t scrolls = 0, recipes = 0;
+				constexpr auto TYPES = std::to_array({ PREBAKE::MakeSignature("SCRL"), PREBAKE::MakeSignature("COBJ") });
+				const bool ok = reader.ForEachRecord(TYPES, [&](const PREBAKE::Record& record) {
+					if (record.type == PREBAKE::MakeSignature("SCRL")) {
+						++scrolls;
+						CHECK(record.formID == SCROLL_ID);
+						std::vector<PREBAKE::Signature> order;
+						CHECK(record.ForEachSubrecord([&](const PREBAKE::Subrecord& sub) {
+							order.push_back(sub.type);
+							if (sub.type == PREBAKE::MakeSignature("FULL"))
+								CHECK(std::string_view(reinterpret_cast<const char*>(sub.data.data()), sub.data.size()) == "Fire\0"sv);
+							else if (sub.type == PREBAKE::MakeSignature("DATA"))
+								CHECK(PREBAKE::ReadField<std::uint32_t>(sub.data, 0) == 25 && PREBAKE::ReadField<float>(sub.data, 4) == 0.5f);
+							else if (sub.type == PREBAKE::MakeSignature("DESC"))
+								CHECK(std::ranges::equal(sub.data, MakeLongText()));
+						}));
+						CHECK(order.size() == 3);  // the XXXX prefix is folded into DESC
+					} else {
+						++recipes;
+						CHECK(record.formID == RECIPE_ID);
+						CHECK(record.ForEachSubrecord([&](const PREBAKE::Subrecord& sub) {
+							if (sub.type == PREBAKE::MakeSignature("CNAM"))
+								CHECK(PREBAKE::ReadField<std::uint32_t>(sub.data, 0) == SCROLL_ID);
+						}));
+					}
+				});
+				CHECK(ok);
+				CHECK(scrolls == 1 && recipes == 1);
+
+				std::error_code error;
+				std::filesystem::remove(path, error);
+			}
+		}
+	}
+}
+
+int main()
+{
+	using namespace SCRIBE;
+	TESTS::TestBytes();
+	TESTS::TestReadBack();
+	return TESTS::failures;
+}
@@ -0,0 +1,350 @@
+#include "Check.h"
+
+// PatchVanillaScrolls used to match and patch each scroll in one serial loop; it now matches every scroll in parallel
+// into a table and patches serially in form-array order. Both versions run here over a stand-in form array, and the
+// resulting forms, catalog, relocations and log must be identical. The fuzzy fallback runs after either and is left out.
+namespace SCRIBE
+{
+	namespace TESTS
+	{
+		namespace
+		{
+			constexpr std::uint32_t KYWD_SCROLL_CUSTOM = 0x1;
+			constexpr std::uint32_t KYWD_VENDOR_ITEM_SCROLL = 0x2;
+			constexpr std::uint32_t KYWD_FIRST_TIER = 0x10;
+			constexpr std::uint32_t MGEF_DISINTEGRATE = 0xD15;
+
+			struct Effect
+			{
+				std::uint32_t baseEffect;
+				float magnitude;
+				std::uint32_t area;
+				std::uint32_t duration;
+			};
+
+			struct Spell
+			{
+				std::uint32_t formID;
+				std::string name;
+				std::vector<Effect> effects;
+			};
+
+			struct Scroll
+			{
+				std::uint32_t formID;
+				std::string name;
+				std::string model;
+				std::vector<std::uint32_t> keywords;
+				std::vector<Effect> effects;
+				float weight = 0.5f;
+				std::int32_t value = 0;
+
+				bool HasKeyword(std::uint32_t keyword) const { return std::ranges::find(keywords, keyword) != keywords.end(); }
+			};
+
+			struct Constructible
+			{
+				Scroll* createdItem;
+			};
+
+			struct Entry
+			{
+				Spell* spell;
+				Scroll* scroll;
+				std::vector<Constructible*> constructibles;
+				std::uint32_t tier;
+			};
+
+			using HashToSpell = std::unordered_map<std::size_t, Spell*>;
+
+			std::string ExtractSpellName(const std::string& input)
+			{
+				static const std::regex pattern(R"(\bScroll\s+of\s+([^\(\)-]+)\b)");
+				std::smatch match;
+				if (std::regex_search(input, match, pattern))
+					return match[1];
+				return "<No Spell Name Found>";
+			}
+
+			std::size_t GetEffectListHash(const std::vector<Effect>& effects)
+			{
+				std::size_t hash = 0;
+				for (const auto& effect : effects)
+					hash ^= std::hash<std::uint32_t>{}(effect.baseEffect) << 1;
+				return hash;
+			}
+
+			std::size_t GetNameHash(const std::string& name) { return std::hash<std::string>{}(name); }
+
+			// A load order's worth of forms: spells, the catalog's generated scrolls (also in the form array),
+			// vanilla and mod scrolls in every state MatchVanillaScroll distinguishes.
+			struct World
+			{
+				std::vector<std::unique_ptr<Spell>> spells;
+				std::vector<std::unique_ptr<Scroll>> forms;
+				std::vector<std::unique_ptr<Constructible>> constructibles;
+				std::vector<Scroll*> scrollArray;
+				std::vector<Entry> catalog;
+				std::unordered_map<const Spell*, std::size_t> bySpell;
+				HashToSpell hashCache;
+
+				std::vector<std::pair<std::uint32_t, std::uint32_t>> relocations;
+				std::vector<std::string> log;
+				std::size_t formTotal = 0;
+				std::size_t integratedCount = 0;
+			};
+
+			std::unique_ptr<World> MakeWorld(std::uint32_t seed)
+			{
+				static constexpr std::array<std::string_view, 10> NAMES{ "Fireball", "Ice Storm", "Chain Lightning", "Fury", "Calm",
+					"Paralyze", "Flame Thrall", "Fast Healing", "Mass Paralysis", "Blizzard" };
+
+				std::mt19937 random(seed);
+				auto world = std::make_unique<World>();
+				std::uint32_t nextFormID = 0x0010F000;
+
+				const auto addScroll = [&](std::string name, std::vector<std::uint32_t> keywords, std::vector<Effect> effects) {
+					auto scroll = std::make_unique<Scroll>();
+					scroll->formID = nextFormID++;
+					scroll->name = std::move(name);
+					scroll->model = "Clutter/Common/Scroll05.nif";
+					scroll->keywords = std::move(keywords);
+					scroll->effects = std::move(effects);
+					scroll->value = static_cast<std::int32_t>(10 + random() % 400);
+					world->scrollArray.push_back(scroll.get());
+					world->forms.push_back(std::move(scroll));
+					return world->forms.back().get();
+				};
+
+				for (std::size_t i = 0; i < 120; i++) {
+					auto spell = std::make_unique<Spell>();
+					spell->formID = nextFormID++;
+					spell->name = std::string(NAMES[i % NAMES.size()]) + (i < NAMES.size() ? "" : " " + std::to_string(i));
+					for (std::size_t e = 0; e < 1 + random() % 3; e++)
+						spell->effects.push_back({ static_cast<std::uint32_t>(0x1000 + i * 4 + e), static_cast<float>(10 + random() % 90), static_cast<std::uint32_t>(random() % 20), static_cast<std::uint32_t>(random() % 60) });
+
+					// Spells without a catalog entry still sit in the hash cache; their matches are misses.
+					if (i % 10 != 9) {
+						auto generated = addScroll("Scroll of " + spell->name, { KYWD_SCROLL_CUSTOM, KYWD_VENDOR_ITEM_SCROLL }, spell->effects);
+						generated->weight = 0.1f + static_cast<float>(random() % 10) / 10.0f;
+						Entry entry{ spell.get(), generated, {}, static_cast<std::uint32_t>(random() % 5) };
+						for (std::size_t c = 0; c < 1 + random() % 2; c++) {
+							world->constructibles.push_back(std::make_unique<Constructible>(Constructible{ generated }));
+							entry.constructibles.push_back(world->constructibles.back().get());
+						}
+						world->bySpell.emplace(spell.get(), world->catalog.size());
+						world->catalog.push_back(std::move(entry));
+					}
+
+					world->hashCache[GetEffectListHash(spell->effects)] = spell.get();
+					world->hashCache[GetNameHash(spell->name)] = spell.get();
+					world->spells.push_back(std::move(spell));
+				}
+
+				for (std::size_t i = 0; i < 1500; i++) {
+					const auto& spell = *world->spells[random() % world->spells.size()];
+					auto effects = spell.effects;
+					for (auto& effect : effects) {
+						// Scrolls often carry weaker effects than their spell, which FixScrollSpellMismatch repairs.
+						if (random() % 3 == 0)
+							effect.magnitude /= 2.0f;
+						if (random() % 4 == 0)
+							effect.duration /= 2;
+					}
+
+					switch (random() % 10) {
+					case 0:  // renamed, matched by its effects
+						addScroll("Arcane Parchment", { KYWD_VENDOR_ITEM_SCROLL }, std::move(effects));
+						break;
+					case 1:  // matches nothing
+						addScroll("Scroll of Nothing In Particular", { KYWD_VENDOR_ITEM_SCROLL }, { { 0xBEEF, 1.0f, 0, 0 } });
+						break;
+					case 2:
+						addScroll("Scroll of " + spell.name, { KYWD_VENDOR_ITEM_SCROLL }, {});
+						break;
+					case 3:  // no vendor keyword, no name, or a Dragonborn spider
+						{
+							auto scroll = addScroll("Scroll of " + spell.name, { KYWD_VENDOR_ITEM_SCROLL }, std::move(effects));
+							if (random() % 3 == 0)
+								scroll->keywords.clear();
+							else if (random() % 2 == 0)
+								scroll->name.clear();
+							else
+								scroll->model = "Actors\\DLC02\\Spider\\Spider.nif";
+							break;
+						}
+					default:  // by name; several scrolls of one spell claim its entry in turn
+						addScroll("Scroll of " + spell.name + (random() % 2 == 0 ? " (Master)" : ""), { KYWD_VENDOR_ITEM_SCROLL }, std::move(effects));
+						break;
+					}
+				}
+				return world;
+			}
+
+			struct ScrollMatch
+			{
+				enum class Status : std::uint8_t
+				{
+					kIgnored,
+					kNullEffect,
+					kCandidate
+				};
+
+				Status status = Status::kIgnored;
+				Spell* spell = nullptr;
+			};
+
+			// MatchVanillaScroll: reads the scroll and the hash cache only.
+			ScrollMatch MatchVanillaScroll(const Scroll* scroll, const HashToSpell& hashCache)
+			{
+				if (!scroll)
+					return {};
+				if (scroll->effects.empty())
+					return { ScrollMatch::Status::kNullEffect };
+				if (scroll->HasKeyword(KYWD_SCROLL_CUSTOM) || !scroll->HasKeyword(KYWD_VENDOR_ITEM_SCROLL) || scroll->name.empty() || scroll->model.contains("Actors\\DLC02"sv))
+					return {};
+				if (auto it = hashCache.find(GetNameHash(ExtractSpellName(scroll->name))); it != hashCache.end())
+					return { ScrollMatch::Status::kCandidate, it->second };
+				if (auto it = hashCache.find(GetEffectListHash(scroll->effects)); it != hashCache.end())
+					return { ScrollMatch::Status::kCandidate, it->second };
+				return { ScrollMatch::Status::kCandidate };
+			}
+
+			void FixScrollSpellMismatch(Scroll& scroll, const Spell& spell)
+			{
+				for (auto& scrollEffect : scroll.effects) {
+					for (const auto& spellEffect : spell.effects) {
+						if (spellEffect.baseEffect != scrollEffect.baseEffect)
+							continue;
+						scrollEffect.area = std::max<std::uint32_t>(scrollEffect.area, spellEffect.area);
+						scrollEffect.duration = std::max<std::uint32_t>(scrollEffect.duration, spellEffect.duration);
+						scrollEffect.magnitude = std::max<float>(scrollEffect.magnitude, spellEffect.magnitude);
+					}
+				}
+			}
+
+			// The per-scroll half of PatchVanillaScrolls: everything that mutates forms, the catalog and the caches.
+			void ApplyMatch(World& world, Scroll* scroll, const ScrollMatch& match, std::vector<Scroll*>& missed)
+			{
+				if (match.status == ScrollMatch::Status::kNullEffect) {
+					world.log.push_back("Skipped null-effect scroll " + scroll->name);
+					return;
+				}
+				if (match.status != ScrollMatch::Status::kCandidate)
+					return;
+
+				std::string logString = "Patched " + scroll->name;
+				scroll->keywords.push_back(KYWD_SCROLL_CUSTOM);
+
+				auto it = match.spell ? world.bySpell.find(match.spell) : world.bySpell.end();
+				if (it != world.bySpell.end()) {
+					auto& entry = world.catalog[it->second];
+					logString += " = SPEL " + entry.spell->name;
+
+					auto oldScroll = entry.scroll;
+					entry.scroll = scroll;
+					for (auto cobj : entry.constructibles)
+						cobj->createdItem = scroll;
+					scroll->weight = oldScroll->weight;
+					scroll->value = oldScroll->value;
+					world.relocations.emplace_back(oldScroll->formID, scroll->formID);
+
+					scroll->effects.push_back({ MGEF_DISINTEGRATE, 0.0f, 0, 0 });
+					scroll->keywords.push_back(KYWD_FIRST_TIER + entry.tier);
+					FixScrollSpellMismatch(*scroll, *entry.spell);
+					++world.integratedCount;
+				} else {
+					missed.push_back(scroll);
+				}
+
+				world.log.push_back(std::move(logString));
+				++world.formTotal;
+			}
+
+			std::vector<Scroll*> PatchSerial(World& world)
+			{
+				std::vector<Scroll*> missed;
+				for (auto scroll : world.scrollArray)
+					ApplyMatch(world, scroll, MatchVanillaScroll(scroll, world.hashCache), missed);
+				return missed;
+			}
+
+			// The plugin hands the match pass to std::transform(std::execution::par); plain threads over interleaved
+			// indices make sure neighbouring scrolls really are matched concurrently here.
+			std::vector<Scroll*> PatchTwoPass(World& world, std::size_t threadCount)
+			{
+				std::vector<ScrollMatch> matches(world.scrollArray.size());
+				{
+					std::vector<std::jthread> threads;
+					for (std::size_t t = 0; t < threadCount; t++) {
+						threads.emplace_back([&, t] {
+							for (std::size_t i = t; i < matches.size(); i += threadCount)
+								matches[i] = MatchVanillaScroll(world.scrollArray[i], world.hashCache);
+						});
+					}
+				}
+
+				std::vector<Scroll*> missed;
+				for (std::size_t i = 0; i < matches.size(); i++)
+					ApplyMatch(world, world.scrollArray[i], matches[i], missed);
+				return missed;
+			}
+
+			// Every field either version could touch, in a fixed order.
+			std::string Dump(const World& world, const std::vector<Scroll*>& missed)
+			{
+				std::ostringstream out;
+				for (const auto scroll : world.scrollArray) {
+					out << std::hex << scroll->formID << ' ' << scroll->name << ' ' << scroll->weight << ' ' << std::dec << scroll->value << " k";
+					for (const auto keyword : scroll->keywords)
+						out << ' ' << keyword;
+					out << " e";
+					for (const auto& effect : scroll->effects)
+						out << ' ' << effect.baseEffect << ':' << effect.magnitude << ':' << effect.area << ':' << effect.duration;
+					out << '\n';
+				}
+				for (const auto& entry : world.catalog) {
+					out << entry.spell->formID << " -> " << entry.scroll->formID << " c";
+					for (const auto cobj : entry.constructibles)
+						out << ' ' << cobj->createdItem->formID;
+					out << '\n';
+				}
+				for (const auto& [from, to] : world.relocations)
+					out << "REL " << from << ' ' << to << '\n';
+				for (const auto& line : world.log)
+					out << line << '\n';
+				for (const auto scroll : missed)
+					out << "MISS " << scroll->formID << '\n';
+				out << world.formTotal << ' ' << world.integratedCount << '\n';
+				return out.str();
+			}
+
+			void TestTwoPassMatchesSerial()
+			{
+				for (const std::uint32_t seed : { 28u, 280u, 2800u }) {
+					for (const std::size_t threads : { std::size_t(1), std::size_t(4), std::size_t(16) }) {
+						auto serial = MakeWorld(seed);
+						auto twoPass = MakeWorld(seed);
+						const auto serialMissed = PatchSerial(*serial);
+						const auto twoPassMissed = PatchTwoPass(*twoPass, threads);
+						CHECK(Dump(*serial, serialMissed) == Dump(*twoPass, twoPassMissed));
+
+						// The dataset reaches every branch, including entries claimed by more than one scroll.
+						CHECK(serial->integratedCount > serial->catalog.size());
+						CHECK(!serialMissed.empty());
+						CHECK(std::ranges::any_of(serial->log, [](const std::string& line) { return line.starts_with("Skipped null-effect"); }));
+						CHECK(serial->formTotal < serial->scrollArray.size() - serial->catalog.size());
+					}
+				}
+			}
+		}
+	}
+}
+
+int main()
+{
+	using namespace SCRIBE::TESTS;
+
+	TestTwoPassMatchesSerial();
+	return failures;
+}